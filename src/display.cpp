@@ -37,6 +37,10 @@
 #include "procedure.hpp"
 #include "scenario.hpp"
 #include "gtp_stats.hpp"
+#include "thread.hpp"
+#include "worker.hpp"
+#include "obj_pool.hpp"
+#include "rate_profile.hpp"
 #include "display.hpp"
 
 #define COUT std::cout
@@ -94,6 +98,7 @@ Display *Display::getInstance()
 Display::~Display()
 {
     screen_exit();
+    m_pDisp = NULL;
 }
 
 PRIVATE VOID screen_exit()
@@ -121,9 +126,12 @@ VOID Display::init()
     m_pStats    = Stats::getInstance();
     getTimeStr(m_timeStr);
     m_startTime  = getMilliSeconds() / 1000;
+    m_lastDispTime = getMicroSeconds();
+    m_lastCreated  = 0;
     m_localPort  = Config::getInstance()->getLocalGtpcPort();
     m_remPort    = Config::getInstance()->getRemoteGtpcPort();
     m_ifTypeStr = Config::getInstance()->getIfTypeStr();
+    m_pipelineMode = Config::getInstance()->getPipelineMode();
     STRCPY(m_remIpAddrStr, (Config::getInstance()->getRemIpAddrStr()).c_str());
     STRCPY(
         m_localIpAddrStr, (Config::getInstance()->getLocalIpAddrStr()).c_str());
@@ -151,17 +159,38 @@ RETVAL Display::run(VOID *arg)
     LOG_EXITFN(ROK);
 }
 
-VOID Display::printJob(Job *job)
+/**
+ * @brief
+ *    Prints the counters of a job of the scenario, summed up for all the
+ *    workers, the workers share the scenario and count in their own tables
+ *
+ * @param procIdx
+ *    index of the procedure in the scenario
+ * @param role
+ *    job of the procedure
+ */
+VOID Display::printJob(U32 procIdx, Job *Procedure::*role)
 {
+    Job     *job = m_procSeq->at(procIdx)->*role;
+    JobStats total;
+
+    job->getTotalStats(&total);
+    Counter numSnd        = total.numSnd;
+    Counter numRcv        = total.numRcv;
+    Counter numSndRetrans = total.numSndRetrans;
+    Counter numRcvRetrans = total.numRcvRetrans;
+    Counter numTimeOut    = total.numTimeOut;
+    Counter numUnexp      = total.numUnexp;
+
     switch (job->type())
     {
     case JOB_TYPE_SEND:
     {
         fprintf(stdout, "%s  ", job->m_msgName);
         fprintf(stdout, "\t--->");
-        fprintf(stdout, " \t%9d", job->m_numSnd);
-        fprintf(stdout, "%9d", job->m_numSndRetrans);
-        fprintf(stdout, " %9d", job->m_numTimeOut);
+        fprintf(stdout, " \t%9d", numSnd);
+        fprintf(stdout, "%9d", numSndRetrans);
+        fprintf(stdout, " %9d", numTimeOut);
         fprintf(stdout, ENDLINE);
         break;
     }
@@ -169,9 +198,9 @@ VOID Display::printJob(Job *job)
     {
         fprintf(stdout, "%s  ", job->m_msgName);
         fprintf(stdout, " \t<---");
-        fprintf(stdout, "\t%9d", job->m_numRcv);
-        fprintf(stdout, "%9d", job->m_numRcvRetrans);
-        fprintf(stdout, "                  %9d", job->m_numUnexp);
+        fprintf(stdout, "\t%9d", numRcv);
+        fprintf(stdout, "%9d", numRcvRetrans);
+        fprintf(stdout, "                  %9d", numUnexp);
         fprintf(stdout, ENDLINE);
         break;
     }
@@ -188,6 +217,68 @@ VOID Display::printJob(Job *job)
     }
 }
 
+/**
+ * @brief
+ *    Prints the response time percentiles of a request job, summed up for
+ *    all the workers. Nothing is printed for a job without responses.
+ *
+ * @param job
+ * @param pEol
+ *    end of line, the curses screen needs a carriage return
+ */
+VOID Display::printLatency(Job *job, const S8 *pEol)
+{
+    JobStats total;
+
+    job->getTotalStats(&total);
+    if (0 == total.latency.count())
+    {
+        return;
+    }
+
+    fprintf(stdout,
+        "  Latency-us  p50: %-7lu p90: %-7lu p99: %-7lu p99.9: %-7lu "
+        "max: %lu%s",
+        total.latency.percentile(50), total.latency.percentile(90),
+        total.latency.percentile(99), total.latency.percentile(99.9),
+        total.latency.max(), pEol);
+}
+
+/**
+ * @brief
+ *    Prints the response time percentiles of all the procedures once the
+ *    workers have stopped, after the curses screen is closed. The display
+ *    task is deleted along with the other tasks by then, the procedures are
+ *    taken from the scenario.
+ */
+VOID Display::dumpLatency()
+{
+    ProcSequence *procSeq = &(Scenario::getInstance()->m_procSeq);
+
+    screen_exit();
+
+    fprintf(stdout, "\n");
+    for (U32 i = 0; i < procSeq->size(); i++)
+    {
+        Job *job = procSeq->at(i)->m_initial;
+        if ((NULL == job) || (JOB_TYPE_SEND != job->type()))
+        {
+            continue;
+        }
+
+        JobStats total;
+        job->getTotalStats(&total);
+        if (total.latency.count() > 0)
+        {
+            fprintf(stdout, "%s: %u responses\n", job->m_msgName,
+                total.latency.count());
+            printLatency(job, "\n");
+        }
+    }
+
+    fflush(stdout);
+}
+
 VOID Display::disp()
 {
     static BOOL firTime = TRUE;
@@ -229,6 +320,104 @@ VOID Display::disp()
     fprintf(stdout, "Session-Aborted:   %u\r\n", ssnFail);
     fprintf(stdout, "Dead-Calls:        %u\r\n", deadCalls);
 
+    /* session rate offered by the traffic tasks, the current target rate
+     * of a rate profile, and the rate achieved since the previous refresh
+     */
+    Counter offeredRate = getStats(GSIM_STAT_OFFERED_RATE);
+    Time_t  now         = getMicroSeconds();
+    if (((offeredRate > 0) || (NULL != RateProfile::get())) &&
+        (now > m_lastDispTime))
+    {
+        fprintf(stdout, "Session-Rate:      %u/s offered  %.2f/s achieved\r\n",
+            offeredRate,
+            (double)(ssnCreated - m_lastCreated) * 1000000 /
+                (now - m_lastDispTime));
+    }
+
+    m_lastDispTime = now;
+    m_lastCreated  = ssnCreated;
+
+    /* requests waiting for a response against the concurrency window */
+    Counter window = getStats(GSIM_STAT_CONC_WINDOW);
+    if (window > 0)
+    {
+        fprintf(stdout, "Outstanding-Reqs:  %u  Window: %u  Timeouts: %u\r\n",
+            getStats(GSIM_STAT_NUM_PENDING_REQS), window,
+            getStats(GSIM_STAT_NUM_REQ_TIMEOUTS));
+    }
+
+    Counter rcvBatches = getStats(GSIM_STAT_NUM_RECV_BATCHES);
+    if (rcvBatches > 0)
+    {
+        Counter rcvMsgs = getStats(GSIM_STAT_NUM_RECV_MSGS);
+        fprintf(stdout, "Recv-Batching:     %.2f msgs/call\r\n",
+            (double)rcvMsgs / rcvBatches);
+    }
+
+    Counter invalidMsgs = getStats(GSIM_STAT_NUM_INVALID_MSGS);
+    if (invalidMsgs > 0)
+    {
+        fprintf(stdout, "Malformed-Msgs:    %u\r\n", invalidMsgs);
+    }
+
+    Counter sndBatches = getStats(GSIM_STAT_NUM_SEND_BATCHES);
+    if (sndBatches > 0)
+    {
+        Counter sndMsgs = getStats(GSIM_STAT_NUM_SEND_MSGS);
+        fprintf(stdout, "Send-Batching:     %.2f msgs/call  Blocked: %u  "
+            "Dropped: %u\r\n", (double)sndMsgs / sndBatches,
+            getStats(GSIM_STAT_NUM_SEND_BLOCKED),
+            getStats(GSIM_STAT_NUM_SEND_DROPS));
+    }
+
+    Counter imsiLookups = getStats(GSIM_STAT_NUM_IMSI_LOOKUPS);
+    if (imsiLookups > 0)
+    {
+        fprintf(stdout, "Session-Table:     %.2f probes/lookup  Max-Probes: "
+            "%u  Stale-TEIDs: %u\r\n",
+            (double)getStats(GSIM_STAT_NUM_IMSI_PROBES) / imsiLookups,
+            m_pStats->getMaxStats(GSIM_STAT_MAX_IMSI_PROBES),
+            getStats(GSIM_STAT_NUM_STALE_TEIDS));
+    }
+
+    TimerStats timerStats;
+    getTotalTimerStats(&timerStats);
+    if (timerStats.lag.count() > 0)
+    {
+        fprintf(stdout, "Timer-Lag:         p99 %lu us  Max: %lu us  Jitter: "
+            "p99 %lu us  Max: %lu us\r\n", timerStats.lag.percentile(99),
+            timerStats.lag.max(), timerStats.jitter.percentile(99),
+            timerStats.jitter.max());
+    }
+
+    std::vector<ObjPoolStats> poolStats;
+    ObjPoolBase::getStats(&poolStats);
+    for (U32 i = 0; i < poolStats.size(); i++)
+    {
+        /* in-use/peak/capacity of the pools, three pools per line */
+        fprintf(stdout, "%s%-9s %u/%u/%u", (i % 3) ? "  " : "Pools:             ",
+            poolStats[i].name, poolStats[i].inUse, poolStats[i].highWater,
+            poolStats[i].capacity);
+        if ((2 == (i % 3)) || (i + 1 == poolStats.size()))
+        {
+            fprintf(stdout, "\r\n");
+        }
+    }
+
+    if ((Worker::numWorkers() > 1) || m_pipelineMode)
+    {
+        U32 occupancy = 0;
+        for (U32 w = 0; w < Worker::numWorkers(); w++)
+        {
+            occupancy += Worker::getWorker(w)->inboxOccupancy();
+        }
+
+        fprintf(stdout, "Workers:           %u%s  Forwarded: %u  "
+            "Ring-Occupancy: %u  Ring-Drops: %u\r\n", Worker::numWorkers(),
+            m_pipelineMode ? " + Rx" : "", getStats(GSIM_STAT_NUM_FWD_MSGS),
+            occupancy, getStats(GSIM_STAT_NUM_HANDOFF_DROPS));
+    }
+
     PRINT_SEPERATOR();
     fprintf(stdout,
         "                                 "
@@ -242,20 +431,24 @@ VOID Display::disp()
         {
         case PROC_TYPE_WAIT:
         {
-            printJob(proc->m_wait);
+            printJob(i, &Procedure::m_wait);
             break;
         }
         case PROC_TYPE_REQ_RSP:
         {
-            printJob(proc->m_initial);
-            printJob(proc->m_trigMsg);
+            printJob(i, &Procedure::m_initial);
+            printJob(i, &Procedure::m_trigMsg);
+            if (JOB_TYPE_SEND == proc->m_initial->type())
+            {
+                printLatency(proc->m_initial, ENDLINE);
+            }
             break;
         }
         case PROC_TYPE_REQ_TRIG_REP:
         {
-            printJob(proc->m_initial);
-            printJob(proc->m_trigMsg);
-            printJob(proc->m_trigReply);
+            printJob(i, &Procedure::m_initial);
+            printJob(i, &Procedure::m_trigMsg);
+            printJob(i, &Procedure::m_trigReply);
             break;
         }
         default:
@@ -280,7 +473,7 @@ VOID Display::disp()
 
 Counter Display::getStats(GtpStat_t type)
 {
-    return m_pStats->getStats(type);
+    return m_pStats->getTotalStats(type);
 }
 
 VOID Display::displayStats()
@@ -28,6 +28,7 @@ class Display: virtual public Task
       VOID createMsgDirLst();
 
       static void displayStats();
+      static VOID dumpLatency();
    private:
       static class Display  *m_pDisp;
 
@@ -37,6 +38,8 @@ class Display: virtual public Task
       Time_t            m_lastRunTime;
       Time_t            m_dispIntvl;
       Time_t            m_startTime;
+      Time_t            m_lastDispTime;   /* micro-seconds */
+      Counter           m_lastCreated;
       U16               m_remPort;
       S8                m_remIpAddrStr[IPV6_ADDR_MAX_LEN];
       U16               m_localPort;
@@ -44,8 +47,10 @@ class Display: virtual public Task
       Stats             *m_pStats;
       S8                m_timeStr[GSIM_TIME_STR_MAX_LEN];
       ProcSequence      *m_procSeq;
-      VOID              printJob(Job*);
+      VOID              printJob(U32 procIdx, Job *Procedure::*role);
+      static VOID       printLatency(Job *job, const S8 *pEol);
       std::string       m_ifTypeStr;
+      BOOL              m_pipelineMode;
 };
 
 #endif
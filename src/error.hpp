@@ -44,6 +44,8 @@ typedef enum {
     ERR_SYS_SOCK_READ,
     ERR_SYS_SOCK_SEND,
     ERR_SYS_SOCK_CNTRL,
+    ERR_SYS_EPOLL_CREATE,
+    ERR_SYS_TIMER_CREATE,
     ERR_PDN_CREATION,
     ERR_CTUN_CREATION,
     ERR_GTP_MSG_BUF_OVERFLOW,
@@ -52,6 +54,10 @@ typedef enum {
     ERR_MAX_RETRY_EXCEEDED,
     ERR_IE_NOT_FOUND,
     ERR_INVALID_IE_LENGTH,
+    ERR_INVALID_GTP_MSG,
+    ERR_STATS_FILE_OPEN,
+    ERR_PCAP_FILE_OPEN,
+    ERR_FAILURE_LOG_OPEN,
     ERR_MAX
 } ErrCodeEn;
 
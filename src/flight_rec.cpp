@@ -0,0 +1,205 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdarg.h>
+#include <sys/time.h>
+#include <time.h>
+#include <string>
+#include <mutex>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_types.hpp"
+#include "gtp_macro.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "flight_rec.hpp"
+
+#define FLIGHT_REC_BUF_SIZE      65536
+#define FLIGHT_REC_LINE_LEN      256
+#define FLIGHT_REC_HEX_PER_LINE  16
+#define FLIGHT_REC_MAX_HEX_LEN   512   // bytes of the message dumped
+
+static std::mutex s_failLogLock;
+static FILE *     s_pFailLog = NULL;
+
+BOOL FlightRecorder::s_isOpen = FALSE;
+
+static const S8 *s_msgEventNames[MSG_EVENT_MAX] = {
+    "sent", "received", "resent", "timeout"};
+
+PRIVATE VOID appendf(std::string *pOut, const S8 *pFmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+PRIVATE VOID appendf(std::string *pOut, const S8 *pFmt, ...)
+{
+    S8      line[FLIGHT_REC_LINE_LEN];
+    va_list args;
+
+    va_start(args, pFmt);
+    vsnprintf(line, sizeof(line), pFmt, args);
+    va_end(args);
+
+    pOut->append(line);
+}
+
+/* IMSI digits of a BCD encoded IMSI, the filler digit ends the IMSI */
+PRIVATE VOID appendImsi(std::string *pOut, const GtpImsiKey *pImsi)
+{
+    for (U32 i = 0; i < pImsi->len && i < GTP_IMSI_MAX_BUF_LEN; i++)
+    {
+        U8 lo = pImsi->val[i] & 0x0f;
+        U8 hi = pImsi->val[i] >> 4;
+        if (lo > 9)
+        {
+            break;
+        }
+
+        pOut->push_back('0' + lo);
+        if (hi > 9)
+        {
+            break;
+        }
+
+        pOut->push_back('0' + hi);
+    }
+}
+
+/**
+ * @brief
+ *    Creates the failure log, the flight recorders of the sessions record
+ *    the message events only when the log is open
+ *
+ * @param fileName
+ *
+ * @return
+ *    ERR_FAILURE_LOG_OPEN if the file cannot be created
+ */
+RETVAL FlightRecorder::open(const std::string &fileName)
+{
+    LOG_ENTERFN();
+
+    std::lock_guard<std::mutex> guard(s_failLogLock);
+
+    s_pFailLog = fopen(fileName.c_str(), "w");
+    if (NULL == s_pFailLog)
+    {
+        LOG_ERROR("Opening failure log [%s]", fileName.c_str());
+        LOG_EXITFN(ERR_FAILURE_LOG_OPEN);
+    }
+
+    setvbuf(s_pFailLog, NULL, _IOFBF, FLIGHT_REC_BUF_SIZE);
+    s_isOpen = TRUE;
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Closes the failure log, called after the workers have stopped
+ */
+VOID FlightRecorder::close()
+{
+    std::lock_guard<std::mutex> guard(s_failLogLock);
+
+    s_isOpen = FALSE;
+    if (NULL != s_pFailLog)
+    {
+        fclose(s_pFailLog);
+        s_pFailLog = NULL;
+    }
+}
+
+/**
+ * @brief
+ *    Writes the recorded events of a failed session to the failure log,
+ *    oldest first, followed by a hex dump of the message of the failure
+ *
+ * @param pReason
+ * @param sessionId
+ * @param pImsi
+ * @param pMsg
+ *    request timed out or message received, NULL if there is none
+ * @param len
+ */
+VOID FlightRecorder::dump(const S8 *pReason, U32 sessionId,
+    const GtpImsiKey *pImsi, const U8 *pMsg, U32 len)
+{
+    std::string    out;
+    struct timeval tv;
+    struct tm      tm;
+
+    gettimeofday(&tv, NULL);
+    localtime_r(&tv.tv_sec, &tm);
+    appendf(&out, "%02d:%02d:%02d.%06ld Session [%u] IMSI [", tm.tm_hour,
+        tm.tm_min, tm.tm_sec, (long)tv.tv_usec, sessionId);
+    appendImsi(&out, pImsi);
+    appendf(&out, "] %s\n", pReason);
+
+    U32 numEvents = (m_numEvents < FLIGHT_REC_NUM_EVENTS)
+                        ? m_numEvents
+                        : FLIGHT_REC_NUM_EVENTS;
+    appendf(&out, "   last %u of %u message events\n", numEvents,
+        m_numEvents);
+    for (U32 i = m_numEvents - numEvents; i < m_numEvents; i++)
+    {
+        const MsgEvent *pEvt = &m_events[i & (FLIGHT_REC_NUM_EVENTS - 1)];
+        const S8 *      pName = gtpGetMsgName((GtpMsgType_t)pEvt->msgType);
+        appendf(&out,
+            "   %10u ms  %-8s  %-24s  TEID [0x%08x] SeqN [0x%06x] "
+            "Length [%u]\n",
+            pEvt->time, s_msgEventNames[pEvt->event],
+            (NULL != pName) ? pName : "Unknown Message", pEvt->teid,
+            pEvt->seqN, pEvt->len);
+    }
+
+    if (NULL != pMsg)
+    {
+        U32 dumpLen = (len < FLIGHT_REC_MAX_HEX_LEN) ? len
+                                                     : FLIGHT_REC_MAX_HEX_LEN;
+        appendf(&out, "   message, %u bytes\n", len);
+        for (U32 i = 0; i < dumpLen; i++)
+        {
+            if (0 == i % FLIGHT_REC_HEX_PER_LINE)
+            {
+                appendf(&out, "   %04x ", i);
+            }
+
+            appendf(&out, " %02x", pMsg[i]);
+            if ((FLIGHT_REC_HEX_PER_LINE - 1 == i % FLIGHT_REC_HEX_PER_LINE) ||
+                (i + 1 == dumpLen))
+            {
+                out.push_back('\n');
+            }
+        }
+    }
+
+    out.push_back('\n');
+
+    /* failures are rare, each dump is flushed so that the log can be
+     * followed while the simulator runs
+     */
+    std::lock_guard<std::mutex> guard(s_failLogLock);
+    if (NULL != s_pFailLog)
+    {
+        fwrite(out.data(), 1, out.size(), s_pFailLog);
+        fflush(s_pFailLog);
+    }
+}
@@ -0,0 +1,107 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _FLIGHT_REC_HPP_
+#define _FLIGHT_REC_HPP_
+
+#include <string>
+
+#define FLIGHT_REC_NUM_EVENTS    8   // power of two
+
+typedef enum
+{
+   MSG_EVENT_SENT,
+   MSG_EVENT_RCVD,
+   MSG_EVENT_RESENT,        /* request or response retransmitted */
+   MSG_EVENT_TIMEOUT,       /* no response to the request within T3 */
+   MSG_EVENT_MAX
+} MsgEventEn;
+
+/* message sent or received by a session, the header fields are read from
+ * the encoded message
+ */
+typedef struct
+{
+   U32               time;       /* milli-seconds, scheduler time */
+   GtpTeid_t         teid;
+   GtpSeqNumber_t    seqN;
+   U16               len;
+   U8                msgType;
+   U8                event;
+} MsgEvent;
+
+/* Flight recorder of a UE session, the last few message events of the
+ * session in a ring embedded in the session, so the events are kept in
+ * the session pool and recording an event is a few stores. The events are
+ * written to the failure log only when the session fails, a request times
+ * out, an unexpected or undecodable message is received, along with the
+ * message the failure is about.
+ *
+ * The messages are not kept referenced by the ring, a packet buffer held
+ * by every session would pin the buffer pool at millions of sessions.
+ */
+class FlightRecorder
+{
+   public:
+      FlightRecorder() {m_numEvents = 0;}
+
+      static RETVAL     open(const std::string &fileName);
+      static VOID       close();
+      static BOOL       isOpen() {return s_isOpen;}
+
+      inline VOID       record(MsgEventEn event, Time_t time, const U8 *pMsg,
+                              U32 len);
+      VOID              dump(const S8 *pReason, U32 sessionId,
+                              const GtpImsiKey *pImsi, const U8 *pMsg,
+                              U32 len);
+
+   private:
+      static BOOL       s_isOpen;
+
+      U32               m_numEvents;  /* events recorded since creation */
+      MsgEvent          m_events[FLIGHT_REC_NUM_EVENTS];
+};
+
+inline VOID FlightRecorder::record(MsgEventEn event, Time_t time,
+      const U8 *pMsg, U32 len)
+{
+   MsgEvent *pEvt = &m_events[m_numEvents++ & (FLIGHT_REC_NUM_EVENTS - 1)];
+
+   pEvt->time    = (U32)time;
+   pEvt->event   = event;
+   pEvt->len     = (U16)len;
+   pEvt->msgType = 0;
+   pEvt->teid    = 0;
+   pEvt->seqN    = 0;
+   if (len < GTP_MSG_HDR_LEN_WITHOUT_TEID)
+   {
+      return;
+   }
+
+   pEvt->msgType = pMsg[1];
+   const U8 *pSeqN = pMsg + 4;
+   if (GTP_CHK_T_BIT_PRESENT(pMsg) && (len >= GTP_MSG_HDR_LEN))
+   {
+      pEvt->teid = ((U32)pMsg[4] << 24) | ((U32)pMsg[5] << 16) |
+                   ((U32)pMsg[6] << 8) | pMsg[7];
+      pSeqN += GTP_TEID_LEN;
+   }
+
+   pEvt->seqN = ((U32)pSeqN[0] << 16) | ((U32)pSeqN[1] << 8) | pSeqN[2];
+}
+
+#endif /* _FLIGHT_REC_HPP_ */
@@ -30,6 +30,8 @@ class GtpImsi : public GtpIe
 private:
     U8 m_val[GTP_IMSI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpImsi(GtpInstance_t inst)
     {
@@ -55,21 +57,7 @@ public:
         return ROK;
     }
 
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_IMSI_MAX_BUF_LEN);
-    }
-
-    VOID setImsi(GtpImsiKey *);
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
+    VOID setImsi(const GtpImsiKey *);
 
     const U8 *imsi()
     {
@@ -84,6 +72,8 @@ class GtpMsisdn : public GtpIe
 private:
     U8 m_val[GTP_MSISDN_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMsisdn(GtpInstance_t inst)
     {
@@ -108,21 +98,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_MSISDN_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpUli : public GtpIe
@@ -138,6 +113,8 @@ class GtpUli : public GtpIe
 private:
     U8 m_val[GTP_ULI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpUli(GtpInstance_t inst)
     {
@@ -162,21 +139,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_ULI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpBearerContext : public GtpIe
@@ -185,6 +147,8 @@ class GtpBearerContext : public GtpIe
 private:
     U8 m_val[GTP_BEARER_CNTXT_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpBearerContext(GtpInstance_t inst)
     {
@@ -210,21 +174,6 @@ public:
         return ROK;
     }
     RETVAL buildIe(const GtpIeLst *pIeLst);
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_BEARER_CNTXT_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return TRUE;
-    }
     GtpEbi_t getEbi();
     VOID     setGtpuTeid(GtpTeid_t, GtpInstance_t);
 };
@@ -238,6 +187,8 @@ class GtpFteid : public GtpIe
 private:
     U8 m_val[GTP_FTEID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpFteid(GtpInstance_t inst)
     {
@@ -263,22 +214,8 @@ public:
         return ROK;
     };
 
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_FTEID_MAX_BUF_LEN);
-    }
-
     VOID setTeid(GtpTeid_t teid);
     VOID setIpAddr(const IpAddr *pIp);
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
     GtpTeid_t getTeid();
 };
 
@@ -289,6 +226,8 @@ class GtpEbi : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpEbi(GtpInstance_t inst)
     {
@@ -312,21 +251,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_EBI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMei : public GtpIe
@@ -337,6 +261,8 @@ class GtpMei : public GtpIe
 private:
     U8 m_val[GTP_MEI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMei(GtpInstance_t inst)
     {
@@ -361,21 +287,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_MEI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpRatType : public GtpIe
@@ -384,6 +295,8 @@ class GtpRatType : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpRatType(GtpInstance_t inst)
     {
@@ -407,21 +320,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_RAT_TYPE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpServingNw : public GtpIe
@@ -432,6 +330,8 @@ class GtpServingNw : public GtpIe
 private:
     U8 m_val[GTP_SERVING_NW_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpServingNw(GtpInstance_t inst)
     {
@@ -456,21 +356,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_SERVING_NW_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpApn : public GtpIe
@@ -480,6 +365,8 @@ class GtpApn : public GtpIe
 private:
     U8 m_val[GTP_APN_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpApn(GtpInstance_t inst)
     {
@@ -504,21 +391,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_APN_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpAmbr : public GtpIe
@@ -527,6 +399,8 @@ class GtpAmbr : public GtpIe
 private:
     U8 m_val[GTP_AMBR_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpAmbr(GtpInstance_t inst)
     {
@@ -551,21 +425,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_AMBR_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpIndication : public GtpIe
@@ -591,6 +450,8 @@ class GtpIndication : public GtpIe
 private:
     U8 m_val[GTP_INDICATION_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpIndication(GtpInstance_t inst)
     {
@@ -615,21 +476,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_INDICATION_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpSelectionMode : public GtpIe
@@ -643,6 +489,8 @@ class GtpSelectionMode : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpSelectionMode(GtpInstance_t inst)
     {
@@ -666,21 +514,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_SEL_MODE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPdnType : public GtpIe
@@ -689,6 +522,8 @@ class GtpPdnType : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpPdnType(GtpInstance_t inst)
     {
@@ -712,21 +547,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_PDN_TYPE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPaa : public GtpIe
@@ -735,6 +555,8 @@ class GtpPaa : public GtpIe
 private:
     U8 m_val[GTP_PAA_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpPaa(GtpInstance_t inst)
     {
@@ -758,21 +580,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_PAA_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpBearerQos : public GtpIe
@@ -781,6 +588,8 @@ class GtpBearerQos : public GtpIe
 private:
     U8 m_val[GTP_BEARER_QOS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpBearerQos(GtpInstance_t inst)
     {
@@ -804,21 +613,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_BEARER_QOS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpFlowQos : public GtpIe
@@ -827,6 +621,8 @@ class GtpFlowQos : public GtpIe
 private:
     U8 m_val[GTP_FLOW_QOS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpFlowQos(GtpInstance_t inst)
     {
@@ -850,21 +646,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_FLOW_QOS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPco : public GtpIe
@@ -873,6 +654,8 @@ class GtpPco : public GtpIe
 private:
     U8 m_val[GTP_PCO_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpPco(GtpInstance_t inst)
     {
@@ -896,21 +679,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_PCO_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpCause : public GtpIe
@@ -923,6 +691,8 @@ class GtpCause : public GtpIe
 private:
     U8 m_val[GTP_CAUSE_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpCause(GtpInstance_t inst)
     {
@@ -946,21 +716,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_CAUSE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpRecovery : public GtpIe
@@ -969,6 +724,8 @@ class GtpRecovery : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpRecovery(GtpInstance_t inst)
     {
@@ -992,21 +749,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_RECOVERY_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMbmsSessionDuration : public GtpIe
@@ -1015,6 +757,8 @@ class GtpMbmsSessionDuration : public GtpIe
 private:
     U8 m_val[GTP_MBMS_SESSION_DURATION_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMbmsSessionDuration(GtpInstance_t inst)
     {
@@ -1042,22 +786,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MBMS_SESSION_DURATION_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpStnSr : public GtpIe
@@ -1067,6 +795,8 @@ class GtpStnSr : public GtpIe
 private:
     U8 m_val[GTP_STN_SR_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpStnSr(GtpInstance_t inst)
     {
@@ -1090,21 +820,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_STN_SR_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpIpAddress : public GtpIe
@@ -1113,6 +828,8 @@ class GtpIpAddress : public GtpIe
 private:
     U8 m_val[GTP_IP_ADDRESS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpIpAddress(GtpInstance_t inst)
     {
@@ -1139,21 +856,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_IP_ADDRESS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpEpsBearerTft : public GtpIe
@@ -1162,6 +864,8 @@ class GtpEpsBearerTft : public GtpIe
 private:
     U8 m_val[GTP_EPS_BEARER_TFT_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpEpsBearerTft(GtpInstance_t inst)
     {
@@ -1185,21 +889,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_EPS_BEARER_TFT_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpTad : public GtpIe
@@ -1208,6 +897,8 @@ class GtpTad : public GtpIe
 private:
     U8 m_val[GTP_TAD_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpTad(GtpInstance_t inst)
     {
@@ -1231,21 +922,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_TAD_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpTmsi : public GtpIe
@@ -1254,6 +930,8 @@ class GtpTmsi : public GtpIe
 private:
     U8 m_val[GTP_TMSI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpTmsi(GtpInstance_t inst)
     {
@@ -1280,22 +958,7 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_TMSI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
-};
+};
 
 class GtpGlobalCnId : public GtpIe
 {
@@ -1303,6 +966,8 @@ class GtpGlobalCnId : public GtpIe
 private:
     U8 m_val[GTP_GLOBAL_CN_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpGlobalCnId(GtpInstance_t inst)
     {
@@ -1326,21 +991,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_GLOBAL_CN_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpS103Pdf : public GtpIe
@@ -1349,6 +999,8 @@ class GtpS103Pdf : public GtpIe
 private:
     U8 m_val[GTP_S103_PDN_DATA_FWD_INFO_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpS103Pdf(GtpInstance_t inst)
     {
@@ -1373,22 +1025,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_S103_PDN_DATA_FWD_INFO_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpS1uDf : public GtpIe
@@ -1397,6 +1033,8 @@ class GtpS1uDf : public GtpIe
 private:
     U8 m_val[GTP_S1U_DATA_FWD_INFO_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpS1uDf(GtpInstance_t inst)
     {
@@ -1420,21 +1058,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_S1U_DATA_FWD_INFO_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpDelayValue : public GtpIe
@@ -1443,6 +1066,8 @@ class GtpDelayValue : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpDelayValue(GtpInstance_t inst)
     {
@@ -1466,21 +1091,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_DELAY_VALUE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpChargingId : public GtpIe
@@ -1489,6 +1099,8 @@ class GtpChargingId : public GtpIe
 private:
     U8 m_val[GTP_CHARGING_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpChargingId(GtpInstance_t inst)
     {
@@ -1512,21 +1124,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_CHARGING_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpChargingCharcs : public GtpIe
@@ -1535,6 +1132,8 @@ class GtpChargingCharcs : public GtpIe
 private:
     U8 m_val[GTP_CHARGING_CHARCS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpChargingCharcs(GtpInstance_t inst)
     {
@@ -1558,21 +1157,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_CHARGING_CHARCS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpTraceInfo : public GtpIe
@@ -1581,6 +1165,8 @@ class GtpTraceInfo : public GtpIe
 private:
     U8 m_val[GTP_TRACE_INFO_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpTraceInfo(GtpInstance_t inst)
     {
@@ -1607,21 +1193,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_TRACE_INFO_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpBearerFlags : public GtpIe
@@ -1630,6 +1201,8 @@ class GtpBearerFlags : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpBearerFlags(GtpInstance_t inst)
     {
@@ -1653,21 +1226,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_BEARER_FLAGS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPti : public GtpIe
@@ -1676,6 +1234,8 @@ class GtpPti : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpPti(GtpInstance_t inst)
     {
@@ -1699,21 +1259,6 @@ public:
     {
         return ROK;
     }
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_PTI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpDrxParam : public GtpIe
@@ -1722,6 +1267,8 @@ class GtpDrxParam : public GtpIe
 private:
     U8 m_val[GTP_DRX_PARAM_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpDrxParam(GtpInstance_t inst)
     {
@@ -1748,21 +1295,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_DRX_PARAM_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpUeNetworkCap : public GtpIe
@@ -1771,6 +1303,8 @@ class GtpUeNetworkCap : public GtpIe
 private:
     U8 m_val[GTP_UE_NETWORK_CAP_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpUeNetworkCap(GtpInstance_t inst)
     {
@@ -1797,21 +1331,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_UE_NETWORK_CAP_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMmCntxtGsmKeyAndTriplets : public GtpIe
@@ -1820,6 +1339,8 @@ class GtpMmCntxtGsmKeyAndTriplets : public GtpIe
 private:
     U8 m_val[GTP_MM_CNTXT_GSM_KEY_AND_TRIPLETS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMmCntxtGsmKeyAndTriplets(GtpInstance_t inst)
     {
@@ -1847,22 +1368,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MM_CNTXT_GSM_KEY_AND_TRIPLETS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMmCntxtUmtsKeyUsedCipherAndQuint : public GtpIe
@@ -1871,6 +1376,8 @@ class GtpMmCntxtUmtsKeyUsedCipherAndQuint : public GtpIe
 private:
     U8 m_val[GTP_MM_CNTXT_UMTS_KEY_USED_CIPHER_AND_QUINTS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMmCntxtUmtsKeyUsedCipherAndQuint(GtpInstance_t inst)
     {
@@ -1898,22 +1405,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val,
-            GTP_MM_CNTXT_UMTS_KEY_USED_CIPHER_AND_QUINTS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMmCntxtGsmKeyUsedCipherAndQuint : public GtpIe
@@ -1922,6 +1413,8 @@ class GtpMmCntxtGsmKeyUsedCipherAndQuint : public GtpIe
 private:
     U8 m_val[GTP_MM_CNTXT_GSM_KEY_USED_CIPHER_N_QUINT_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMmCntxtGsmKeyUsedCipherAndQuint(GtpInstance_t inst)
     {
@@ -1949,22 +1442,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MM_CNTXT_GSM_KEY_USED_CIPHER_N_QUINT_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMmCntxtUmtsKeyAndQuint : public GtpIe
@@ -1973,6 +1450,8 @@ class GtpMmCntxtUmtsKeyAndQuint : public GtpIe
 private:
     U8 m_val[GTP_MM_CNTXT_UMTS_KEY_AND_QUINTS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMmCntxtUmtsKeyAndQuint(GtpInstance_t inst)
     {
@@ -2000,22 +1479,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MM_CNTXT_UMTS_KEY_AND_QUINTS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMmCntxtEpcSecCntxtQuadrAndQuint : public GtpIe
@@ -2024,6 +1487,8 @@ class GtpMmCntxtEpcSecCntxtQuadrAndQuint : public GtpIe
 private:
     U8 m_val[GTP_MM_CNTXT_EPS_SEC_CNTXT_QUADR_AND_QUITNS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMmCntxtEpcSecCntxtQuadrAndQuint(GtpInstance_t inst)
     {
@@ -2051,22 +1516,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val,
-            GTP_MM_CNTXT_EPS_SEC_CNTXT_QUADR_AND_QUITNS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMmCntxtUmtsKeyQuadrAndQuint : public GtpIe
@@ -2075,6 +1524,8 @@ class GtpMmCntxtUmtsKeyQuadrAndQuint : public GtpIe
 private:
     U8 m_val[GTP_MM_CNTXT_UMTS_KEY_QUADR_AND_QUINTS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMmCntxtUmtsKeyQuadrAndQuint(GtpInstance_t inst)
     {
@@ -2102,22 +1553,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MM_CNTXT_UMTS_KEY_QUADR_AND_QUINTS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPdnConnection : public GtpIe
@@ -2126,6 +1561,8 @@ class GtpPdnConnection : public GtpIe
 private:
     U8 m_val[GTP_PDN_CONNECTION_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpPdnConnection(GtpInstance_t inst)
     {
@@ -2152,21 +1589,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_PDN_CONNECTION_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPduNumbers : public GtpIe
@@ -2175,6 +1597,8 @@ class GtpPduNumbers : public GtpIe
 private:
     U8 m_val[GTP_PDU_NUMBERS_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpPduNumbers(GtpInstance_t inst)
     {
@@ -2201,21 +1625,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_PDU_NUMBERS_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPtmsi : public GtpIe
@@ -2224,6 +1633,8 @@ class GtpPtmsi : public GtpIe
 private:
     U8 m_val[GTP_PTMSI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpPtmsi(GtpInstance_t inst)
     {
@@ -2250,21 +1661,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_PTMSI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPtmsiSignature : public GtpIe
@@ -2273,6 +1669,8 @@ class GtpPtmsiSignature : public GtpIe
 private:
     U8 m_val[GTP_PTMSI_SIGNAURE_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpPtmsiSignature(GtpInstance_t inst)
     {
@@ -2299,21 +1697,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_PTMSI_SIGNAURE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpHopCounter : public GtpIe
@@ -2322,6 +1705,8 @@ class GtpHopCounter : public GtpIe
 private:
     U8 m_val;
 
+    friend class GtpIe;
+
 public:
     GtpHopCounter(GtpInstance_t inst)
     {
@@ -2345,21 +1730,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(&m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, &m_val, GTP_HOP_COUNTER_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpUeTimeZone : public GtpIe
@@ -2368,6 +1738,8 @@ class GtpUeTimeZone : public GtpIe
 private:
     U8 m_val[GTP_UE_TIME_ZONE_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpUeTimeZone(GtpInstance_t inst)
     {
@@ -2394,21 +1766,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_UE_TIME_ZONE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpTraceReference : public GtpIe
@@ -2417,6 +1774,8 @@ class GtpTraceReference : public GtpIe
 private:
     U8 m_val[GTP_TRACE_REFERENCE_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpTraceReference(GtpInstance_t inst)
     {
@@ -2443,21 +1802,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_TRACE_REFERENCE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpCompleteReqMsg : public GtpIe
@@ -2466,6 +1810,8 @@ class GtpCompleteReqMsg : public GtpIe
 private:
     U8 m_val[GTP_COMPLETE_REQ_MSG_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpCompleteReqMsg(GtpInstance_t inst)
     {
@@ -2492,21 +1838,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_COMPLETE_REQ_MSG_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpGuti : public GtpIe
@@ -2515,6 +1846,8 @@ class GtpGuti : public GtpIe
 private:
     U8 m_val[GTP_GUTI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpGuti(GtpInstance_t inst)
     {
@@ -2541,21 +1874,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_GUTI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpFContainer : public GtpIe
@@ -2564,6 +1882,8 @@ class GtpFContainer : public GtpIe
 private:
     U8 m_val[GTP_FCONTAINER_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpFContainer(GtpInstance_t inst)
     {
@@ -2590,21 +1910,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_FCONTAINER_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpFCause : public GtpIe
@@ -2613,6 +1918,8 @@ class GtpFCause : public GtpIe
 private:
     U8 m_val[GTP_FCAUSE_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpFCause(GtpInstance_t inst)
     {
@@ -2639,21 +1946,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_FCAUSE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpSelectedPlmnId : public GtpIe
@@ -2662,6 +1954,8 @@ class GtpSelectedPlmnId : public GtpIe
 private:
     U8 m_val[GTP_SELECTED_PLMNID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpSelectedPlmnId(GtpInstance_t inst)
     {
@@ -2688,21 +1982,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_SELECTED_PLMNID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpTargetId : public GtpIe
@@ -2711,6 +1990,8 @@ class GtpTargetId : public GtpIe
 private:
     U8 m_val[GTP_TARGET_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpTargetId(GtpInstance_t inst)
     {
@@ -2737,21 +2018,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_TARGET_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpPacketFlowId : public GtpIe
@@ -2760,6 +2026,8 @@ class GtpPacketFlowId : public GtpIe
 private:
     U8 m_val[GTP_PACKET_FLOW_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpPacketFlowId(GtpInstance_t inst)
     {
@@ -2786,21 +2054,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_PACKET_FLOW_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpRabCntxt : public GtpIe
@@ -2809,6 +2062,8 @@ class GtpRabCntxt : public GtpIe
 private:
     U8 m_val[GTP_RAB_CNTXT_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpRabCntxt(GtpInstance_t inst)
     {
@@ -2835,21 +2090,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_RAB_CNTXT_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpSourceRncPdcpCntxtInfo : public GtpIe
@@ -2858,6 +2098,8 @@ class GtpSourceRncPdcpCntxtInfo : public GtpIe
 private:
     U8 m_val[GTP_SOURCE_RNC_PDCP_CNTXT_INFO_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpSourceRncPdcpCntxtInfo(GtpInstance_t inst)
     {
@@ -2885,22 +2127,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_SOURCE_RNC_PDCP_CNTXT_INFO_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpUdpSrcPort : public GtpIe
@@ -2909,6 +2135,8 @@ class GtpUdpSrcPort : public GtpIe
 private:
     U8 m_val[GTP_UDP_SRC_PORT_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpUdpSrcPort(GtpInstance_t inst)
     {
@@ -2935,21 +2163,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_UDP_SRC_PORT_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpApnRestriction : public GtpIe
@@ -2958,6 +2171,8 @@ class GtpApnRestriction : public GtpIe
 private:
     U8 m_val[GTP_APN_RESTRICTION_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpApnRestriction(GtpInstance_t inst)
     {
@@ -2980,25 +2195,10 @@ public:
     {
         return ROK;
     }
-    RETVAL buildIe(const GtpIeLst *pIeLst)
-    {
-        return ROK;
-    };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_APN_RESTRICTION_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
+    RETVAL buildIe(const GtpIeLst *pIeLst)
+    {
+        return ROK;
+    };
 };
 
 class GtpSrcId : public GtpIe
@@ -3007,6 +2207,8 @@ class GtpSrcId : public GtpIe
 private:
     U8 m_val[GTP_SRC_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpSrcId(GtpInstance_t inst)
     {
@@ -3033,21 +2235,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_SRC_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpChangeReportingAction : public GtpIe
@@ -3056,6 +2243,8 @@ class GtpChangeReportingAction : public GtpIe
 private:
     U8 m_val[GTP_CHANGE_REPORTING_ACTION_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpChangeReportingAction(GtpInstance_t inst)
     {
@@ -3083,22 +2272,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_CHANGE_REPORTING_ACTION_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpFqdn : public GtpIe
@@ -3107,6 +2280,8 @@ class GtpFqdn : public GtpIe
 private:
     U8 m_val[GTP_FQDN_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpFqdn(GtpInstance_t inst)
     {
@@ -3133,21 +2308,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_FQDN_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpChannelNeeded : public GtpIe
@@ -3156,6 +2316,8 @@ class GtpChannelNeeded : public GtpIe
 private:
     U8 m_val[GTP_CHANNEL_NEEDED_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpChannelNeeded(GtpInstance_t inst)
     {
@@ -3182,21 +2344,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_CHANNEL_NEEDED_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpEmlppPriority : public GtpIe
@@ -3205,6 +2352,8 @@ class GtpEmlppPriority : public GtpIe
 private:
     U8 m_val[GTP_EMLPP_PRIORITY_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpEmlppPriority(GtpInstance_t inst)
     {
@@ -3231,21 +2380,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_EMLPP_PRIORITY_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpNodeType : public GtpIe
@@ -3254,6 +2388,8 @@ class GtpNodeType : public GtpIe
 private:
     U8 m_val[GTP_NODE_TYPE_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpNodeType(GtpInstance_t inst)
     {
@@ -3280,21 +2416,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_NODE_TYPE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpFqCsid : public GtpIe
@@ -3303,6 +2424,8 @@ class GtpFqCsid : public GtpIe
 private:
     U8 m_val[GTP_FQ_CSID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpFqCsid(GtpInstance_t inst)
     {
@@ -3329,21 +2452,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_FQ_CSID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpTi : public GtpIe
@@ -3352,6 +2460,8 @@ class GtpTi : public GtpIe
 private:
     U8 m_val[GTP_TI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpTi(GtpInstance_t inst)
     {
@@ -3378,21 +2488,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_TI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMbmsServiceArea : public GtpIe
@@ -3401,6 +2496,8 @@ class GtpMbmsServiceArea : public GtpIe
 private:
     U8 m_val[GTP_MBMS_SERVICE_AREA_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMbmsServiceArea(GtpInstance_t inst)
     {
@@ -3427,21 +2524,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_MBMS_SERVICE_AREA_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMbmsSessionId : public GtpIe
@@ -3450,6 +2532,8 @@ class GtpMbmsSessionId : public GtpIe
 private:
     U8 m_val[GTP_MBMS_SESSION_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMbmsSessionId(GtpInstance_t inst)
     {
@@ -3476,21 +2560,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_MBMS_SESSION_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMbmsFlowId : public GtpIe
@@ -3499,6 +2568,8 @@ class GtpMbmsFlowId : public GtpIe
 private:
     U8 m_val[GTP_MBMS_FLOW_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMbmsFlowId(GtpInstance_t inst)
     {
@@ -3525,21 +2596,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_MBMS_FLOW_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMbmsIpMulticastDistribution : public GtpIe
@@ -3548,6 +2604,8 @@ class GtpMbmsIpMulticastDistribution : public GtpIe
 private:
     U8 m_val[GTP_MBMS_IP_MULTICAST_DISTRIBUTION_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMbmsIpMulticastDistribution(GtpInstance_t inst)
     {
@@ -3575,22 +2633,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MBMS_IP_MULTICAST_DISTRIBUTION_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMbmsDistributionAck : public GtpIe
@@ -3599,6 +2641,8 @@ class GtpMbmsDistributionAck : public GtpIe
 private:
     U8 m_val[GTP_MBMS_DISTRIBUTION_ACK_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMbmsDistributionAck(GtpInstance_t inst)
     {
@@ -3626,22 +2670,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MBMS_DISTRIBUTION_ACK_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpRfspIndex : public GtpIe
@@ -3650,6 +2678,8 @@ class GtpRfspIndex : public GtpIe
 private:
     U8 m_val[GTP_RFSP_INDEX_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpRfspIndex(GtpInstance_t inst)
     {
@@ -3676,21 +2706,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_RFSP_INDEX_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpUci : public GtpIe
@@ -3699,6 +2714,8 @@ class GtpUci : public GtpIe
 private:
     U8 m_val[GTP_UCI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpUci(GtpInstance_t inst)
     {
@@ -3725,21 +2742,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_UCI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpCsgInfoReportingAction : public GtpIe
@@ -3748,6 +2750,8 @@ class GtpCsgInfoReportingAction : public GtpIe
 private:
     U8 m_val[GTP_CSG_INFO_REPORTING_ACTION_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpCsgInfoReportingAction(GtpInstance_t inst)
     {
@@ -3775,22 +2779,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_CSG_INFO_REPORTING_ACTION_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpCsgId : public GtpIe
@@ -3799,6 +2787,8 @@ class GtpCsgId : public GtpIe
 private:
     U8 m_val[GTP_CSG_ID_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpCsgId(GtpInstance_t inst)
     {
@@ -3825,21 +2815,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_CSG_ID_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpCmi : public GtpIe
@@ -3848,6 +2823,8 @@ class GtpCmi : public GtpIe
 private:
     U8 m_val[GTP_CMI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpCmi(GtpInstance_t inst)
     {
@@ -3874,21 +2851,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_CMI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpServiceIndicator : public GtpIe
@@ -3897,6 +2859,8 @@ class GtpServiceIndicator : public GtpIe
 private:
     U8 m_val[GTP_SERVICE_INDICATOR_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpServiceIndicator(GtpInstance_t inst)
     {
@@ -3923,21 +2887,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_SERVICE_INDICATOR_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpDetachType : public GtpIe
@@ -3946,6 +2895,8 @@ class GtpDetachType : public GtpIe
 private:
     U8 m_val[GTP_DETACH_TYPE_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpDetachType(GtpInstance_t inst)
     {
@@ -3972,21 +2923,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_DETACH_TYPE_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpLdn : public GtpIe
@@ -3995,6 +2931,8 @@ class GtpLdn : public GtpIe
 private:
     U8 m_val[GTP_LDN_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpLdn(GtpInstance_t inst)
     {
@@ -4021,21 +2959,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_LDN_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpMbmsTimeToDataTransfer : public GtpIe
@@ -4044,6 +2967,8 @@ class GtpMbmsTimeToDataTransfer : public GtpIe
 private:
     U8 m_val[GTP_MBMS_TIME_TO_DATA_TRANSFER_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpMbmsTimeToDataTransfer(GtpInstance_t inst)
     {
@@ -4071,22 +2996,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_MBMS_TIME_TO_DATA_TRANSFER_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpTmgi : public GtpIe
@@ -4095,6 +3004,8 @@ class GtpTmgi : public GtpIe
 private:
     U8 m_val[GTP_TMGI_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpTmgi(GtpInstance_t inst)
     {
@@ -4121,21 +3032,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(inbuf, m_val, GTP_TMGI_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpAdditionalMmCntxtForSrvcc : public GtpIe
@@ -4144,6 +3040,8 @@ class GtpAdditionalMmCntxtForSrvcc : public GtpIe
 private:
     U8 m_val[GTP_ADDITIONAL_MM_CNTXT_FOR_SRVCC_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpAdditionalMmCntxtForSrvcc(GtpInstance_t inst)
     {
@@ -4171,22 +3069,6 @@ public:
     {
         return ROK;
     };
-
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
-    {
-        return decodeHelper(
-            inbuf, m_val, GTP_ADDITIONAL_MM_CNTXT_FOR_SRVCC_MAX_BUF_LEN);
-    }
-
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
 };
 
 class GtpAdditionalFlagsForSrvcc : public GtpIe
@@ -4195,6 +3077,8 @@ class GtpAdditionalFlagsForSrvcc : public GtpIe
 private:
     U8 m_val[GTP_ADDITIONAL_FLAGS_FOR_SRVCC_MAX_BUF_LEN];
 
+    friend class GtpIe;
+
 public:
     GtpAdditionalFlagsForSrvcc(GtpInstance_t inst)
     {
@@ -4222,22 +3106,217 @@ public:
     {
         return ROK;
     };
+};
 
-    GtpLength_t encode(U8 *outbuf)
-    {
-        return encodeHelper(m_val, outbuf);
-    }
-
-    GtpLength_t decode(const U8 *inbuf)
+/* IE catalogue, one entry per IE: IE type, IE class, maximum length of the
+ * IE value and whether the IE is grouped. The factory, the codec and the
+ * IE traits are generated from the catalogue.
+ */
+#define GTP_IE_CATALOGUE(_X)\
+    _X(GTP_IE_IMSI, GtpImsi,\
+        GTP_IMSI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_CAUSE, GtpCause,\
+        GTP_CAUSE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_RECOVERY, GtpRecovery,\
+        GTP_RECOVERY_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_STN_SR, GtpStnSr,\
+        GTP_STN_SR_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_APN, GtpApn,\
+        GTP_APN_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_AMBR, GtpAmbr,\
+        GTP_AMBR_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_EBI, GtpEbi,\
+        GTP_EBI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_IP_ADDR, GtpIpAddress,\
+        GTP_IP_ADDRESS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MEI, GtpMei,\
+        GTP_MEI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MSISDN, GtpMsisdn,\
+        GTP_MSISDN_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_INDICATION, GtpIndication,\
+        GTP_INDICATION_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PCO, GtpPco,\
+        GTP_PCO_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PAA, GtpPaa,\
+        GTP_PAA_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_BEARER_QOS, GtpBearerQos,\
+        GTP_BEARER_QOS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_FLOW_QOS, GtpFlowQos,\
+        GTP_FLOW_QOS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_RAT_TYPE, GtpRatType,\
+        GTP_RAT_TYPE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_SERVING_NW, GtpServingNw,\
+        GTP_SERVING_NW_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_EPS_BEARER_TFT, GtpEpsBearerTft,\
+        GTP_EPS_BEARER_TFT_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_TAD, GtpTad,\
+        GTP_TAD_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_ULI, GtpUli,\
+        GTP_ULI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_FTEID, GtpFteid,\
+        GTP_FTEID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_TMSI, GtpTmsi,\
+        GTP_TMSI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_GLOBAL_CN_ID, GtpGlobalCnId,\
+        GTP_GLOBAL_CN_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_S103_PDF, GtpS103Pdf,\
+        GTP_S103_PDN_DATA_FWD_INFO_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_S1UDF, GtpS1uDf,\
+        GTP_S1U_DATA_FWD_INFO_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_DELAY_VALUE, GtpDelayValue,\
+        GTP_DELAY_VALUE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_BEARER_CNTXT, GtpBearerContext,\
+        GTP_BEARER_CNTXT_MAX_BUF_LEN, TRUE)\
+    _X(GTP_IE_CHARGING_ID, GtpChargingId,\
+        GTP_CHARGING_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_CHARGING_CHARACTERISTICS, GtpChargingCharcs,\
+        GTP_CHARGING_CHARCS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_TRACE_INFO, GtpTraceInfo,\
+        GTP_TRACE_INFO_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_BEARER_FLAGS, GtpBearerFlags,\
+        GTP_BEARER_FLAGS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PDN_TYPE, GtpPdnType,\
+        GTP_PDN_TYPE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PTI, GtpPti,\
+        GTP_PTI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_DRX_PARAM, GtpDrxParam,\
+        GTP_DRX_PARAM_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_UE_NETWORK_CAP, GtpUeNetworkCap,\
+        GTP_UE_NETWORK_CAP_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MM_CNTXT_GSM_KEY_N_TRIPLETS, GtpMmCntxtGsmKeyAndTriplets,\
+        GTP_MM_CNTXT_GSM_KEY_AND_TRIPLETS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MM_CNTXT_UMTS_KEY_USED_CIPHER_N_QUINT, GtpMmCntxtUmtsKeyUsedCipherAndQuint,\
+        GTP_MM_CNTXT_UMTS_KEY_USED_CIPHER_AND_QUINTS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MM_CNTXT_GSM_KEY_USED_CIPHER_N_QUINT, GtpMmCntxtGsmKeyUsedCipherAndQuint,\
+        GTP_MM_CNTXT_GSM_KEY_USED_CIPHER_N_QUINT_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MM_CNTXT_UMTS_KEY_N_QUINT, GtpMmCntxtUmtsKeyAndQuint,\
+        GTP_MM_CNTXT_UMTS_KEY_AND_QUINTS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MM_CNTXT_EPS_SEC_CNTXT_QUADR_N_QUINT, GtpMmCntxtEpcSecCntxtQuadrAndQuint,\
+        GTP_MM_CNTXT_EPS_SEC_CNTXT_QUADR_AND_QUITNS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MM_CNTXT_UMTS_KEY_QUADR_N_QUINT, GtpMmCntxtUmtsKeyQuadrAndQuint,\
+        GTP_MM_CNTXT_UMTS_KEY_QUADR_AND_QUINTS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PDN_CONNECTION, GtpPdnConnection,\
+        GTP_PDN_CONNECTION_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PDU_NUMBERS, GtpPduNumbers,\
+        GTP_PDU_NUMBERS_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PTMSI, GtpPtmsi,\
+        GTP_PTMSI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PTMSI_SIGNATURE, GtpPtmsiSignature,\
+        GTP_PTMSI_SIGNAURE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_HOP_COUNTER, GtpHopCounter,\
+        GTP_HOP_COUNTER_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_UE_TIME_ZONE, GtpUeTimeZone,\
+        GTP_UE_TIME_ZONE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_TRACE_REFERENCE, GtpTraceReference,\
+        GTP_TRACE_REFERENCE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_COMPLETE_REQ_MSG, GtpCompleteReqMsg,\
+        GTP_COMPLETE_REQ_MSG_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_GUTI, GtpGuti,\
+        GTP_GUTI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_FCONTAINER, GtpFContainer,\
+        GTP_FCONTAINER_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_FCAUSE, GtpFCause,\
+        GTP_FCAUSE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_SELECTED_PLMN_ID, GtpSelectedPlmnId,\
+        GTP_SELECTED_PLMNID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_TARGET_ID, GtpTargetId,\
+        GTP_TARGET_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_PACKET_FLOW_ID, GtpPacketFlowId,\
+        GTP_PACKET_FLOW_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_RAB_CNTXT, GtpRabCntxt,\
+        GTP_RAB_CNTXT_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_SOURCE_RNC_PDCP_CNTXT_INFO, GtpSourceRncPdcpCntxtInfo,\
+        GTP_SOURCE_RNC_PDCP_CNTXT_INFO_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_UDP_SRC_PORT, GtpUdpSrcPort,\
+        GTP_UDP_SRC_PORT_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_APN_RESTRICTION, GtpApnRestriction,\
+        GTP_APN_RESTRICTION_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_SELECTION_MODE, GtpSelectionMode,\
+        GTP_SEL_MODE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_SRC_ID, GtpSrcId,\
+        GTP_SRC_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_CHANGE_REPORTING_ACTION, GtpChangeReportingAction,\
+        GTP_CHANGE_REPORTING_ACTION_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_FQ_CSID, GtpFqCsid,\
+        GTP_FQ_CSID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_CHANNEL_NEEDED, GtpChannelNeeded,\
+        GTP_CHANNEL_NEEDED_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_EMLPP_PRIORITY, GtpEmlppPriority,\
+        GTP_EMLPP_PRIORITY_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_NODE_TYPE, GtpNodeType,\
+        GTP_NODE_TYPE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_FQDN, GtpFqdn,\
+        GTP_FQDN_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_TI, GtpTi,\
+        GTP_TI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MBMS_SESSION_DURATION, GtpMbmsSessionDuration,\
+        GTP_MBMS_SESSION_DURATION_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MBMS_SERVICE_AREA, GtpMbmsServiceArea,\
+        GTP_MBMS_SERVICE_AREA_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MBMS_SESSION_ID, GtpMbmsSessionId,\
+        GTP_MBMS_SESSION_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MBMS_FLOW_ID, GtpMbmsFlowId,\
+        GTP_MBMS_FLOW_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MBMS_IP_MULTICAST_DISTRIBUTION, GtpMbmsIpMulticastDistribution,\
+        GTP_MBMS_IP_MULTICAST_DISTRIBUTION_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MBMS_DISTRIBUTION_ACK, GtpMbmsDistributionAck,\
+        GTP_MBMS_DISTRIBUTION_ACK_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_RFSP_INDEX, GtpRfspIndex,\
+        GTP_RFSP_INDEX_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_UCI, GtpUci,\
+        GTP_UCI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_CSG_INFO_REPORTING_ACTION, GtpCsgInfoReportingAction,\
+        GTP_CSG_INFO_REPORTING_ACTION_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_CSG_ID, GtpCsgId,\
+        GTP_CSG_ID_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_CMI, GtpCmi,\
+        GTP_CMI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_SERVICE_INDICATOR, GtpServiceIndicator,\
+        GTP_SERVICE_INDICATOR_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_DETACH_TYPE, GtpDetachType,\
+        GTP_DETACH_TYPE_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_LDN, GtpLdn,\
+        GTP_LDN_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_MBMS_TIME_TO_DATA_TRANSFER, GtpMbmsTimeToDataTransfer,\
+        GTP_MBMS_TIME_TO_DATA_TRANSFER_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_TMGI, GtpTmgi,\
+        GTP_TMGI_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_ADDITIONAL_MM_CNTXT_FOR_SRVCC, GtpAdditionalMmCntxtForSrvcc,\
+        GTP_ADDITIONAL_MM_CNTXT_FOR_SRVCC_MAX_BUF_LEN, FALSE)\
+    _X(GTP_IE_ADDITIONAL_FLAGS_FOR_SRVCC, GtpAdditionalFlagsForSrvcc,\
+        GTP_ADDITIONAL_FLAGS_FOR_SRVCC_MAX_BUF_LEN, FALSE)
+
+/* compile time traits of an IE class */
+template <class C> struct GtpIeTraits;
+
+#define GTP_IE_TRAITS(_type, _class, _maxLen, _grouped)\
+    template <> struct GtpIeTraits<_class>\
+    {\
+        static constexpr GtpIeType_t type    = _type;\
+        static constexpr GtpLength_t maxLen  = _maxLen;\
+        static constexpr BOOL        grouped = _grouped;\
+    };
+
+GTP_IE_CATALOGUE(GTP_IE_TRAITS)
+
+#undef GTP_IE_TRAITS
+
+/**
+ * @brief
+ *    Converts an IE to its IE class, the IE type is checked instead of the
+ *    run time type information
+ *
+ * @return
+ *    NULL if the IE is not of the class
+ */
+template <class C> inline C *gtpIeCast(GtpIe *pIe)
+{
+    if ((NULL == pIe) || (GtpIeTraits<C>::type != pIe->type()))
     {
-        return decodeHelper(
-            inbuf, m_val, GTP_ADDITIONAL_FLAGS_FOR_SRVCC_MAX_BUF_LEN);
+        return NULL;
     }
 
-    BOOL isGroupedIe()
-    {
-        return FALSE;
-    }
-};
+    return static_cast<C *>(pIe);
+}
 
 #endif
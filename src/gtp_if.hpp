@@ -40,16 +40,18 @@ class GtpIe
       virtual RETVAL buildIe(const GtpIeLst *pIeLst) = 0;
 
       /* encodes IE header and Contents into a byte buffer pointed by pBuf
-       * returns the length of encoded buffer
+       * returns the length of encoded buffer. The codec is generated from
+       * the IE catalogue and dispatched on the IE type, not through the
+       * virtual table.
        */
-      virtual GtpLength_t encode(U8 *pBuf) = 0;
+      GtpLength_t encode(U8 *pBuf);
 
       /* decodes the IE from the byte buffer, updates the ie header length
        * and copies the ie contents into local buffer
        */
-      virtual GtpLength_t decode(const U8 *ieBuf) = 0;
+      GtpLength_t decode(const U8 *ieBuf);
 
-      virtual BOOL   isGroupedIe() = 0;
+      BOOL   isGroupedIe();
 
       virtual ~GtpIe() {};
 
@@ -22,6 +22,8 @@
    _type = (GtpMsgType_t)(_buf[1]);                         \
 }
 
+#define GTP_MSG_GET_VER(_buf)    ((_buf)[0] >> 5)
+
 #define GTP_MSG_GET_LEN(_buf, _len)                         \
 {                                                           \
    _len = (GtpLength_t)((_buf[2] << 8) | (_buf[3]));        \
@@ -36,32 +36,60 @@ using std::list;
  */
 GtpMsg::GtpMsg(GtpMsgType_t msgType)
 {
-   MEMSET(m_gtpMsgBuf, 0, GTP_MSG_BUF_LEN);
+   m_pIeBuf = NULL;
+   m_ieBufLen = 0;
    m_msgHdr.msgType = msgType;
    m_bearersToCreate = 0;
    m_bearersToDelete = 0;
    m_bearersToModify = 0;
+   m_decoded = TRUE;
+   m_indexed = FALSE;
+   m_numIeRefs = 0;
+   m_ieTbl.seal();
 }
 
-GtpMsg::GtpMsg(Buffer *pBuf)
+/**
+ * @brief
+ *    constructs a received message as a view over the received buffer,
+ *    the IEs are not copied, so the buffer must outlive the message. The
+ *    IEs are located by index() and read by the typed accessors, GtpIe
+ *    objects are created only when getIe() is called
+ *
+ * @param pBuf
+ * @param len
+ */
+GtpMsg::GtpMsg(U8 *pBuf, U32 len)
 {
    m_bearersToCreate = 0;
    m_bearersToDelete = 0;
    m_bearersToModify = 0;
+   m_decoded = FALSE;
+   m_indexed = FALSE;
+   m_numIeRefs = 0;
 
-   decodeHdr(pBuf->pVal);
+   decodeHdr(pBuf);
 
-   if (pBuf->len <= GTP_MSG_BUF_LEN)
+   if (len <= GTP_MSG_BUF_LEN)
    {
+      U32 hdrLen = GTP_MSG_HDR_LEN_WITHOUT_TEID;
       if (GSIM_CHK_MASK(m_msgHdr.pres, GTP_MSG_T_BIT_PRES))
       {
-         MEMCPY(m_gtpMsgBuf, pBuf->pVal + GTP_MSG_HDR_LEN,\
-               (pBuf->len - GTP_MSG_HDR_LEN));
+         hdrLen = GTP_MSG_HDR_LEN;
       }
-      else
+
+      /* the length in the header does not count the first 4 bytes, the
+       * IEs are limited to the received bytes if the message is truncated
+       */
+      m_pIeBuf = pBuf + hdrLen;
+      m_ieBufLen = 0;
+      if ((U32)m_msgHdr.len + GTPC_HDR_MAND_LEN > hdrLen)
+      {
+         m_ieBufLen = m_msgHdr.len + GTPC_HDR_MAND_LEN - hdrLen;
+      }
+
+      if (hdrLen + m_ieBufLen > len)
       {
-         MEMCPY(m_gtpMsgBuf, pBuf->pVal + GTP_MSG_HDR_LEN_WITHOUT_TEID,\
-               (pBuf->len - GTP_MSG_HDR_LEN_WITHOUT_TEID));
+         m_ieBufLen = (len > hdrLen) ? (len - hdrLen) : 0;
       }
    }
    else
@@ -70,9 +98,133 @@ GtpMsg::GtpMsg(Buffer *pBuf)
    }
 }
 
+/**
+ * @brief
+ *    constructs a received message as a view over the received buffer from
+ *    the header pre-parsed by GtpMsg::parse(), the header is not decoded
+ *    again
+ *
+ * @param pBuf
+ * @param pDesc
+ */
+GtpMsg::GtpMsg(U8 *pBuf, const GtpMsgDesc *pDesc)
+{
+   m_msgHdr = pDesc->hdr;
+   m_pIeBuf = pBuf + pDesc->ieOff;
+   m_ieBufLen = pDesc->ieLen;
+   m_bearersToCreate = 0;
+   m_bearersToDelete = 0;
+   m_bearersToModify = 0;
+   m_decoded = FALSE;
+   m_indexed = FALSE;
+   m_numIeRefs = 0;
+}
+
+/**
+ * @brief
+ *    Pre-parses the header of a received message, once per message. The
+ *    length in the header is checked against the received length before
+ *    any IE is looked at, so a truncated message is rejected without
+ *    walking its IEs. The IMSI of a create session or forward relocation
+ *    request is located for the session lookup.
+ *
+ * @param pBuf
+ * @param len
+ *    number of bytes received
+ * @param pDesc
+ *
+ * @return
+ *    ERR_INVALID_GTP_MSG if the message is not a GTPv2-C message or is
+ *    truncated, ERR_INVALID_IE_LENGTH if an IE before the IMSI overruns
+ *    the message or the IMSI is too long
+ */
+RETVAL GtpMsg::parse(U8 *pBuf, U32 len, GtpMsgDesc *pDesc)
+{
+   LOG_ENTERFN();
+
+   GtpMsgHdr   *pHdr = &pDesc->hdr;
+   U32         hdrLen = GTP_MSG_HDR_LEN_WITHOUT_TEID;
+
+   if ((len < hdrLen) || (GTPC_VERSION != GTP_MSG_GET_VER(pBuf)))
+   {
+      LOG_EXITFN(ERR_INVALID_GTP_MSG);
+   }
+
+   pHdr->pres = 0;
+   pHdr->ver = GTPC_VERSION;
+   pHdr->teid = 0;
+   if (GTP_CHK_T_BIT_PRESENT(pBuf))
+   {
+      GSIM_SET_MASK(pHdr->pres, GTP_MSG_T_BIT_PRES);
+      hdrLen = GTP_MSG_HDR_LEN;
+   }
+
+   if (GTP_CHK_P_BIT_PRESENT(pBuf))
+   {
+      GSIM_SET_MASK(pHdr->pres, GTP_MSG_P_BIT_PRES);
+   }
+
+   /* the length in the header does not count the first 4 bytes, the bytes
+    * after the message are a piggybacked message and are not looked at
+    */
+   GTP_MSG_GET_TYPE(pBuf, pHdr->msgType);
+   GTP_MSG_GET_LEN(pBuf, pHdr->len);
+   U32 msgLen = (U32)pHdr->len + GTPC_HDR_MAND_LEN;
+   if ((msgLen < hdrLen) || (msgLen > len))
+   {
+      LOG_EXITFN(ERR_INVALID_GTP_MSG);
+   }
+
+   if (GSIM_CHK_MASK(pHdr->pres, GTP_MSG_T_BIT_PRES))
+   {
+      GTP_MSG_DEC_TEID(pBuf, pHdr->teid);
+   }
+
+   GTP_MSG_GET_SEQN(pBuf, pHdr->seqN);
+
+   pDesc->ieOff = hdrLen;
+   pDesc->ieLen = msgLen - hdrLen;
+   pDesc->imsiOff = 0;
+   pDesc->imsiLen = 0;
+
+   if ((GTPC_MSG_CS_REQ == pHdr->msgType) ||
+       (GTPC_MSG_FR_REQ == pHdr->msgType))
+   {
+      U32 off = hdrLen;
+      while (off + GTP_IE_HDR_LEN <= msgLen)
+      {
+         GtpIeHdr ieHdr;
+         decIeHdr(pBuf + off, &ieHdr);
+
+         U32 valOff = off + GTP_IE_HDR_LEN;
+         if (valOff + ieHdr.len > msgLen)
+         {
+            LOG_EXITFN(ERR_INVALID_IE_LENGTH);
+         }
+
+         if (GTP_IE_IMSI == ieHdr.ieType)
+         {
+            if (ieHdr.len > GTP_IMSI_MAX_BUF_LEN)
+            {
+               LOG_EXITFN(ERR_INVALID_IE_LENGTH);
+            }
+
+            pDesc->imsiOff = valOff;
+            pDesc->imsiLen = ieHdr.len;
+            break;
+         }
+
+         off = valOff + ieHdr.len;
+      }
+   }
+
+   LOG_EXITFN(ROK);
+}
+
 GtpMsg::~GtpMsg()
 {
-   for (GtpIeLstItr itr = m_ieLst.begin(); itr != m_ieLst.end(); itr++)
+   for (GtpIeVec::iterator itr = m_ieVec.begin(); itr != m_ieVec.end();\
+         itr++)
    {
       delete *itr;
    }
@@ -94,13 +246,21 @@ RETVAL GtpMsg::encode(GtpIeLst  *pIeLst)
 
    for (GtpIeLstItr ie = pIeLst->begin(); ie != pIeLst->end(); ie++)
    {
-      m_ieLst.push_back(*ie);
+      m_ieVec.push_back(*ie);
       if (GTP_IE_BEARER_CNTXT == (*ie)->type())
       {
          updateBearerCount((*ie)->instance());
       }
    }
 
+   m_ieTbl.clear();
+   for (GtpIeVec::iterator ie = m_ieVec.begin(); ie != m_ieVec.end(); ie++)
+   {
+      m_ieTbl.add((*ie)->type(), (*ie)->instance());
+   }
+   m_ieTbl.seal();
+   m_ieTbl.place();
+
    LOG_EXITFN(ret);
 }
 
@@ -121,7 +281,7 @@ RETVAL GtpMsg::setSenderFteid(GtpTeid_t teid, const IpAddr *pIp)
    GtpIe *pGtpIe = getIe(GTP_IE_FTEID, 0, 1);
    if (NULL != pGtpIe)
    {
-      GtpFteid *pFteid = dynamic_cast<GtpFteid *>(pGtpIe);
+      GtpFteid *pFteid = gtpIeCast<GtpFteid>(pGtpIe);
       pFteid->setTeid(teid);
       pFteid->setIpAddr(pIp);
    }
@@ -180,7 +340,7 @@ RETVAL GtpMsg::encode(U8 *pBuf, U32 *pLen)
    }
 
    /* encode all the IEs */
-   for (GtpIeLst::iterator ie = m_ieLst.begin(); ie != m_ieLst.end(); ie++)
+   for (GtpIeVec::iterator ie = m_ieVec.begin(); ie != m_ieVec.end(); ie++)
    {
       U32 len = (*ie)->encode(pTmpBuf);
       if (ROK == ret)
@@ -205,16 +365,35 @@ RETVAL GtpMsg::decode()
 {
    LOG_ENTERFN();
 
-   U8 *pMsgBuf = m_gtpMsgBuf;
-   GtpLength_t len = m_msgHdr.len - (GTP_TEID_LEN + GTPC_HDR_SEQN_LEN + \
-         GTPC_HDR_SPARE_LEN);
+   if (m_decoded)
+   {
+      LOG_EXITFN(ROK);
+   }
+
+   m_decoded = TRUE;
+
+   /* the lookup table is built by the index, the decoded IEs are in the
+    * same order as the indexed IEs
+    */
+   index();
+
+   U8 *pMsgBuf = m_pIeBuf;
+   U32 len = m_ieBufLen;
    while (len > 0)
    {
       GtpIeType_t    ieType = GTP_IE_RESERVED;
       GtpInstance_t  ieInst = 0;
+      GtpLength_t    ieValLen = 0;
 
       GTP_GET_IE_TYPE(pMsgBuf, ieType);
       GTP_GET_IE_INSTANCE(pMsgBuf, ieInst);
+      GTP_GET_IE_LEN(pMsgBuf, ieValLen);
+      if ((len < GTP_IE_HDR_LEN) || (len - GTP_IE_HDR_LEN < ieValLen))
+      {
+         LOG_ERROR("Invalid IE length, IE [%d]", ieType);
+         LOG_EXITFN(ERR_INVALID_IE_LENGTH);
+      }
+
       if (GTP_IE_BEARER_CNTXT == ieType)
       {
          updateBearerCount(ieInst);
@@ -222,7 +401,7 @@ RETVAL GtpMsg::decode()
 
       GtpIe *pIe = GtpIe::createGtpIe(ieType, ieInst);
       U32 ieLen = pIe->decode(pMsgBuf);
-      m_ieLst.push_back(pIe);
+      m_ieVec.push_back(pIe);
 
       pMsgBuf += ieLen;
       len -= ieLen;
@@ -231,6 +410,68 @@ RETVAL GtpMsg::decode()
    LOG_EXITFN(ROK);
 }
 
+/**
+ * @brief
+ *    Indexes the top level IEs of a received message in one pass over the
+ *    buffer, without decoding them
+ *
+ * @return
+ *    ERR_INVALID_IE_LENGTH if an IE overruns the message, RFAILED if the
+ *    message has more IEs than the index holds
+ */
+RETVAL GtpMsg::index()
+{
+   LOG_ENTERFN();
+
+   U32 off = 0;
+
+   if (m_indexed)
+   {
+      LOG_EXITFN(ROK);
+   }
+
+   if (NULL == m_pIeBuf)
+   {
+      LOG_EXITFN(RFAILED);
+   }
+
+   /* the table is empty, it is cleared when indexing fails */
+   m_numIeRefs = 0;
+   while (off < m_ieBufLen)
+   {
+      U8 *pBuf = m_pIeBuf + off;
+
+      if (m_numIeRefs == GTP_MSG_MAX_IE_REFS)
+      {
+         m_ieTbl.clear();
+         LOG_EXITFN(RFAILED);
+      }
+
+      GtpIeRef *pRef = &m_ieRefs[m_numIeRefs];
+      GTP_GET_IE_TYPE(pBuf, pRef->type);
+      GTP_GET_IE_INSTANCE(pBuf, pRef->inst);
+      GTP_GET_IE_LEN(pBuf, pRef->len);
+      pRef->off = off;
+
+      if ((m_ieBufLen - off < GTP_IE_HDR_LEN) ||
+          (m_ieBufLen - off - GTP_IE_HDR_LEN < pRef->len))
+      {
+         LOG_ERROR("Invalid IE length, IE [%d]", pRef->type);
+         m_numIeRefs = 0;
+         m_ieTbl.clear();
+         LOG_EXITFN(ERR_INVALID_IE_LENGTH);
+      }
+
+      m_ieTbl.add(pRef->type, pRef->inst);
+      off += GTP_IE_HDR_LEN + pRef->len;
+      m_numIeRefs++;
+   }
+
+   m_ieTbl.seal();
+   m_indexed = TRUE;
+   LOG_EXITFN(ROK);
+}
+
 U32 GtpMsg::encodeHdr(U8 *pBuf)
 {
    LOG_ENTERFN();
@@ -306,7 +547,16 @@ U32 GtpMsg::getIeCount(GtpIeType_t ieType, GtpInstance_t inst)
 
    U32      cnt = 0;
 
-   for (GtpIeLstItr ie = m_ieLst.begin(); ie != m_ieLst.end(); ie++)
+   /* the IEs of a received message are counted in the index without
+    * decoding them
+    */
+   if (m_ieTbl.valid() || (ROK == index()))
+   {
+      LOG_EXITFN(m_ieTbl.count(ieType, inst));
+   }
+
+   decode();
+   for (GtpIeVec::iterator ie = m_ieVec.begin(); ie != m_ieVec.end(); ie++)
    {
       if ((*ie)->type() == ieType && (*ie)->instance() == inst)
       {
@@ -323,7 +573,21 @@ GtpIe* GtpMsg::getIe(GtpIeType_t  ieType, GtpInstance_t  inst, U32 occurance)
 
    GtpIe    *pIe = NULL;
    U32      cnt = 0;
-   for (GtpIeLstItr ie = m_ieLst.begin(); ie != m_ieLst.end(); ie++)
+
+   /* the IEs of a received message are created on first use */
+   decode();
+   if (m_ieTbl.valid())
+   {
+      S32 pos = m_ieTbl.find(ieType, inst, occurance);
+      if ((pos >= 0) && ((U32)pos < m_ieVec.size()))
+      {
+         pIe = m_ieVec[pos];
+      }
+
+      LOG_EXITFN(pIe);
+   }
+
+   for (GtpIeVec::iterator ie = m_ieVec.begin(); ie != m_ieVec.end(); ie++)
    {
       if ((*ie)->type() == ieType && (*ie)->instance() == inst)
       {
@@ -360,40 +624,51 @@ U32               occr
 {
    LOG_ENTERFN();
 
-   U8          *pIeBufPtr = NULL;
-   GtpIeHdr    ieHdr;
-   U32         cnt = 0;
-   GtpLength_t len = m_msgHdr.len;
-   U8          *pBuf = m_gtpMsgBuf;
+   U8             *pIeBufPtr = NULL;
+   const GtpIeRef *pRef = NULL;
 
-   while (len)
+   if (useIndex())
    {
-      decIeHdr(pBuf, &ieHdr);
-      if (ieHdr.ieType == ieType && ieHdr.instance == inst)
+      pRef = findIe(ieType, inst, occr);
+      if (NULL != pRef)
       {
-         cnt++;
-         if (cnt == occr)
+         pIeBufPtr = m_pIeBuf + pRef->off;
+      }
+   }
+   else if (NULL != m_pIeBuf)
+   {
+      /* more IEs than the index holds */
+      GtpIeHdr ieHdr;
+      U32      cnt = 0;
+      U32      off = 0;
+      while (off + GTP_IE_HDR_LEN <= m_ieBufLen)
+      {
+         decIeHdr(m_pIeBuf + off, &ieHdr);
+         if (ieHdr.ieType == ieType && ieHdr.instance == inst &&
+             ++cnt == occr)
          {
-            pIeBufPtr = pBuf;
+            pIeBufPtr = m_pIeBuf + off;
             break;
          }
-      }
 
-      len -= (ieHdr.len + GTP_IE_HDR_LEN);
-      pBuf += (ieHdr.len + GTP_IE_HDR_LEN);
+         off += (ieHdr.len + GTP_IE_HDR_LEN);
+      }
    }
 
    LOG_EXITFN(pIeBufPtr);
 }
 
-VOID GtpMsg::setImsi(GtpImsiKey *pImsiKey)
+VOID GtpMsg::setImsi(const GtpImsiKey *pImsiKey)
 {
    LOG_ENTERFN();
 
    GtpIe    *pGtpIe = getIe(GTP_IE_IMSI, 0, 1);
-   GtpImsi  *pImsi = dynamic_cast<GtpImsi *>(pGtpIe);
+   GtpImsi  *pImsi = gtpIeCast<GtpImsi>(pGtpIe);
 
-   pImsi->setImsi(pImsiKey);
+   if (NULL != pImsi)
+   {
+      pImsi->setImsi(pImsiKey);
+   }
 
    LOG_EXITVOID();
 }
@@ -415,3 +690,273 @@ VOID GtpMsg::updateBearerCount(GtpInstance_t inst)
       m_bearersToCreate++;
    }
 }
+
+/**
+ * @brief
+ *    Returns TRUE if the IEs of the message are looked up in the index of
+ *    the received buffer, and not in the decoded IE list
+ */
+BOOL GtpMsg::useIndex()
+{
+   return ((NULL != m_pIeBuf) && (m_indexed || (ROK == index())));
+}
+
+const GtpIeRef *GtpMsg::findIe
+(
+GtpIeType_t       ieType,
+GtpInstance_t     inst,
+U32               occr
+)
+{
+   S32 pos = m_ieTbl.find(ieType, inst, occr);
+
+   return (pos >= 0) ? &m_ieRefs[pos] : NULL;
+}
+
+/**
+ * @brief
+ *    Returns the TEID of the first F-TEID IE of the instance, the TEID is
+ *    read from the received buffer without decoding the IE
+ *
+ * @param inst
+ * @param pTeid
+ *
+ * @return
+ *    ERR_IE_NOT_FOUND if the message does not have the F-TEID
+ */
+RETVAL GtpMsg::getFteidTeid(GtpInstance_t inst, GtpTeid_t *pTeid)
+{
+   LOG_ENTERFN();
+
+   RETVAL ret = ROK;
+
+   if (useIndex())
+   {
+      const GtpIeRef *pRef = findIe(GTP_IE_FTEID, inst, 1);
+      if (NULL == pRef)
+      {
+         ret = ERR_IE_NOT_FOUND;
+      }
+      else if (pRef->len < 1 + GTP_TEID_LEN)
+      {
+         ret = ERR_INVALID_IE_LENGTH;
+      }
+      else
+      {
+         GTP_DEC_TEID(m_pIeBuf + pRef->off + GTP_IE_HDR_LEN + 1, *pTeid);
+      }
+   }
+   else
+   {
+      GtpFteid *pFteid = gtpIeCast<GtpFteid>\
+            (getIe(GTP_IE_FTEID, inst, 1));
+      if (NULL != pFteid)
+      {
+         *pTeid = pFteid->getTeid();
+      }
+      else
+      {
+         ret = ERR_IE_NOT_FOUND;
+      }
+   }
+
+   LOG_EXITFN(ret);
+}
+
+/**
+ * @brief
+ *    Returns the EBIs of the bearer context IEs of the instance, a bearer
+ *    context without an EBI is skipped
+ *
+ * @param inst
+ * @param pEbi
+ * @param maxEbi
+ *
+ * @return
+ *    number of EBIs
+ */
+U32 GtpMsg::getBearerEbis(GtpInstance_t inst, GtpEbi_t *pEbi, U32 maxEbi)
+{
+   LOG_ENTERFN();
+
+   U32 cnt = 0;
+
+   if (useIndex())
+   {
+      /* a single pass over the index, in message order */
+      for (U32 i = 0; (i < m_numIeRefs) && (cnt < maxEbi); i++)
+      {
+         const GtpIeRef *pRef = &m_ieRefs[i];
+         if ((GTP_IE_BEARER_CNTXT != pRef->type) || (inst != pRef->inst))
+         {
+            continue;
+         }
+
+         /* EBI of instance 0 within the grouped IE */
+         U8 *pGrpBuf = m_pIeBuf + pRef->off + GTP_IE_HDR_LEN;
+         U32 off = 0;
+         while (off + GTP_IE_HDR_LEN < pRef->len)
+         {
+            GtpIeHdr ieHdr;
+            decIeHdr(pGrpBuf + off, &ieHdr);
+            if (off + GTP_IE_HDR_LEN + ieHdr.len > pRef->len)
+            {
+               break;
+            }
+
+            if ((GTP_IE_EBI == ieHdr.ieType) && (0 == ieHdr.instance) &&
+                (ieHdr.len > 0))
+            {
+               GTP_DEC_EBI(pGrpBuf + off, pEbi[cnt]);
+               cnt++;
+               break;
+            }
+
+            off += GTP_IE_HDR_LEN + ieHdr.len;
+         }
+      }
+   }
+   else
+   {
+      U32 bearerCnt = getIeCount(GTP_IE_BEARER_CNTXT, inst);
+      for (U32 i = 1; (i <= bearerCnt) && (cnt < maxEbi); i++)
+      {
+         GtpBearerContext *pBearerCntxt = gtpIeCast<GtpBearerContext>\
+               (getIe(GTP_IE_BEARER_CNTXT, inst, i));
+         GtpEbi_t ebi = pBearerCntxt->getEbi();
+         if (0 != ebi)
+         {
+            pEbi[cnt++] = ebi;
+         }
+      }
+   }
+
+   LOG_EXITFN(cnt);
+}
+
+VOID GtpIeTable::clear()
+{
+   m_valid    = FALSE;
+   m_placed   = FALSE;
+   m_numIes   = 0;
+   m_numSlots = 0;
+   MEMSET(m_typeSlot, 0, sizeof(m_typeSlot));
+}
+
+/**
+ * @brief
+ *    Adds the next IE of the message to the table
+ *
+ * @return
+ *    FALSE if the message has more IEs than the table holds, the table is
+ *    not valid after it is sealed
+ */
+BOOL GtpIeTable::add(U8 type, GtpInstance_t inst)
+{
+   if (m_numIes >= GTP_MSG_MAX_IE_REFS)
+   {
+      m_numIes = GTP_MSG_MAX_IE_REFS + 1;
+      return FALSE;
+   }
+
+   S32 slot = findSlot(type, inst);
+   if (slot < 0)
+   {
+      GtpIeSlot *pSlot = &m_slots[m_numSlots];
+      pSlot->inst  = inst;
+      pSlot->cnt   = 0;
+      pSlot->first = m_numIes;
+      pSlot->next  = m_typeSlot[type];
+      m_typeSlot[type] = m_numSlots + 1;
+      slot = m_numSlots++;
+   }
+
+   m_slots[slot].cnt++;
+   m_ieSlot[m_numIes++] = slot;
+
+   return TRUE;
+}
+
+VOID GtpIeTable::seal()
+{
+   m_valid  = (m_numIes <= GTP_MSG_MAX_IE_REFS);
+   m_placed = FALSE;
+}
+
+U32 GtpIeTable::count(U8 type, GtpInstance_t inst)
+{
+   S32 slot = findSlot(type, inst);
+
+   return (slot >= 0) ? m_slots[slot].cnt : 0;
+}
+
+/**
+ * @brief
+ *    Returns the position in the message of the nth occurrence of the IE,
+ *    -1 if the IE does not occur n times
+ */
+S32 GtpIeTable::find(U8 type, GtpInstance_t inst, U32 occr)
+{
+   S32 slot = findSlot(type, inst);
+   if ((slot < 0) || (occr < 1) || (occr > m_slots[slot].cnt))
+   {
+      return -1;
+   }
+
+   if (1 == occr)
+   {
+      return m_slots[slot].first;
+   }
+
+   if (!m_placed)
+   {
+      place();
+   }
+
+   return m_occ[m_slots[slot].start + occr - 1];
+}
+
+/* the slots of an IE type are chained, there are rarely more than two
+ * instances of an IE type in a message
+ */
+S32 GtpIeTable::findSlot(U8 type, GtpInstance_t inst)
+{
+   for (U8 slot = m_typeSlot[type]; slot != 0; slot = m_slots[slot - 1].next)
+   {
+      if (m_slots[slot - 1].inst == inst)
+      {
+         return slot - 1;
+      }
+   }
+
+   return -1;
+}
+
+/**
+ * @brief
+ *    Places the occurrences of each IE next to each other, in message order
+ */
+VOID GtpIeTable::place()
+{
+   U8 fill[GTP_MSG_MAX_IE_REFS];
+   U8 start = 0;
+
+   if (!m_valid)
+   {
+      return;
+   }
+
+   for (U32 i = 0; i < m_numSlots; i++)
+   {
+      m_slots[i].start = start;
+      fill[i] = start;
+      start += m_slots[i].cnt;
+   }
+
+   for (U32 pos = 0; pos < m_numIes; pos++)
+   {
+      m_occ[fill[m_ieSlot[pos]]++] = pos;
+   }
+
+   m_placed = TRUE;
+}
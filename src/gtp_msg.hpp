@@ -20,16 +20,84 @@
 #ifndef _GTP_MSG_HPP_
 #define _GTP_MSG_HPP_
 
+#include <vector>
+
+/* maximum number of top level IEs indexed in a message, the IEs of a
+ * message with more IEs are looked up by a scan of the IE list
+ */
+#define GTP_MSG_MAX_IE_REFS   64
+
+/* Location of a top level IE in the buffer of a received message */
+typedef struct
+{
+   U8             type;
+   GtpInstance_t  inst;
+   GtpLength_t    len;     /* length of the IE value */
+   U16            off;     /* offset of the IE header in the IE buffer */
+} GtpIeRef;
+
+typedef std::vector<GtpIe *>     GtpIeVec;
+
+/* Lookup table from an IE type and instance to the positions of the
+ * occurrences of the IE in the message. The IEs are added in message order
+ * and the table is sealed once all the IEs are added. The first occurrence
+ * of an IE is recorded when it is added, the other occurrences are placed
+ * next to each other on the first lookup of a repeated IE, so that finding
+ * the nth occurrence is a lookup and not a scan of the message. The table
+ * of a scenario message is placed when the message is built, lookups do
+ * not write the table of a message shared by the workers.
+ */
+class GtpIeTable
+{
+   public:
+      GtpIeTable() {clear();}
+
+      VOID              clear();
+      BOOL              add(U8 type, GtpInstance_t inst);
+      VOID              seal();
+      VOID              place();
+      BOOL              valid() {return m_valid;}
+      U32               count(U8 type, GtpInstance_t inst);
+      S32               find(U8 type, GtpInstance_t inst, U32 occr);
+
+   private:
+      typedef struct
+      {
+         U8             inst;
+         U8             cnt;
+         U8             first;      /* position of the first occurrence */
+         U8             start;      /* occurrences in m_occ, once placed */
+         U8             next;       /* 1 + next slot of the IE type */
+      } GtpIeSlot;
+
+      S32               findSlot(U8 type, GtpInstance_t inst);
+
+      BOOL              m_valid;
+      BOOL              m_placed;
+      U32               m_numIes;
+      U32               m_numSlots;
+      U8                m_typeSlot[256];  /* 1 + first slot of the IE type,
+                                           * 0 if the type is not present
+                                           */
+      GtpIeSlot         m_slots[GTP_MSG_MAX_IE_REFS];
+      U8                m_ieSlot[GTP_MSG_MAX_IE_REFS];
+      U8                m_occ[GTP_MSG_MAX_IE_REFS];
+};
+
 class GtpMsg
 {
    public:
       GtpMsg(GtpMsgType_t);
-      GtpMsg(Buffer*);
+      GtpMsg(U8 *pBuf, U32 len);
+      GtpMsg(U8 *pBuf, const GtpMsgDesc *pDesc);
       ~GtpMsg();
 
+      static RETVAL     parse(U8 *pBuf, U32 len, GtpMsgDesc *pDesc);
+
       RETVAL            encode(GtpIeLst *pIeLst);
       RETVAL            encode(U8 *pBuf, U32 *pLen);
       RETVAL            decode();
+      RETVAL            index();
       GtpMsgType_t      type() {return m_msgHdr.msgType;}
       VOID              setMsgHdr(const GtpMsgHdr* pHdr);
       RETVAL            setSenderFteid(GtpTeid_t teid, const IpAddr *pIp);
@@ -37,21 +105,32 @@ class GtpMsg
       U32               getIeCount(GtpIeType_t ieType, GtpInstance_t inst);
       U8*               getIeBufPtr(GtpIeType_t, GtpInstance_t, U32);
       GtpSeqNumber_t    seqNumber() {return m_msgHdr.seqN;}
-      VOID              setImsi(GtpImsiKey*);
+      VOID              setImsi(const GtpImsiKey*);
       GtpTeid_t         getTeid();
       GtpMsgCategory_t  category();
       U32               getBearersToCreate() {return m_bearersToCreate;}
+      RETVAL            getFteidTeid(GtpInstance_t inst, GtpTeid_t *pTeid);
+      U32               getBearerEbis(GtpInstance_t inst, GtpEbi_t *pEbi,\
+                              U32 maxEbi);
 
    private:
       GtpMsgHdr      m_msgHdr;
-      U8             m_gtpMsgBuf[GTP_MSG_BUF_LEN];
-      GtpIeLst       m_ieLst;
+      U8             *m_pIeBuf;  /* IEs of a received message */
+      U32            m_ieBufLen;
+      GtpIeVec       m_ieVec;
+      GtpIeTable     m_ieTbl;
+      BOOL           m_decoded;
+      BOOL           m_indexed;
+      U32            m_numIeRefs;
+      GtpIeRef       m_ieRefs[GTP_MSG_MAX_IE_REFS];
       U8             m_bearersToCreate;
       U8             m_bearersToDelete;
       U8             m_bearersToModify;
       U32            encodeHdr(U8 *pBuf);
       VOID           decodeHdr(U8 *pBuf);
       VOID           updateBearerCount(GtpInstance_t bearerCntxtInst);
+      BOOL           useIndex();
+      const GtpIeRef *findIe(GtpIeType_t, GtpInstance_t, U32);
 };
 
 #endif /* _GTP_MSG_HPP_ */
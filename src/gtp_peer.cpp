@@ -29,8 +29,10 @@ using std::vector;
 #include "gtp_ie.hpp"
 #include "gtp_msg.hpp"
 #include "gtp_peer.hpp"
+#include "thread.hpp"
+#include "worker.hpp"
 
-static PeerDataVec g_peerData;
+static thread_local PeerDataVec g_peerData;
 
 PUBLIC BOOL isOldReq(PeerData *peer, Buffer *gtpMsg)
 {
@@ -110,8 +112,12 @@ PUBLIC GtpSeqNumber_t generateSeqNum(IPEndPoint *ep, GtpMsgCategory_t cat)
 {
    LOG_ENTERFN();
 
+   /* every worker keeps its own peer table, the sequence numbers of the
+    * workers are interleaved so that they do not collide at the peer
+    */
    PeerData *peer = findPeer(ep);
-   GtpSeqNumber_t seqNumber = ++(peer->seqNumber);
+   GtpSeqNumber_t seqNumber = ++(peer->seqNumber) * Worker::numWorkers() +
+      Worker::selfId();
    if (GTP_MSG_CAT_CMD == cat)
       GTP_SET_SEQN_MSB(seqNumber);
 
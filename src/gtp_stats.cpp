@@ -39,6 +39,8 @@ using namespace pugi;
 #include "task.hpp"
 #include "scenario.hpp"
 #include "gtp_stats.hpp"
+#include "thread.hpp"
+#include "worker.hpp"
 
 #define PRINT_DOUBLE_LINE(_out) \
 do \
@@ -61,9 +63,10 @@ do \
       fprintf(_out, "  <---  ");\
 } while (0)
 
-// GTP Statistics counters
-static Counter  s_gsimStats[GSIM_STAT_MAX];
-static Stats   *s_pStats = NULL;
+// GTP Statistics counters, every worker thread updates its own counters
+static thread_local Counter  s_gsimStats[GSIM_STAT_MAX];
+static Counter              *s_workerStats[GSIM_MAX_PRODUCERS];
+static Stats                *s_pStats = NULL;
 
 /**
  * Constructor
@@ -121,6 +124,41 @@ Counter Stats::getStats(GtpStat_t  statsType)
    return s_gsimStats[statsType];
 }
 
+Counter Stats::getTotalStats(GtpStat_t  statsType)
+{
+   Counter total = 0;
+
+   for (U32 i = 0; i < GSIM_MAX_PRODUCERS; i++)
+   {
+      if (NULL != s_workerStats[i])
+      {
+         total += s_workerStats[i][statsType];
+      }
+   }
+
+   return total;
+}
+
+Counter Stats::getMaxStats(GtpStat_t  statsType)
+{
+   Counter maxVal = 0;
+
+   for (U32 i = 0; i < GSIM_MAX_PRODUCERS; i++)
+   {
+      if (NULL != s_workerStats[i])
+      {
+         maxVal = GSIM_MAX(maxVal, s_workerStats[i][statsType]);
+      }
+   }
+
+   return maxVal;
+}
+
+VOID Stats::attachWorker(U32 workerId)
+{
+   s_workerStats[workerId] = s_gsimStats;
+}
+
 /**
  * @brief
  *    Increments GTP statistics
@@ -141,5 +179,23 @@ VOID Stats::decStats(GtpStat_t statsType)
    --s_gsimStats[statsType];
 }
 
+VOID Stats::addStats(GtpStat_t statsType, Counter value)
+{
+   s_gsimStats[statsType] += value;
+}
+
+VOID Stats::setStats(GtpStat_t statsType, Counter value)
+{
+   s_gsimStats[statsType] = value;
+}
+
+VOID Stats::maxStats(GtpStat_t statsType, Counter value)
+{
+   if (value > s_gsimStats[statsType])
+   {
+      s_gsimStats[statsType] = value;
+   }
+}
+
 
 
@@ -35,6 +35,26 @@ typedef enum
    GSIM_STAT_NUM_SESSIONS_FAIL,
    GSIM_STAT_UNEXCEPTED_MSG_RECD,
    GSIM_STAT_NUM_DEADCALLS,
+   GSIM_STAT_OFFERED_RATE,       /* target session rate, sessions/s */
+   GSIM_STAT_NUM_PENDING_REQS,   /* requests waiting for a response */
+   GSIM_STAT_NUM_RSPS_RCVD,      /* responses received to the requests */
+   GSIM_STAT_NUM_REQ_TIMEOUTS,   /* T3 expiries of the requests */
+   GSIM_STAT_CONC_WINDOW,        /* limit of the pending requests */
+
+   GSIM_STAT_TRANSPORT_COUNTERS,
+   GSIM_STAT_NUM_RECV_BATCHES,   /* recvmmsg() calls returning messages */
+   GSIM_STAT_NUM_RECV_MSGS,      /* GTP-C messages read by those calls */
+   GSIM_STAT_NUM_SEND_BATCHES,   /* sendmmsg() calls writing messages */
+   GSIM_STAT_NUM_SEND_MSGS,      /* GTP-C messages written by those calls */
+   GSIM_STAT_NUM_SEND_BLOCKED,   /* flushes stopped by a full socket buffer */
+   GSIM_STAT_NUM_SEND_DROPS,     /* messages dropped, transmit queue full */
+   GSIM_STAT_NUM_FWD_MSGS,       /* messages handed over to owning worker */
+   GSIM_STAT_NUM_HANDOFF_DROPS,  /* messages dropped, owner inbox ring full */
+   GSIM_STAT_NUM_IMSI_LOOKUPS,   /* UE session lookups by IMSI */
+   GSIM_STAT_NUM_IMSI_PROBES,    /* IMSI table slots probed by the lookups */
+   GSIM_STAT_MAX_IMSI_PROBES,    /* longest IMSI table probe sequence */
+   GSIM_STAT_NUM_STALE_TEIDS,    /* messages with TEID of deleted tunnel */
+   GSIM_STAT_NUM_INVALID_MSGS,   /* messages dropped, malformed header */
 
    GSIM_STAT_MAX
 } GtpStat_t;
@@ -51,12 +71,39 @@ class Stats
 
    void static incStats(GtpStat_t   statType);
    void static decStats(GtpStat_t   statType);
+   void static addStats(GtpStat_t   statType, Counter value);
+
+   /**
+    * Raises a high water mark statistics counter to value
+    */
+   void static maxStats(GtpStat_t   statType, Counter value);
+
+   /**
+    * Sets a gauge statistics counter to value
+    */
+   void static setStats(GtpStat_t   statType, Counter value);
 
    /**
     * Get the GTP statistics counter values
     */
    Counter static getStats(GtpStat_t statType);
 
+   /**
+    * Get the GTP statistics counter values summed up for all the workers
+    */
+   Counter static getTotalStats(GtpStat_t statType);
+
+   /**
+    * Get the highest value of a high water mark counter among the workers
+    */
+   Counter static getMaxStats(GtpStat_t statType);
+
+   /**
+    * Registers the statistics counters of the calling worker thread, or of
+    * the receive thread with GSIM_RX_PRODUCER_ID
+    */
+   VOID static attachWorker(U32 workerId);
+
    /**
     * Destructor
     */
@@ -0,0 +1,261 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+using std::list;
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_types.hpp"
+#include "gtp_macro.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "gtp_util.hpp"
+#include "gtp_tmpl.hpp"
+
+/* offset of the TEID in the message header, after the flags, message type
+ * and length
+ */
+#define GTP_MSG_HDR_TEID_OFFSET  (1 + GTPC_MSG_TYPE_LEN + GTPC_MSG_LENGTH_LEN)
+
+/* offsets of the length in the message header and in the IE header */
+#define GTP_MSG_HDR_LEN_OFFSET   (1 + GTPC_MSG_TYPE_LEN)
+#define GTP_IE_HDR_LEN_OFFSET    1
+
+/* offsets of the TEID and the IPv4 address in the F-TEID IE value */
+#define GTP_FTEID_TEID_OFFSET    1
+#define GTP_FTEID_IPV4_OFFSET    5
+
+GtpMsgTmpl::GtpMsgTmpl()
+{
+   MEMSET(m_buf, 0, GTP_MSG_BUF_LEN);
+   m_len            = 0;
+   m_teidOff        = 0;
+   m_seqOff         = 0;
+   m_imsiOff        = 0;
+   m_imsiLen        = 0;
+   m_senderFteidOff = 0;
+   m_senderFteidLen = 0;
+   m_numBearers     = 0;
+}
+
+/**
+ * @brief
+ *    Encodes a scenario message into a wire template, and records the
+ *    offsets of the fields patched for every session. The fields are the
+ *    first IMSI and F-TEID IE of instance 0, and the first F-TEID of
+ *    instance 0 in each bearer context of instance 0.
+ *
+ * @param pGtpMsg
+ *
+ * @return
+ *    NULL if the encoded message is malformed
+ */
+GtpMsgTmpl *GtpMsgTmpl::compile(GtpMsg *pGtpMsg)
+{
+   LOG_ENTERFN();
+
+   GtpMsgTmpl  *pTmpl = new GtpMsgTmpl;
+   U8          *pBuf = pTmpl->m_buf;
+   U32         off = GTP_MSG_HDR_TEID_OFFSET;
+   U32         bearerCnt = 0;
+
+   pGtpMsg->encode(pBuf, &pTmpl->m_len);
+
+   if (GTP_CHK_T_BIT_PRESENT(pBuf))
+   {
+      pTmpl->m_teidOff = off;
+      off += GTP_TEID_LEN;
+   }
+
+   pTmpl->m_seqOff = off;
+   off += GTPC_HDR_SEQN_LEN + GTPC_HDR_SPARE_LEN;
+
+   while (off < pTmpl->m_len)
+   {
+      GtpIeHdr ieHdr;
+      decIeHdr(pBuf + off, &ieHdr);
+
+      U32 valOff = off + GTP_IE_HDR_LEN;
+      if (valOff + ieHdr.len > pTmpl->m_len)
+      {
+         LOG_ERROR("Invalid IE length, IE [%d]", ieHdr.ieType);
+         delete pTmpl;
+         LOG_EXITFN(NULL);
+      }
+
+      if ((GTP_IE_IMSI == ieHdr.ieType) && (0 == ieHdr.instance) &&
+          (0 == pTmpl->m_imsiOff))
+      {
+         pTmpl->m_imsiOff = valOff;
+         pTmpl->m_imsiLen = ieHdr.len;
+      }
+      else if ((GTP_IE_FTEID == ieHdr.ieType) && (0 == ieHdr.instance) &&
+          (0 == pTmpl->m_senderFteidOff))
+      {
+         pTmpl->m_senderFteidOff = valOff;
+         pTmpl->m_senderFteidLen = ieHdr.len;
+      }
+      else if ((GTP_IE_BEARER_CNTXT == ieHdr.ieType) && (0 == ieHdr.instance))
+      {
+         GtpBearerContext *pBearerCntxt = gtpIeCast<GtpBearerContext>\
+               (pGtpMsg->getIe(GTP_IE_BEARER_CNTXT, 0, ++bearerCnt));
+         U32 bearerIndx = GTP_BEARER_INDEX(pBearerCntxt->getEbi());
+
+         /* first F-TEID of instance 0 in the bearer context, an F-TEID too
+          * short to hold a TEID is sent as is
+          */
+         U32 grpOff = valOff;
+         while ((grpOff < valOff + ieHdr.len) &&
+                (bearerIndx < GTP_MAX_BEARERS))
+         {
+            GtpIeHdr grpIeHdr;
+            decIeHdr(pBuf + grpOff, &grpIeHdr);
+            if ((GTP_IE_FTEID == grpIeHdr.ieType) && (0 == grpIeHdr.instance))
+            {
+               if ((grpIeHdr.len >= GTP_FTEID_TEID_OFFSET + GTP_TEID_LEN) &&
+                   (pTmpl->m_numBearers < GTP_MAX_BEARERS))
+               {
+                  GtpBearerPatch *pBearer =
+                        &pTmpl->m_bearers[pTmpl->m_numBearers++];
+                  pBearer->teidOff    = grpOff + GTP_IE_HDR_LEN +\
+                                        GTP_FTEID_TEID_OFFSET;
+                  pBearer->bearerIndx = bearerIndx;
+               }
+
+               break;
+            }
+
+            grpOff += GTP_IE_HDR_LEN + grpIeHdr.len;
+         }
+      }
+
+      off = valOff + ieHdr.len;
+   }
+
+   LOG_DEBUG("Wire template [%s], length [%d], bearers [%d]",\
+         gtpGetMsgName(pGtpMsg->type()), pTmpl->m_len, pTmpl->m_numBearers);
+   LOG_EXITFN(pTmpl);
+}
+
+/**
+ * @brief
+ *    Encodes a message from the template. An IMSI of a length other than
+ *    the IMSI of the scenario is spliced in, and the fields after it are
+ *    moved by the difference.
+ *
+ * @param pPatch
+ *    per session values of the message
+ * @param pBuf
+ *    buffer allocated for the encoded message
+ *
+ * @return
+ *    ERR_IE_NOT_FOUND if the sender F-TEID is to be set and the message
+ *    does not have one
+ */
+RETVAL GtpMsgTmpl::encode(const GtpMsgPatch *pPatch, Buffer *pBuf) const
+{
+   LOG_ENTERFN();
+
+   U8  *pDst = NULL;
+   S32 delta = 0;
+
+   if ((NULL != pPatch->pSenderIp) && (0 == m_senderFteidOff))
+   {
+      LOG_ERROR("Sender F-TEID missing");
+      LOG_EXITFN(ERR_IE_NOT_FOUND);
+   }
+
+   const GtpImsiKey *pImsi = pPatch->pImsi;
+   if ((NULL != pImsi) && (0 != m_imsiOff))
+   {
+      delta = (S32)pImsi->len - (S32)m_imsiLen;
+   }
+   else
+   {
+      pImsi = NULL;
+   }
+
+   pBuf->len = m_len + delta;
+   pBuf->pVal = new U8[pBuf->len];
+   if (0 == delta)
+   {
+      MEMCPY(pBuf->pVal, m_buf, m_len);
+   }
+   else
+   {
+      U32 tailOff = m_imsiOff + m_imsiLen;
+      MEMCPY(pBuf->pVal, m_buf, m_imsiOff);
+      MEMCPY(pBuf->pVal + m_imsiOff + pImsi->len, m_buf + tailOff,
+            m_len - tailOff);
+
+      pDst = pBuf->pVal + m_imsiOff - GTP_IE_HDR_LEN + GTP_IE_HDR_LEN_OFFSET;
+      GTP_ENC_IE_LENGTH(pDst, pImsi->len);
+      pDst = pBuf->pVal + GTP_MSG_HDR_LEN_OFFSET;
+      GTP_ENC_IE_LENGTH(pDst, pBuf->len - GTPC_HDR_MAND_LEN);
+   }
+
+   if (0 != m_teidOff)
+   {
+      pDst = pBuf->pVal + m_teidOff;
+      GTP_ENC_TEID(pDst, pPatch->teid);
+   }
+
+   pDst = pBuf->pVal + m_seqOff;
+   GTP_ENC_SEQN(pDst, pPatch->seqN);
+
+   if (NULL != pImsi)
+   {
+      MEMCPY(pBuf->pVal + m_imsiOff, pImsi->val, pImsi->len);
+   }
+
+   /* the TEID and the IPv4 address are set as far as the F-TEID holds them
+    */
+   if (NULL != pPatch->pSenderIp)
+   {
+      U32 fteidOff = shiftOff(m_senderFteidOff, delta);
+      if (m_senderFteidLen >= GTP_FTEID_TEID_OFFSET + GTP_TEID_LEN)
+      {
+         pDst = pBuf->pVal + fteidOff + GTP_FTEID_TEID_OFFSET;
+         GTP_ENC_TEID(pDst, pPatch->senderTeid);
+      }
+
+      if (m_senderFteidLen >= GTP_FTEID_IPV4_OFFSET + IPV4_ADDR_MAX_LEN)
+      {
+         pDst = pBuf->pVal + fteidOff + GTP_FTEID_IPV4_OFFSET;
+         GTP_ENC_IPV4_ADDR(pDst, pPatch->pSenderIp->u.ipv4Addr.addr);
+      }
+   }
+
+   for (U32 i = 0; i < m_numBearers; i++)
+   {
+      pDst = pBuf->pVal + shiftOff(m_bearers[i].teidOff, delta);
+      GTP_ENC_TEID(pDst, pPatch->bearerTeid[m_bearers[i].bearerIndx]);
+   }
+
+   LOG_EXITFN(ROK);
+}
+
+/* offset of a field in the encoded message, the fields after the IMSI are
+ * moved when the IMSI length differs from the template
+ */
+U32 GtpMsgTmpl::shiftOff(U32 off, S32 delta) const
+{
+   return (off > m_imsiOff) ? (U32)((S32)off + delta) : off;
+}
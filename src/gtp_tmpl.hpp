@@ -0,0 +1,76 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GTP_TMPL_HPP_
+#define _GTP_TMPL_HPP_
+
+/* Per session encode context of an outgoing message, the rest of the
+ * message is taken as is from the scenario
+ */
+typedef struct
+{
+   GtpTeid_t         teid;          /* header TEID */
+   GtpSeqNumber_t    seqN;
+   const GtpImsiKey  *pImsi;        /* IMSI of a create session request */
+   GtpTeid_t         senderTeid;    /* sender F-TEID of a create session
+                                     * request or response
+                                     */
+   const IpAddr      *pSenderIp;    /* NULL if the sender F-TEID is not set */
+   GtpTeid_t         bearerTeid[GTP_MAX_BEARERS]; /* GTP-U TEIDs of the
+                                                   * bearer contexts, indexed
+                                                   * by GTP_BEARER_INDEX(ebi)
+                                                   */
+} GtpMsgPatch;
+
+/* Wire template of a message sent by the scenario. The message is encoded
+ * once when the scenario is loaded, and the offsets of the per session
+ * fields are recorded, so that sending a message is a copy of the template
+ * followed by a few stores. The template is not modified after it is
+ * compiled, the scenario is shared read only by all the workers and the
+ * per session values are passed to encode() in a GtpMsgPatch.
+ */
+class GtpMsgTmpl
+{
+   public:
+      static GtpMsgTmpl *compile(GtpMsg *pGtpMsg);
+
+      RETVAL            encode(const GtpMsgPatch *pPatch, Buffer *pBuf) const;
+      U32               len() const {return m_len;}
+
+   private:
+      GtpMsgTmpl();
+
+      U32               shiftOff(U32 off, S32 delta) const;
+
+      typedef struct
+      {
+         U32            teidOff;
+         U32            bearerIndx;
+      } GtpBearerPatch;
+
+      U8                m_buf[GTP_MSG_BUF_LEN];
+      U32               m_len;
+      U32               m_teidOff;        /* offset 0 if not patched */
+      U32               m_seqOff;
+      U32               m_imsiOff;        /* offset of the IMSI value */
+      U32               m_imsiLen;
+      U32               m_senderFteidOff; /* offset of the F-TEID value */
+      U32               m_senderFteidLen;
+      U32               m_numBearers;
+      GtpBearerPatch    m_bearers[GTP_MAX_BEARERS];
+};
+
+#endif
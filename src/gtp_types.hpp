@@ -19,6 +19,7 @@
 #ifndef _GTP_TYPES_HPP
 #define _GTP_TYPES_HPP
 
+#define GTPC_VERSION 2
 #define GTPC_HDR_MAND_LEN 4
 #define GTP_MSG_HDR_LEN 12
 #define GTP_MSG_HDR_LEN_WITHOUT_TEID 8
@@ -310,6 +311,21 @@ struct GtpMsgHdr
     }
 };
 
+/* Header of a received GTP-C message, parsed once when the message is
+ * received and carried with the packet, the session lookup and the decoder
+ * do not parse the header again
+ */
+struct GtpMsgDesc
+{
+    GtpMsgHdr hdr;
+    U16       ieOff;   /* offset of the first IE */
+    U16       ieLen;   /* length of the IEs as per the header length */
+    U16       imsiOff; /* offset of the IMSI value in a create session or
+                        * forward relocation request, 0 if not present
+                        */
+    U16       imsiLen;
+};
+
 typedef struct
 {
 #define GTP_MAX_MCC_DIGITS 3
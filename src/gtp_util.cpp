@@ -987,49 +987,6 @@ U32 encodeImsi(S8 *pImsiStr, U32 imsiStrLen, U8 *pBuf)
 }
 
 
-/**
- * @brief 
- *    returns the pointer to imsi ie in GTP message buffer
- *
- * @return 
- *    returns the pointer to imsi ie in GTP message buffer
- */
-PUBLIC U8* getImsiBufPtr(Buffer *pGtpcBuf)
-{
-   LOG_ENTERFN();
-
-   U8          *pImsi = NULL;
-   GtpIeHdr    ieHdr;
-   GtpLength_t len = pGtpcBuf->len;
-   U8          *pBuf = pGtpcBuf->pVal;
-
-   if (GTP_CHK_T_BIT_PRESENT(pBuf))
-   {
-      len -= GTP_MSG_HDR_LEN;
-      pBuf += GTP_MSG_HDR_LEN;
-   }
-   else
-   {
-      len -= GTP_MSG_HDR_LEN_WITHOUT_TEID;
-      pBuf += GTP_MSG_HDR_LEN_WITHOUT_TEID;
-   }
-
-   while (len)
-   {
-      decIeHdr(pBuf, &ieHdr);
-      if (ieHdr.ieType == GTP_IE_IMSI)
-      {
-         pImsi = pBuf;
-         break;
-      }
-
-      len -= (ieHdr.len + GTP_IE_HDR_LEN);
-      pBuf += (ieHdr.len + GTP_IE_HDR_LEN);
-   }
-
-   LOG_EXITFN(pImsi);
-}
-
 /**
  * @brief encodes PLMN ID into buffer based on encoding PLMN ID encoding
  *        in 23.003
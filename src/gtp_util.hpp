@@ -41,7 +41,6 @@ IpAddr      convIpStrToIpAddr(const S8 *pIp, U32 len);
 VOID        decIeHdr(U8 *pBuf, GtpIeHdr *pHdr);
 U32         encodeImsi(S8 *pImsiStr, U32 imsiStrLen, U8 *pBuf);
 EXTERN VOID numericStrIncriment(S8 *pStr, U32 len);
-PUBLIC U8 *getImsiBufPtr(Buffer *pGtpcBuf);
 EXTERN VOID gtpUtlEncPlmnId(GtpPlmnId_t *pPlmnId, U8 *pBuf);
 PUBLIC S8 *gtpGetIeName(GtpIeType_t ieType);
 PUBLIC U8 gtpCharToHex(U8 c);
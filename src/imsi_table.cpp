@@ -0,0 +1,285 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "imsi_table.hpp"
+
+ImsiTable::ImsiTable()
+{
+    m_slots      = NULL;
+    m_numSlots   = 0;
+    m_mask       = 0;
+    m_numEntries = 0;
+}
+
+ImsiTable::~ImsiTable()
+{
+    delete[] m_slots;
+}
+
+/**
+ * @brief
+ *    Sizes the table for the expected number of UE sessions, so that the
+ *    table is not resized while the traffic is running. Load factor is
+ *    kept below 3/4.
+ *
+ * @param numEntries
+ */
+VOID ImsiTable::reserve(U32 numEntries)
+{
+    U32 numSlots = GSIM_IMSI_TABLE_MIN_SIZE;
+    while ((numSlots < (1U << 31)) &&
+           ((U64)numSlots * 3 < (U64)numEntries * 4))
+    {
+        numSlots <<= 1;
+    }
+
+    if (numSlots > m_numSlots)
+    {
+        resize(numSlots);
+    }
+}
+
+VOID ImsiTable::insert(GtpImsiKey *pImsi, UeSession *pUeSsn)
+{
+    if ((U64)(m_numEntries + 1) * 4 > (U64)m_numSlots * 3)
+    {
+        resize((0 == m_numSlots) ? GSIM_IMSI_TABLE_MIN_SIZE : m_numSlots * 2);
+    }
+
+    U64 key = packImsi(pImsi);
+    U32 len = imsiLen(pImsi);
+    U32 idx = slotIndex(key);
+    while (NULL != m_slots[idx].pUeSsn)
+    {
+        if ((m_slots[idx].key == key) && (m_slots[idx].len == len))
+        {
+            m_slots[idx].pUeSsn = pUeSsn;
+            return;
+        }
+
+        idx = (idx + 1) & m_mask;
+    }
+
+    m_slots[idx].key    = key;
+    m_slots[idx].len    = len;
+    m_slots[idx].pUeSsn = pUeSsn;
+    m_numEntries++;
+}
+
+/**
+ * @brief
+ *    Finds the UE session of an IMSI, number of slots probed by the lookup
+ *    is added to the table statistics
+ *
+ * @param pImsi
+ */
+UeSession *ImsiTable::find(GtpImsiKey *pImsi)
+{
+    if (0 == m_numEntries)
+    {
+        return NULL;
+    }
+
+    U64        key    = packImsi(pImsi);
+    U32        len    = imsiLen(pImsi);
+    U32        idx    = slotIndex(key);
+    U32        probes = 1;
+    UeSession *pUeSsn = NULL;
+
+    while (NULL != m_slots[idx].pUeSsn)
+    {
+        if ((m_slots[idx].key == key) && (m_slots[idx].len == len))
+        {
+            pUeSsn = m_slots[idx].pUeSsn;
+            break;
+        }
+
+        idx = (idx + 1) & m_mask;
+        probes++;
+    }
+
+    Stats::incStats(GSIM_STAT_NUM_IMSI_LOOKUPS);
+    Stats::addStats(GSIM_STAT_NUM_IMSI_PROBES, probes);
+    Stats::maxStats(GSIM_STAT_MAX_IMSI_PROBES, probes);
+
+    return pUeSsn;
+}
+
+/**
+ * @brief
+ *    Deletes an entry, the entries following it in the probe sequence are
+ *    moved back into the hole unless they are already at or after their
+ *    home slot
+ *
+ * @param pImsi
+ */
+VOID ImsiTable::erase(GtpImsiKey *pImsi)
+{
+    if (0 == m_numEntries)
+    {
+        return;
+    }
+
+    U64 key = packImsi(pImsi);
+    U32 len = imsiLen(pImsi);
+    U32 idx = slotIndex(key);
+    while ((m_slots[idx].key != key) || (m_slots[idx].len != len))
+    {
+        if (NULL == m_slots[idx].pUeSsn)
+        {
+            return;
+        }
+
+        idx = (idx + 1) & m_mask;
+    }
+
+    if (NULL == m_slots[idx].pUeSsn)
+    {
+        return;
+    }
+
+    U32 hole = idx;
+    U32 next = (hole + 1) & m_mask;
+    while (NULL != m_slots[next].pUeSsn)
+    {
+        /* an entry can fill the hole only if its home slot is not in the
+         * cyclic range (hole, next]
+         */
+        U32 home = slotIndex(m_slots[next].key);
+        if (((next - home) & m_mask) >= ((next - hole) & m_mask))
+        {
+            m_slots[hole] = m_slots[next];
+            hole          = next;
+        }
+
+        next = (next + 1) & m_mask;
+    }
+
+    m_slots[hole].key    = 0;
+    m_slots[hole].len    = 0;
+    m_slots[hole].pUeSsn = NULL;
+    m_numEntries--;
+}
+
+U32 ImsiTable::size()
+{
+    return m_numEntries;
+}
+
+VOID ImsiTable::getAll(std::vector<UeSession *> *pUeSsnLst)
+{
+    for (U32 i = 0; i < m_numSlots; i++)
+    {
+        if (NULL != m_slots[i].pUeSsn)
+        {
+            pUeSsnLst->push_back(m_slots[i].pUeSsn);
+        }
+    }
+}
+
+/**
+ * @brief
+ *    Packs the BCD encoded IMSI in a 64 bit key, only the bytes within the
+ *    IMSI length are used
+ *
+ * @param pImsi
+ */
+U64 ImsiTable::packImsi(GtpImsiKey *pImsi)
+{
+    U64 key = 0;
+    U32 len = imsiLen(pImsi);
+
+    for (U32 i = 0; i < len; i++)
+    {
+        key = (key << 8) | pImsi->val[i];
+    }
+
+    return key;
+}
+
+/**
+ * @brief
+ *    Length of the BCD encoded IMSI in bytes, the bytes beyond the IMSI
+ *    buffer are not used
+ *
+ * @param pImsi
+ */
+U32 ImsiTable::imsiLen(GtpImsiKey *pImsi)
+{
+    return GSIM_MIN(pImsi->len, GTP_IMSI_MAX_BUF_LEN);
+}
+
+/**
+ * @brief
+ *    Home slot of a key, the IMSIs are mostly sequential and are mixed
+ *    before masking so that they spread over the table
+ *
+ * @param key
+ */
+U32 ImsiTable::slotIndex(U64 key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+
+    return (U32)key & m_mask;
+}
+
+VOID ImsiTable::resize(U32 numSlots)
+{
+    ImsiTableSlot *pOldSlots   = m_slots;
+    U32            oldNumSlots = m_numSlots;
+
+    LOG_DEBUG("Resizing IMSI table, slots [%u]", numSlots);
+
+    m_slots      = new ImsiTableSlot[numSlots];
+    m_numSlots   = numSlots;
+    m_mask       = numSlots - 1;
+    m_numEntries = 0;
+    MEMSET(m_slots, 0, numSlots * sizeof(ImsiTableSlot));
+
+    for (U32 i = 0; i < oldNumSlots; i++)
+    {
+        if (NULL != pOldSlots[i].pUeSsn)
+        {
+            U32 idx = slotIndex(pOldSlots[i].key);
+            while (NULL != m_slots[idx].pUeSsn)
+            {
+                idx = (idx + 1) & m_mask;
+            }
+
+            m_slots[idx] = pOldSlots[i];
+            m_numEntries++;
+        }
+    }
+
+    delete[] pOldSlots;
+}
@@ -0,0 +1,63 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _IMSI_TABLE_HPP_
+#define _IMSI_TABLE_HPP_
+
+#define GSIM_IMSI_TABLE_MIN_SIZE  1024
+
+class UeSession;
+
+/* UE sessions indexed by IMSI. Open addressing hash table with linear
+ * probing, the BCD encoded IMSI (at most 8 bytes) is packed in a 64 bit
+ * key. The packed key of a shorter IMSI can be equal to that of a longer
+ * one, so an entry matches on the key and the IMSI length. An entry is deleted by shifting the following entries of the probe
+ * sequence backwards, so the table does not need tombstones and a lookup
+ * never probes beyond the first empty slot.
+ */
+class ImsiTable
+{
+   public:
+      ImsiTable();
+      ~ImsiTable();
+
+      VOID              reserve(U32 numEntries);
+      VOID              insert(GtpImsiKey *pImsi, UeSession *pUeSsn);
+      UeSession        *find(GtpImsiKey *pImsi);
+      VOID              erase(GtpImsiKey *pImsi);
+      U32               size();
+      VOID              getAll(std::vector<UeSession *> *pUeSsnLst);
+
+   private:
+      typedef struct
+      {
+         U64            key;
+         UeSession     *pUeSsn;  /* NULL for an empty slot */
+         U32            len;     /* length of the IMSI */
+      } ImsiTableSlot;
+
+      static U64        packImsi(GtpImsiKey *pImsi);
+      static U32        imsiLen(GtpImsiKey *pImsi);
+      U32               slotIndex(U64 key);
+      VOID              resize(U32 numSlots);
+
+      ImsiTableSlot    *m_slots;
+      U32               m_numSlots;
+      U32               m_mask;
+      U32               m_numEntries;
+};
+
+#endif
@@ -29,7 +29,7 @@
 EXTERN RETVAL setupStdinSock();
 
 class Keyboard *Keyboard::m_pKb = NULL;
-KeyboardKey_t Keyboard::key = KB_KEY_INVALID;
+std::atomic<KeyboardKey_t> Keyboard::key(KB_KEY_INVALID);
 
 Keyboard* Keyboard::getInstance()
 {
@@ -17,6 +17,8 @@
 #ifndef __KEYBOARD_HPP__
 #define __KEYBOARD_HPP__
 
+#include <atomic>
+
 typedef enum
 {
    KB_KEY_INVALID,
@@ -29,7 +31,7 @@ class Keyboard
 {
    public:
       static Keyboard* getInstance();
-      static KeyboardKey_t key;
+      static std::atomic<KeyboardKey_t> key;
       VOID   processKey(S32 kbInput);
       VOID   init();
       VOID   abort();
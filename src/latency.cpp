@@ -0,0 +1,132 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "types.hpp"
+#include "latency.hpp"
+
+/**
+ * @brief
+ *    Adds the values recorded in another histogram
+ *
+ * @param pHist
+ */
+VOID LatencyHist::add(const LatencyHist *pHist)
+{
+   for (U32 i = 0; i < LAT_HIST_NUM_BUCKETS; i++)
+   {
+      m_buckets[i] += pHist->m_buckets[i];
+   }
+
+   m_count += pHist->m_count;
+   if (pHist->m_max > m_max)
+   {
+      m_max = pHist->m_max;
+   }
+}
+
+/**
+ * @brief
+ *    Removes the values recorded in an earlier copy of the histogram,
+ *    leaving the values recorded since the copy was taken. The maximum of
+ *    the values left is not known, it is the highest value of the highest
+ *    bucket left, limited by the maximum of all the values.
+ *
+ * @param pHist
+ */
+VOID LatencyHist::sub(const LatencyHist *pHist)
+{
+   U64 max = 0;
+   for (U32 i = 0; i < LAT_HIST_NUM_BUCKETS; i++)
+   {
+      m_buckets[i] -= pHist->m_buckets[i];
+      if (0 != m_buckets[i])
+      {
+         max = bucketMax(i);
+      }
+   }
+
+   m_count -= pHist->m_count;
+   m_max = (max < m_max) ? max : m_max;
+}
+
+/**
+ * @brief
+ *    Returns the value at or below which the given percentage of the
+ *    recorded values fall, as the highest value of its bucket
+ *
+ * @param pct
+ *    percentile, 0 to 100
+ *
+ * @return
+ *    0 if no value is recorded
+ */
+U64 LatencyHist::percentile(double pct) const
+{
+   Counter total = 0;
+   for (U32 i = 0; i < LAT_HIST_NUM_BUCKETS; i++)
+   {
+      total += m_buckets[i];
+   }
+
+   if (0 == total)
+   {
+      return 0;
+   }
+
+   /* rank of the value, rounded up and at least the first value */
+   Counter rank = (Counter)((pct * total) / 100.0);
+   if ((double)rank * 100.0 < pct * total)
+   {
+      rank++;
+   }
+
+   if (0 == rank)
+   {
+      rank = 1;
+   }
+
+   Counter seen = 0;
+   for (U32 i = 0; i < LAT_HIST_NUM_BUCKETS; i++)
+   {
+      seen += m_buckets[i];
+      if (seen >= rank)
+      {
+         U64 val = bucketMax(i);
+         return (val > m_max) ? m_max : val;
+      }
+   }
+
+   return m_max;
+}
+
+/**
+ * @brief
+ *    Returns the highest value counted in a bucket
+ *
+ * @param indx
+ */
+U64 LatencyHist::bucketMax(U32 indx)
+{
+   if (indx < LAT_HIST_SUB_COUNT)
+   {
+      return indx;
+   }
+
+   U32 shift = (indx / LAT_HIST_HALF_COUNT) - 1;
+   U64 base  = (indx % LAT_HIST_HALF_COUNT) + LAT_HIST_HALF_COUNT;
+   return ((base + 1) << shift) - 1;
+}
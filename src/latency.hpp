@@ -0,0 +1,91 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _LATENCY_HPP_
+#define _LATENCY_HPP_
+
+#include "types.hpp"
+
+/* values below 2 ^ LAT_HIST_SUB_BITS are counted exactly, above that every
+ * power of two is split into 2 ^ (LAT_HIST_SUB_BITS - 1) buckets, so a value
+ * is within 1/16 of the bucket it falls in
+ */
+#define LAT_HIST_SUB_BITS     5
+#define LAT_HIST_SUB_COUNT    (1 << LAT_HIST_SUB_BITS)
+#define LAT_HIST_HALF_COUNT   (LAT_HIST_SUB_COUNT >> 1)
+#define LAT_HIST_MAX_VAL      0xffffffffUL
+#define LAT_HIST_NUM_BUCKETS  \
+   ((32 - LAT_HIST_SUB_BITS + 1) * LAT_HIST_HALF_COUNT + LAT_HIST_HALF_COUNT)
+
+/* Log linear latency histogram in micro-seconds, in the manner of an HDR
+ * histogram. Recording a value is a count leading zeros, a shift and an
+ * increment, no locks and no allocation. A histogram is updated only by the
+ * worker owning it, the display reads it while it is updated and may see a
+ * value recorded in the count but not yet in the bucket. The histogram has
+ * no constructor, it is zeroed along with the counters it is kept with.
+ */
+class LatencyHist
+{
+   public:
+      VOID reset()
+      {
+         MEMSET(m_buckets, 0, sizeof(m_buckets));
+         m_count = 0;
+         m_max   = 0;
+      }
+
+      inline VOID record(U64 usec)
+      {
+         if (usec > LAT_HIST_MAX_VAL)
+         {
+            usec = LAT_HIST_MAX_VAL;
+         }
+
+         m_buckets[bucket(usec)]++;
+         m_count++;
+         if (usec > m_max)
+         {
+            m_max = usec;
+         }
+      }
+
+      VOID     add(const LatencyHist *pHist);
+      VOID     sub(const LatencyHist *pHist);
+      U64      percentile(double pct) const;
+      Counter  count() const {return m_count;}
+      U64      max() const {return m_max;}
+
+      static inline U32 bucket(U64 val)
+      {
+         if (val < LAT_HIST_SUB_COUNT)
+         {
+            return (U32)val;
+         }
+
+         U32 shift = (63 - __builtin_clzll(val)) - (LAT_HIST_SUB_BITS - 1);
+         return shift * LAT_HIST_HALF_COUNT + (U32)(val >> shift);
+      }
+
+      static U64 bucketMax(U32 indx);
+
+   private:
+      Counter  m_buckets[LAT_HIST_NUM_BUCKETS];
+      Counter  m_count;
+      U64      m_max;
+};
+
+#endif /* _LATENCY_HPP_ */
@@ -19,6 +19,9 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <mutex>
+#include <time.h>
+#include <unistd.h>
 
 #include "types.hpp"
 #include "error.hpp"
@@ -26,6 +29,42 @@
 #include "macros.hpp"
 #include "gtp_types.hpp"
 #include "sim_cfg.hpp"
+#include "thread.hpp"
+#include "spsc_ring.hpp"
+
+#define LOG_RING_SIZE 4096   // records queued per thread, power of two
+#define LOG_MAX_RINGS 64     // threads logging
+#define LOG_IDLE_WAIT 1000   // micro seconds, logger thread with no records
+
+/* log ring of a thread, the records dropped on a full ring are counted by
+ * the thread and reported by the logger thread
+ */
+typedef struct {
+    SpscRing<LogRecord> *pRing;
+    std::atomic<U32>     numDrops;
+    U32                  numDropsLogged;
+} LogRing;
+
+class LogWriter: public CThread
+{
+public:
+    LogWriter() { m_stop = false; }
+    VOID stopWriter();
+
+protected:
+    VOID run(VOID *arg);
+
+private:
+    BOOL             drain();
+    std::atomic<bool> m_stop;
+};
+
+static LogRing               s_logRings[LOG_MAX_RINGS];
+static std::atomic<U32>      s_numLogRings(0);
+static std::mutex            s_logRingLock;
+static std::atomic<U32>      s_numLostRecords(0);
+static thread_local LogRing *s_pLogRing = NULL;
+static LogWriter            *s_pLogWriter = NULL;
 
 LogLevel_t Logger::m_logLevel        = LOG_LVL_ERROR;
 FILE *     Logger::m_logFile         = NULL;
@@ -78,27 +117,390 @@ VOID Logger::init(U32 level)
             m_traceMsgFile = stdout;
         }
     }
+
+    s_pLogWriter = new LogWriter;
+    if (0 != s_pLogWriter->start(NULL))
+    {
+        delete s_pLogWriter;
+        s_pLogWriter = NULL;
+        throw ERR_THREAD_CREATE;
+    }
+}
+
+/**
+ * @brief
+ *    Fills in the header of a log record
+ */
+VOID Logger::initRecord(LogRecord *pRec, LogLevel_t logLvl,
+    const S8 *fileName, U32 lineNum, const S8 *format)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_REALTIME, &now);
+    pRec->time      = (U64)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+    pRec->fileName  = fileName;
+    pRec->format    = format;
+    pRec->lineNum   = lineNum;
+    pRec->level     = logLvl;
+    pRec->truncated = FALSE;
+    pRec->argLen    = 0;
+}
+
+VOID Logger::putArg(LogRecord *pRec, LogArgType_t type, U64 val)
+{
+    if (pRec->truncated || (pRec->argLen + 1 + sizeof(val) > LOG_REC_ARGS_LEN))
+    {
+        pRec->truncated = TRUE;
+        return;
+    }
+
+    pRec->args[pRec->argLen++] = type;
+    MEMCPY(&pRec->args[pRec->argLen], &val, sizeof(val));
+    pRec->argLen += sizeof(val);
+}
+
+/* a string is cut short to the space left in the record */
+VOID Logger::putStr(LogRecord *pRec, const S8 *pStr)
+{
+    if (pRec->truncated || (pRec->argLen + 2 > LOG_REC_ARGS_LEN))
+    {
+        pRec->truncated = TRUE;
+        return;
+    }
+
+    U32 maxLen = LOG_REC_ARGS_LEN - pRec->argLen - 2;
+    maxLen     = (maxLen > 255) ? 255 : maxLen;
+
+    U32 len = 0;
+    if (NULL == pStr)
+    {
+        pStr = "(null)";
+    }
+
+    while ((len < maxLen) && ('\0' != pStr[len]))
+    {
+        len++;
+    }
+
+    pRec->args[pRec->argLen++] = LOG_ARG_STR;
+    pRec->args[pRec->argLen++] = (U8)len;
+    MEMCPY(&pRec->args[pRec->argLen], pStr, len);
+    pRec->argLen += len;
+}
+
+/**
+ * @brief
+ *    Queues a log record on the ring of the calling thread, the ring is
+ *    created by the first log of the thread
+ */
+VOID Logger::postRecord(LogRecord *pRec)
+{
+    LogRing *pLogRing = s_pLogRing;
+    if (NULL == pLogRing)
+    {
+        std::lock_guard<std::mutex> guard(s_logRingLock);
+
+        U32 indx = s_numLogRings.load(std::memory_order_relaxed);
+        if (indx >= LOG_MAX_RINGS)
+        {
+            s_numLostRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        pLogRing        = &s_logRings[indx];
+        pLogRing->pRing = new SpscRing<LogRecord>(LOG_RING_SIZE);
+        pLogRing->numDrops.store(0, std::memory_order_relaxed);
+        pLogRing->numDropsLogged = 0;
+        s_numLogRings.store(indx + 1, std::memory_order_release);
+        s_pLogRing = pLogRing;
+    }
+
+    if (!pLogRing->pRing->push(*pRec))
+    {
+        pLogRing->numDrops.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/* argument of a conversion, or NULL if the arguments are used up */
+PRIVATE const U8 *nextArg(const LogRecord *pRec, U32 *pOff)
+{
+    if (*pOff >= pRec->argLen)
+    {
+        return NULL;
+    }
+
+    const U8 *pArg = &pRec->args[*pOff];
+    if (LOG_ARG_STR == pArg[0])
+    {
+        *pOff += 2 + pArg[1];
+    }
+    else
+    {
+        *pOff += 1 + sizeof(U64);
+    }
+
+    return pArg;
+}
+
+PRIVATE U64 getArgVal(const U8 *pArg)
+{
+    U64 val;
+
+    MEMCPY(&val, pArg + 1, sizeof(val));
+    return val;
+}
+
+/* prints an integer conversion, with the argument converted to the type of
+ * the length modifier
+ */
+PRIVATE S32 fmtInteger(S8 *pBuf, U32 bufLen, const S8 *spec, U32 numLong,
+    U64 val, BOOL isSigned)
+{
+    if (numLong > 1)
+    {
+        return isSigned ? snprintf(pBuf, bufLen, spec, (long long)val)
+                        : snprintf(pBuf, bufLen, spec, (unsigned long long)val);
+    }
+    else if (numLong)
+    {
+        return isSigned ? snprintf(pBuf, bufLen, spec, (long)val)
+                        : snprintf(pBuf, bufLen, spec, (unsigned long)val);
+    }
+
+    return isSigned ? snprintf(pBuf, bufLen, spec, (int)val)
+                    : snprintf(pBuf, bufLen, spec, (unsigned int)val);
+}
+
+/**
+ * @brief
+ *    Formats a log record into a log line. The conversions of the format
+ *    are printed one at a time, with the argument converted to the type the
+ *    conversion expects. A conversion without an argument of a matching
+ *    kind is printed as (?).
+ *
+ * @return
+ *    length of the log line
+ */
+U32 Logger::fmtRecord(const LogRecord *pRec, S8 *pBuf, U32 bufLen)
+{
+    time_t    secs = pRec->time / 1000000;
+    struct tm tm;
+    U32       len  = 0;
+    U32       off  = 0;
+
+    localtime_r(&secs, &tm);
+    len += strftime(pBuf, bufLen, "%H:%M:%S", &tm);
+    len += snprintf(pBuf + len, bufLen - len, ".%06u [%s] %s:%u:",
+        (U32)(pRec->time % 1000000), g_logLvlStr[pRec->level],
+        pRec->fileName, pRec->lineNum);
+
+    const S8 *p = pRec->format;
+    while (('\0' != *p) && (len < bufLen - 1))
+    {
+        if ('%' != *p)
+        {
+            pBuf[len++] = *p++;
+            continue;
+        }
+
+        if ('%' == p[1])
+        {
+            pBuf[len++] = '%';
+            p += 2;
+            continue;
+        }
+
+        /* conversion specification, a * width or precision is replaced by
+         * the value of its argument
+         */
+        S8        spec[32];
+        U32       specLen = 0;
+        U32       numLong = 0;
+        BOOL      valid   = TRUE;
+        const S8 *pArg    = NULL;
+
+        spec[specLen++] = *p++;
+        while (('\0' != *p) && (NULL != strchr("-+ #0123456789.*hlLqjzt", *p)))
+        {
+            if ('*' == *p)
+            {
+                pArg = (const S8 *)nextArg(pRec, &off);
+                S32 val = (NULL != pArg) ? (S32)getArgVal((const U8 *)pArg) : 0;
+                specLen += snprintf(spec + specLen, sizeof(spec) - specLen - 2,
+                    "%d", val);
+            }
+            else if (specLen < sizeof(spec) - 2)
+            {
+                numLong += ('l' == *p) || ('j' == *p) || ('z' == *p) ||
+                           ('t' == *p) || ('q' == *p);
+                spec[specLen++] = *p;
+            }
+            p++;
+        }
+
+        if ('\0' == *p)
+        {
+            break;
+        }
+
+        S8 conv         = *p++;
+        spec[specLen++] = conv;
+        spec[specLen]   = '\0';
+
+        const U8 *pVal = nextArg(pRec, &off);
+        S32       n    = 0;
+        if (NULL == pVal)
+        {
+            valid = FALSE;
+        }
+        else if (NULL != strchr("diuoxXc", conv))
+        {
+            valid = (LOG_ARG_INT == pVal[0]) || (LOG_ARG_UINT == pVal[0]);
+            n     = fmtInteger(pBuf + len, bufLen - len, spec, numLong,
+                getArgVal(pVal), (NULL != strchr("di", conv)));
+        }
+        else if (NULL != strchr("eEfFgGaA", conv))
+        {
+            valid = (LOG_ARG_DOUBLE == pVal[0]);
+            U64    raw = getArgVal(pVal);
+            double val;
+            MEMCPY(&val, &raw, sizeof(val));
+            if (NULL != strchr(spec, 'L'))
+            {
+                n = snprintf(pBuf + len, bufLen - len, spec, (long double)val);
+            }
+            else
+            {
+                n = snprintf(pBuf + len, bufLen - len, spec, val);
+            }
+        }
+        else if ('s' == conv)
+        {
+            valid = (LOG_ARG_STR == pVal[0]);
+            if (valid)
+            {
+                std::string str((const S8 *)pVal + 2, pVal[1]);
+                n = snprintf(pBuf + len, bufLen - len, spec, str.c_str());
+            }
+        }
+        else if ('p' == conv)
+        {
+            valid = (LOG_ARG_STR != pVal[0]);
+            n     = snprintf(pBuf + len, bufLen - len, spec,
+                (VOID *)getArgVal(pVal));
+        }
+        else
+        {
+            valid = FALSE;
+        }
+
+        if (!valid)
+        {
+            n = snprintf(pBuf + len, bufLen - len, "(?)");
+        }
+
+        len += n;
+        if (len >= bufLen - 1)
+        {
+            len = bufLen - 2;
+            break;
+        }
+    }
+
+    if (pRec->truncated && (len + 3 < bufLen - 1))
+    {
+        len += snprintf(pBuf + len, bufLen - len, "...");
+    }
+
+    pBuf[len++] = '\n';
+    return len;
 }
 
 /**
  * @brief
- *    prints debug logs for gtp simulator
+ *    Writes the records of all the log rings to the log file
+ *
+ * @return
+ *    FALSE if there was no record to write
  */
-VOID Logger::log(LogLevel_t logLvl, const S8 *fileName, const U32 lineNum,
-    const S8 *format, ...)
+BOOL LogWriter::drain()
 {
-    S8      logBuf[LOG_BUF_MAX] = {'\0'};
-    va_list args;
+    S8        line[LOG_BUF_MAX + 1];
+    LogRecord rec;
+    BOOL      written  = FALSE;
+    U32       numRings = s_numLogRings.load(std::memory_order_acquire);
+
+    for (U32 i = 0; i < numRings; i++)
+    {
+        LogRing *pLogRing = &s_logRings[i];
+        while (pLogRing->pRing->pop(&rec))
+        {
+            U32 len = Logger::fmtRecord(&rec, line, sizeof(line));
+            fwrite(line, 1, len, Logger::m_logFile);
+            written = TRUE;
+        }
 
-    va_start(args, format);
-    vsprintf(logBuf, format, args);
+        U32 numDrops = pLogRing->numDrops.load(std::memory_order_relaxed);
+        if (numDrops != pLogRing->numDropsLogged)
+        {
+            fprintf(Logger::m_logFile, "[WARN] %u log records dropped, log "
+                "ring of thread %u full\n", numDrops - pLogRing->numDropsLogged,
+                i);
+            pLogRing->numDropsLogged = numDrops;
+            written = TRUE;
+        }
+    }
 
-    fprintf(m_logFile, "[%s] ", g_logLvlStr[logLvl]);
-    fprintf(m_logFile, "%s:%d:", fileName, lineNum);
-    fprintf(m_logFile, "%s\n", logBuf);
-    fflush(m_logFile);
+    return written;
+}
 
-    va_end(args);
+/**
+ * @brief
+ *    Logger thread, writes the records as they are queued and flushes the
+ *    log file once there are no more records
+ */
+VOID LogWriter::run(VOID *arg)
+{
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        if (!drain())
+        {
+            fflush(Logger::m_logFile);
+            usleep(LOG_IDLE_WAIT);
+        }
+    }
+
+    drain();
+    fflush(Logger::m_logFile);
+}
+
+VOID LogWriter::stopWriter()
+{
+    m_stop.store(true, std::memory_order_release);
+    join();
+}
+
+/**
+ * @brief
+ *    Writes the records queued by all the threads and stops the logger
+ *    thread, the records logged after this are not written
+ */
+VOID Logger::stop()
+{
+    if (NULL != s_pLogWriter)
+    {
+        s_pLogWriter->stopWriter();
+        delete s_pLogWriter;
+        s_pLogWriter = NULL;
+    }
+
+    U32 numLost = s_numLostRecords.load(std::memory_order_relaxed);
+    if ((0 != numLost) && (NULL != m_logFile))
+    {
+        fprintf(m_logFile, "[WARN] %u log records lost, too many threads\n",
+            numLost);
+        fflush(m_logFile);
+    }
 }
 
 /**
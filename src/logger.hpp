@@ -16,13 +16,25 @@
 
 /* Logger functions for logging errors, function execution logs
  * hex dumps etc
+ *
+ * A log call does not format the message, it copies the time, the level,
+ * the format string and the arguments into a fixed size binary record, and
+ * queues the record on a lock free ring of the calling thread. The format
+ * string is a string literal, the record keeps only its address. A logger
+ * thread formats the records of all the rings and writes them to the log
+ * file. A log call never blocks, a record is dropped when the ring of the
+ * thread is full and the number of records dropped is logged.
  */
 
 #ifndef _LOGGER_HPP_
 #define _LOGGER_HPP_
 
+#include <type_traits>
+
 #define LOG_LVL_STR_MAX 16
 #define LOG_BUF_MAX 1024
+#define LOG_REC_SIZE 256
+#define LOG_REC_ARGS_LEN (LOG_REC_SIZE - 32)
 
 typedef enum {
     LOG_LVL_START,
@@ -140,6 +152,28 @@ typedef enum {
         }                                                               \
     }
 
+typedef enum {
+    LOG_ARG_INT,
+    LOG_ARG_UINT,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_PTR,
+    LOG_ARG_STR
+} LogArgType_t;
+
+/* Log record, the arguments are a type octet followed by 8 octets of value,
+ * or by a length octet and the characters of a string
+ */
+typedef struct {
+    U64       time; // micro seconds since epoch
+    const S8 *fileName;
+    const S8 *format;
+    U32       lineNum;
+    U8        level;
+    U8        truncated; // arguments did not fit in the record
+    U16       argLen;
+    U8        args[LOG_REC_ARGS_LEN];
+} LogRecord;
+
 class Logger
 {
 public:
@@ -147,10 +181,28 @@ public:
 
     /**
      * Logging function. This function is logger for gtp simulator for
-     * debugging purposes
+     * debugging purposes, the format must be a string literal
+     */
+    template <typename... Args>
+    static VOID log(LogLevel_t logLvl, const S8 *fileName, U32 lineNum,
+        const S8 *format, Args... args)
+    {
+        LogRecord rec;
+
+        fillRecord(&rec, logLvl, fileName, lineNum, format, args...);
+        postRecord(&rec);
+    }
+
+    /**
+     * Copies a log call into a log record
      */
-    static VOID log(LogLevel_t logLvl, const char *fileName,
-        const unsigned lineNum, const char *format, ...);
+    template <typename... Args>
+    static VOID fillRecord(LogRecord *pRec, LogLevel_t logLvl,
+        const S8 *fileName, U32 lineNum, const S8 *format, Args... args)
+    {
+        initRecord(pRec, logLvl, fileName, lineNum, format);
+        packArgs(pRec, args...);
+    }
 
     /**
      * @brief
@@ -181,10 +233,81 @@ public:
 
     static VOID init(U32 level);
 
+    /**
+     * Writes the queued records and stops the logger thread
+     */
+    static VOID stop();
+
+    /**
+     * Formats a log record into a log line, used by the logger thread
+     */
+    static U32 fmtRecord(const LogRecord *pRec, S8 *pBuf, U32 bufLen);
+
     static FILE *m_logFile;
     static FILE *m_traceMsgFile;
     static BOOL  m_traceMsgEnabled;
     static VOID  setLogLevel(LogLevel_t level);
+
+private:
+    static VOID initRecord(LogRecord *pRec, LogLevel_t logLvl,
+        const S8 *fileName, U32 lineNum, const S8 *format);
+    static VOID postRecord(LogRecord *pRec);
+    static VOID putArg(LogRecord *pRec, LogArgType_t type, U64 val);
+    static VOID putStr(LogRecord *pRec, const S8 *pStr);
+
+    static VOID packArgs(LogRecord *) {}
+
+    template <typename T, typename... Args>
+    static VOID packArgs(LogRecord *pRec, T arg, Args... args)
+    {
+        packArg(pRec, arg);
+        packArgs(pRec, args...);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value ||
+                                   std::is_enum<T>::value>::type
+    packArg(LogRecord *pRec, T arg)
+    {
+        if (std::is_signed<T>::value)
+        {
+            putArg(pRec, LOG_ARG_INT, (U64)(long)arg);
+        }
+        else
+        {
+            putArg(pRec, LOG_ARG_UINT, (U64)arg);
+        }
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    packArg(LogRecord *pRec, T arg)
+    {
+        double val = arg;
+        U64    raw;
+
+        MEMCPY(&raw, &val, sizeof(raw));
+        putArg(pRec, LOG_ARG_DOUBLE, raw);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_pointer<T>::value>::type
+    packArg(LogRecord *pRec, T arg)
+    {
+        putArg(pRec, LOG_ARG_PTR, (U64)arg);
+    }
+
+    /* strings are copied, they may not live till the record is written */
+    static VOID packArg(LogRecord *pRec, const S8 *arg) { putStr(pRec, arg); }
+    static VOID packArg(LogRecord *pRec, S8 *arg) { putStr(pRec, arg); }
+    static VOID packArg(LogRecord *pRec, const U8 *arg)
+    {
+        putStr(pRec, (const S8 *)arg);
+    }
+    static VOID packArg(LogRecord *pRec, U8 *arg)
+    {
+        putStr(pRec, (const S8 *)arg);
+    }
 };
 
 #endif
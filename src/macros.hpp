@@ -29,6 +29,9 @@
 #define GSIM_CHAR_TO_DIGIT(_c) (((_c) - '0'))
 #define GSIM_DIGIT_TO_CHAR(_c) (((_c) + '0'))
 
+#define GSIM_MIN(_a, _b)             (((_a) < (_b)) ? (_a) : (_b))
+#define GSIM_MAX(_a, _b)             (((_a) > (_b)) ? (_a) : (_b))
+
 /* Rounds UP to the next integer after divistion */
 #define GSIM_CEIL_DIVISION(_a, _b) (1 + (((_a) - 1) / (_b)))
 
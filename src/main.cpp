@@ -91,6 +91,89 @@ int main(int argc, char **argv)
         options.add_options()
             ("log-level", "Logging level for debugging purposes",
              cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("recv-batch", "Maximum number of GTP-C messages read from a "
+            "socket in one system call, default value is 64",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("send-batch", "Maximum number of GTP-C messages queued on a "
+            "socket and written in one system call, default value is 64",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("io-backend", "Socket event notification mechanism, epoll or "
+            "poll, default value is epoll",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("timer-tick", "Resolution of the task timers in micro seconds, "
+            "10 to 10000, default value is 1000",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("threads", "Number of worker threads, UE sessions are "
+            "distributed among the workers by IMSI, default value is 1",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("pipeline", "Read the GTP-C listener socket on a dedicated "
+            "receive thread, which hands over the messages to the workers");
+        options.add_options()
+            ("ring-size", "Number of messages each worker inbox ring can "
+            "hold, power of two, default value is 4096",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("hugepages", "Allocate the session and tunnel object pools on "
+            "huge pages, falls back to normal pages if none are available");
+        options.add_options()
+            ("stats-file", "Periodically write the session and message "
+            "statistics to this file, for plotting long runs",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("stats-format", "Format of the statistics file, csv or json "
+            "(one JSON object per line), default value is csv",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("stats-interval", "Interval in milli seconds between the "
+            "statistics file samples, default value is 1000",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("stats-file-size", "Size in MB at which the statistics file is "
+            "rotated, default value is 64",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("pcap-file", "Capture all the GTP-C messages sent and received "
+            "to this pcap file, for analysis in Wireshark",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("pcap-file-size", "Size in MB at which the capture file is "
+            "rotated, default value is 0, the file is not rotated",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("failure-log", "Write the last messages of a session to this "
+            "file when a request times out or an unexpected message is "
+            "received",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("pacing", "Spreading of the session starts over the rate "
+            "period, burst (all at the start of the period), uniform or "
+            "poisson, default value is burst",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("pacing-burst", "Maximum number of sessions started back to "
+            "back by the uniform and poisson pacing, default value is 1",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("rate-profile", "File describing the session rate over time "
+            "with ramp, hold, step and sine segments, the session rate and "
+            "rate period are not used and the sessions are paced uniformly "
+            "unless poisson pacing is selected",
+             cxxopts::value<std::string>());
+        options.add_options()
+            ("max-outstanding", "Start a new session only while fewer "
+            "requests than this are waiting for a response, the sessions "
+            "are paced uniformly unless poisson pacing is selected",
+             cxxopts::value<std::uint32_t>());
+        options.add_options()
+            ("aimd", "Tune the maximum outstanding requests to the peer "
+            "capacity, increased with the responses and halved on a "
+            "request timeout");
         options.add_options()
             ("scenario", "Scenario file", cxxopts::value<std::string>());
         options.add_options()
@@ -113,6 +196,7 @@ int main(int argc, char **argv)
         Simulator *pGtpSim = Simulator::getInstance();
         pGtpSim->run();
         LOG_INFO("Stopping simulator");
+        Logger::stop();
 
         std::cout << std::endl;
         std::cout << "Log File: " << pCfg->getLogFile();
@@ -123,11 +207,13 @@ int main(int argc, char **argv)
     }
     catch (ErrCodeEn e)
     {
+        Logger::stop();
         std::cout << "Error: " << e << std::endl;
         exit(e);
     }
     catch (GsimError e)
     {
+        Logger::stop();
         std::cout << e.what() << std::endl;
         exit(1);
     }
@@ -0,0 +1,216 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/mman.h>
+#include <pthread.h>
+#include <errno.h>
+#include <string.h>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "obj_pool.hpp"
+
+/* registry of the pools of all the workers, for the statistics display */
+static std::vector<ObjPoolBase *> s_pools;
+static pthread_mutex_t            s_poolsLock = PTHREAD_MUTEX_INITIALIZER;
+static BOOL                       s_hugePages = FALSE;
+
+ObjPoolBase::ObjPoolBase(const S8 *name, U32 objSize)
+{
+    m_name      = name;
+    m_objSize   = GSIM_MAX(objSize, (U32)sizeof(VOID *));
+    m_objSize   = (m_objSize + GSIM_POOL_OBJ_ALIGN - 1) &
+                  ~(GSIM_POOL_OBJ_ALIGN - 1);
+    m_pFreeList = NULL;
+    m_capacity  = 0;
+    m_inUse     = 0;
+    m_highWater = 0;
+
+    pthread_mutex_lock(&s_poolsLock);
+    s_pools.push_back(this);
+    pthread_mutex_unlock(&s_poolsLock);
+}
+
+ObjPoolBase::~ObjPoolBase()
+{
+    pthread_mutex_lock(&s_poolsLock);
+    for (U32 i = 0; i < s_pools.size(); i++)
+    {
+        if (s_pools[i] == this)
+        {
+            s_pools.erase(s_pools.begin() + i);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_poolsLock);
+
+    for (U32 i = 0; i < m_slabs.size(); i++)
+    {
+        if (m_slabs[i].isHuge)
+        {
+            munmap(m_slabs[i].pMem, m_slabs[i].size);
+        }
+        else
+        {
+            ::operator delete(m_slabs[i].pMem);
+        }
+    }
+}
+
+VOID *ObjPoolBase::alloc()
+{
+    if (NULL == m_pFreeList)
+    {
+        grow(GSIM_MAX(m_capacity, (U32)GSIM_POOL_SLAB_MIN_OBJS));
+    }
+
+    VOID *pObj  = m_pFreeList;
+    m_pFreeList = *(VOID **)pObj;
+
+    m_inUse++;
+    m_highWater = GSIM_MAX(m_highWater, m_inUse);
+
+    return pObj;
+}
+
+VOID ObjPoolBase::free(VOID *pObj)
+{
+    if (NULL == pObj)
+    {
+        return;
+    }
+
+    *(VOID **)pObj = m_pFreeList;
+    m_pFreeList    = pObj;
+    m_inUse--;
+}
+
+/**
+ * @brief
+ *    Grows the pool to hold at least numObjs objects, called before the
+ *    traffic is started so that the pool does not grow while running
+ *
+ * @param numObjs
+ */
+VOID ObjPoolBase::reserve(U32 numObjs)
+{
+    if (numObjs > m_capacity)
+    {
+        grow(numObjs - m_capacity);
+    }
+}
+
+/**
+ * @brief
+ *    Adds a slab of numObjs objects to the pool, a huge page slab is
+ *    rounded up to the huge page size and falls back to the heap if no
+ *    huge page is available
+ *
+ * @param numObjs
+ */
+VOID ObjPoolBase::grow(U32 numObjs)
+{
+    ObjPoolSlab slab;
+    slab.size   = (size_t)numObjs * m_objSize;
+    slab.isHuge = FALSE;
+    slab.pMem   = MAP_FAILED;
+
+    if (s_hugePages)
+    {
+        size_t hugeSize = (slab.size + GSIM_HUGEPAGE_SIZE - 1) &
+                          ~((size_t)GSIM_HUGEPAGE_SIZE - 1);
+        slab.pMem = mmap(NULL, hugeSize, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (MAP_FAILED != slab.pMem)
+        {
+            slab.size   = hugeSize;
+            slab.isHuge = TRUE;
+            numObjs     = hugeSize / m_objSize;
+        }
+        else
+        {
+            LOG_DEBUG("Huge page slab for pool [%s], [%s]", m_name,
+                strerror(errno));
+        }
+    }
+
+    if (!slab.isHuge)
+    {
+        slab.pMem = ::operator new(slab.size);
+    }
+
+    m_slabs.push_back(slab);
+    m_capacity += numObjs;
+
+    /* link the new objects to the free list in the address order */
+    U8 *pObj = (U8 *)slab.pMem + (size_t)(numObjs - 1) * m_objSize;
+    for (U32 i = 0; i < numObjs; i++)
+    {
+        *(VOID **)pObj = m_pFreeList;
+        m_pFreeList    = pObj;
+        pObj -= m_objSize;
+    }
+
+    LOG_DEBUG("Pool [%s] grown to [%u] objects", m_name, m_capacity);
+}
+
+VOID ObjPoolBase::setHugePages(BOOL enable)
+{
+    s_hugePages = enable;
+}
+
+/**
+ * @brief
+ *    Returns the occupancy of the pools, the pools of a type owned by the
+ *    different workers are summed up
+ *
+ * @param pStats
+ */
+VOID ObjPoolBase::getStats(std::vector<ObjPoolStats> *pStats)
+{
+    pthread_mutex_lock(&s_poolsLock);
+    for (U32 i = 0; i < s_pools.size(); i++)
+    {
+        ObjPoolBase *pPool = s_pools[i];
+        U32          j     = 0;
+
+        for (j = 0; j < pStats->size(); j++)
+        {
+            if (0 == STRCMP(pStats->at(j).name, pPool->m_name))
+            {
+                break;
+            }
+        }
+
+        if (j == pStats->size())
+        {
+            ObjPoolStats stats;
+            stats.name      = pPool->m_name;
+            stats.capacity  = 0;
+            stats.inUse     = 0;
+            stats.highWater = 0;
+            pStats->push_back(stats);
+        }
+
+        pStats->at(j).capacity += pPool->m_capacity;
+        pStats->at(j).inUse += pPool->m_inUse;
+        pStats->at(j).highWater += pPool->m_highWater;
+    }
+    pthread_mutex_unlock(&s_poolsLock);
+}
@@ -0,0 +1,172 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _OBJ_POOL_HPP_
+#define _OBJ_POOL_HPP_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "types.hpp"
+
+#define GSIM_POOL_SLAB_MIN_OBJS  1024
+#define GSIM_POOL_OBJ_ALIGN      16
+#define GSIM_HUGEPAGE_SIZE       (2 * 1024 * 1024)
+
+/* occupancy of the pools of a type, summed up for all the workers */
+typedef struct
+{
+   const S8   *name;
+   U32         capacity;
+   U32         inUse;
+   U32         highWater;
+} ObjPoolStats;
+
+/* Fixed size object pool. Objects are carved out of slabs, optionally
+ * backed by huge pages, and a freed object is put on a free list linked
+ * through the object itself. Slabs are returned only when the pool is
+ * destroyed, so the steady state session churn does not call malloc.
+ *
+ * A pool is used by a single thread, every worker has its own pool for
+ * each of the pooled types. The pools register themselves for the
+ * statistics display.
+ */
+class ObjPoolBase
+{
+   public:
+      ObjPoolBase(const S8 *name, U32 objSize);
+      virtual ~ObjPoolBase();
+
+      VOID             *alloc();
+      VOID              free(VOID *pObj);
+      VOID              reserve(U32 numObjs);
+
+      static VOID       setHugePages(BOOL enable);
+      static VOID       getStats(std::vector<ObjPoolStats> *pStats);
+
+   private:
+      typedef struct
+      {
+         VOID          *pMem;
+         size_t         size;
+         BOOL           isHuge;
+      } ObjPoolSlab;
+
+      VOID              grow(U32 numObjs);
+
+      const S8                 *m_name;
+      U32                       m_objSize;
+      VOID                     *m_pFreeList;
+      std::vector<ObjPoolSlab>  m_slabs;
+      U32                       m_capacity;
+      U32                       m_inUse;
+      U32                       m_highWater;
+};
+
+template <typename T>
+class ObjPool: public ObjPoolBase
+{
+   public:
+      ObjPool(const S8 *name) : ObjPoolBase(name, sizeof(T)) {}
+
+      /* pool of the calling thread */
+      static ObjPool<T> &local(const S8 *name)
+      {
+         static thread_local ObjPool<T> s_pool(name);
+         return s_pool;
+      }
+};
+
+/* Helpers for the class specific operator new and delete of the pooled
+ * classes, an object of a derived class is larger than the pool objects
+ * and is allocated from the heap
+ */
+template <typename T>
+inline VOID *poolAlloc(size_t size, const S8 *name)
+{
+   if (sizeof(T) != size)
+   {
+      return ::operator new(size);
+   }
+
+   return ObjPool<T>::local(name).alloc();
+}
+
+template <typename T>
+inline VOID poolFree(VOID *pObj, size_t size, const S8 *name)
+{
+   if (sizeof(T) != size)
+   {
+      ::operator delete(pObj);
+      return;
+   }
+
+   ObjPool<T>::local(name).free(pObj);
+}
+
+/* Allocator for the standard containers, allocates the container nodes
+ * from the pool of the node type
+ */
+template <typename T>
+class PoolAllocator
+{
+   public:
+      typedef T         value_type;
+
+      PoolAllocator() {}
+      template <typename U> PoolAllocator(const PoolAllocator<U> &) {}
+
+      T *allocate(size_t n)
+      {
+         if (1 != n)
+         {
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+         }
+
+         return static_cast<T *>(ObjPool<T>::local("ListNode").alloc());
+      }
+
+      VOID deallocate(T *p, size_t n)
+      {
+         if (1 != n)
+         {
+            ::operator delete(p);
+            return;
+         }
+
+         ObjPool<T>::local("ListNode").free(p);
+      }
+
+      template <typename U> struct rebind
+      {
+         typedef PoolAllocator<U> other;
+      };
+};
+
+template <typename T, typename U>
+inline bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{
+   return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{
+   return false;
+}
+
+#endif
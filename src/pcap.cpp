@@ -0,0 +1,419 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <string>
+#include <mutex>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_types.hpp"
+#include "sim_cfg.hpp"
+#include "pcap.hpp"
+
+#define PCAP_BUF_SIZE        (1 << 20) // per thread buffer of records
+#define PCAP_FLUSH_INTVL     1         // seconds, oldest record buffered
+#define PCAP_MAGIC_NSEC      0xa1b23c4d
+#define PCAP_VERSION_MAJOR   2
+#define PCAP_VERSION_MINOR   4
+#define PCAP_SNAP_LEN        65535
+#define PCAP_LINKTYPE_RAW    101       // IPv4 or IPv6 packet, no link header
+
+#define PCAP_IPV4_HDR_LEN    20
+#define PCAP_IPV6_HDR_LEN    40
+#define PCAP_UDP_HDR_LEN     8
+#define PCAP_IP_TTL          64
+#define PCAP_IP_PROTO_UDP    17
+
+typedef struct
+{
+    U32 magic;
+    U16 versionMajor;
+    U16 versionMinor;
+    S32 thisZone;
+    U32 sigFigs;
+    U32 snapLen;
+    U32 linkType;
+} PcapFileHdr;
+
+typedef struct
+{
+    U32 tsSec;
+    U32 tsNsec;
+    U32 capLen;
+    U32 origLen;
+} PcapRecHdr;
+
+/* records of the calling thread not yet written to the file */
+typedef struct
+{
+    U8 *   pBuf;
+    U32    len;
+    time_t firstSec;  // time of the first record in the buffer
+} PcapThreadBuf;
+
+static std::mutex  s_pcapLock;  // file descriptor, size and rotation
+static S32         s_pcapFd = -1;
+static std::string s_pcapFileName;
+static U64         s_pcapMaxSize = 0;  // bytes, 0 if the file is not rotated
+static U64         s_pcapSize    = 0;
+
+static thread_local PcapThreadBuf s_pcapBuf = {NULL, 0, 0};
+
+BOOL Pcap::s_isOpen = FALSE;
+
+PRIVATE inline U8 *putU16(U8 *p, U16 val)
+{
+    p[0] = (U8)(val >> 8);
+    p[1] = (U8)val;
+    return p + 2;
+}
+
+PRIVATE inline U8 *putU32(U8 *p, U32 val)
+{
+    p[0] = (U8)(val >> 24);
+    p[1] = (U8)(val >> 16);
+    p[2] = (U8)(val >> 8);
+    p[3] = (U8)val;
+    return p + 4;
+}
+
+PRIVATE U8 *encIpv4Hdr(U8 *p, const IPEndPoint *pSrc, const IPEndPoint *pDst,
+    U32 len)
+{
+    U8 *pHdr = p;
+
+    *p++ = 0x45;  // version 4, header length 5 words
+    *p++ = 0;
+    p    = putU16(p, (U16)(PCAP_IPV4_HDR_LEN + len));
+    p    = putU16(p, 0);
+    p    = putU16(p, 0x4000);  // don't fragment
+    *p++ = PCAP_IP_TTL;
+    *p++ = PCAP_IP_PROTO_UDP;
+    p    = putU16(p, 0);
+    p    = putU32(p, pSrc->ipAddr.u.ipv4Addr.addr);
+    p    = putU32(p, pDst->ipAddr.u.ipv4Addr.addr);
+
+    U32 sum = 0;
+    for (U32 i = 0; i < PCAP_IPV4_HDR_LEN; i += 2)
+    {
+        sum += ((U32)pHdr[i] << 8) | pHdr[i + 1];
+    }
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    putU16(pHdr + 10, (U16)~sum);
+
+    return p;
+}
+
+PRIVATE U8 *encIpv6Hdr(U8 *p, const IPEndPoint *pSrc, const IPEndPoint *pDst,
+    U32 len)
+{
+    p    = putU32(p, 0x60000000);  // version 6, no traffic class and flow
+    p    = putU16(p, (U16)len);
+    *p++ = PCAP_IP_PROTO_UDP;
+    *p++ = PCAP_IP_TTL;
+    MEMCPY(p, pSrc->ipAddr.u.ipv6Addr.addr, IPV6_ADDR_MAX_LEN);
+    p += IPV6_ADDR_MAX_LEN;
+    MEMCPY(p, pDst->ipAddr.u.ipv6Addr.addr, IPV6_ADDR_MAX_LEN);
+    p += IPV6_ADDR_MAX_LEN;
+
+    return p;
+}
+
+/* UDP checksum is not computed, zero is taken as no checksum */
+PRIVATE U8 *encUdpHdr(U8 *p, const IPEndPoint *pSrc, const IPEndPoint *pDst,
+    U32 len)
+{
+    p = putU16(p, pSrc->port);
+    p = putU16(p, pDst->port);
+    p = putU16(p, (U16)(PCAP_UDP_HDR_LEN + len));
+    p = putU16(p, 0);
+
+    return p;
+}
+
+/**
+ * @brief
+ *    Creates the capture file, called before the threads sending and
+ *    receiving messages are started
+ *
+ * @param fileName
+ * @param maxSizeMb
+ *    size at which the file is rotated, 0 if the file is not rotated
+ *
+ * @return
+ *    ERR_PCAP_FILE_OPEN if the file cannot be created
+ */
+RETVAL Pcap::open(const std::string &fileName, U32 maxSizeMb)
+{
+    LOG_ENTERFN();
+
+    std::lock_guard<std::mutex> guard(s_pcapLock);
+
+    s_pcapFileName = fileName;
+    s_pcapMaxSize  = (U64)maxSizeMb * 1024 * 1024;
+    if (ROK != openFile())
+    {
+        LOG_EXITFN(ERR_PCAP_FILE_OPEN);
+    }
+
+    s_isOpen = TRUE;
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Writes the records of the calling thread and closes the file, called
+ *    after the other threads have stopped
+ */
+VOID Pcap::close()
+{
+    flush();
+
+    std::lock_guard<std::mutex> guard(s_pcapLock);
+
+    s_isOpen = FALSE;
+    if (s_pcapFd >= 0)
+    {
+        ::close(s_pcapFd);
+        s_pcapFd = -1;
+    }
+}
+
+/**
+ * @brief
+ *    Writes the records buffered by the calling thread and frees the
+ *    buffer, called by a thread before it exits
+ */
+VOID Pcap::flush()
+{
+    PcapThreadBuf *pTb = &s_pcapBuf;
+
+    if (NULL != pTb->pBuf)
+    {
+        writeBuf(pTb->pBuf, pTb->len);
+        delete[] pTb->pBuf;
+        pTb->pBuf = NULL;
+        pTb->len  = 0;
+    }
+}
+
+/**
+ * @brief
+ *    Writes the records buffered by the calling thread if the first of
+ *    them is a second old, called from the socket poll of the thread so
+ *    that the records of an idle thread are not held till it exits
+ */
+VOID Pcap::flushIfDue()
+{
+    PcapThreadBuf *pTb = &s_pcapBuf;
+
+    if ((0 != pTb->len) && (time(NULL) - pTb->firstSec >= PCAP_FLUSH_INTVL))
+    {
+        writeBuf(pTb->pBuf, pTb->len);
+        pTb->len = 0;
+    }
+}
+
+/**
+ * @brief
+ *    Adds a message to the buffer of the calling thread, as a raw IP packet
+ *    from the source to the destination end point
+ *
+ * @param pSrc
+ * @param pDst
+ * @param pData
+ *    GTP message, UDP payload of the packet
+ * @param len
+ */
+VOID Pcap::capture(const IPEndPoint *pSrc, const IPEndPoint *pDst,
+    const U8 *pData, U32 len)
+{
+    PcapThreadBuf * pTb = &s_pcapBuf;
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    if (NULL == pTb->pBuf)
+    {
+        pTb->pBuf = new U8[PCAP_BUF_SIZE];
+        pTb->len  = 0;
+    }
+
+    BOOL ipv4   = (IP_ADDR_TYPE_V4 == pDst->ipAddr.ipAddrType);
+    U32  hdrLen = (ipv4 ? PCAP_IPV4_HDR_LEN : PCAP_IPV6_HDR_LEN) +
+                 PCAP_UDP_HDR_LEN;
+    U32 capLen = len;
+    if (hdrLen + capLen > PCAP_SNAP_LEN)
+    {
+        capLen = PCAP_SNAP_LEN - hdrLen;
+    }
+
+    U32 recLen = sizeof(PcapRecHdr) + hdrLen + capLen;
+    if (pTb->len + recLen > PCAP_BUF_SIZE)
+    {
+        writeBuf(pTb->pBuf, pTb->len);
+        pTb->len = 0;
+    }
+
+    if (0 == pTb->len)
+    {
+        pTb->firstSec = ts.tv_sec;
+    }
+
+    PcapRecHdr recHdr;
+    recHdr.tsSec   = (U32)ts.tv_sec;
+    recHdr.tsNsec  = (U32)ts.tv_nsec;
+    recHdr.capLen  = hdrLen + capLen;
+    recHdr.origLen = hdrLen + len;
+
+    U8 *p = pTb->pBuf + pTb->len;
+    MEMCPY(p, &recHdr, sizeof(PcapRecHdr));
+    p += sizeof(PcapRecHdr);
+    if (ipv4)
+    {
+        p = encIpv4Hdr(p, pSrc, pDst, PCAP_UDP_HDR_LEN + len);
+    }
+    else
+    {
+        p = encIpv6Hdr(p, pSrc, pDst, PCAP_UDP_HDR_LEN + len);
+    }
+
+    p = encUdpHdr(p, pSrc, pDst, len);
+    MEMCPY(p, pData, capLen);
+    pTb->len += recLen;
+
+    /* a thread sending a few messages has them in the file within a
+     * second or two
+     */
+    if (ts.tv_sec - pTb->firstSec >= PCAP_FLUSH_INTVL)
+    {
+        writeBuf(pTb->pBuf, pTb->len);
+        pTb->len = 0;
+    }
+}
+
+/**
+ * @brief
+ *    Creates the capture file and writes the file header, called with the
+ *    file lock held
+ */
+RETVAL Pcap::openFile()
+{
+    s_pcapFd = ::open(s_pcapFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+        0644);
+    if (s_pcapFd < 0)
+    {
+        LOG_ERROR("Opening capture file [%s], [%s]", s_pcapFileName.c_str(),
+            strerror(errno));
+        return RFAILED;
+    }
+
+    PcapFileHdr fileHdr;
+    fileHdr.magic        = PCAP_MAGIC_NSEC;
+    fileHdr.versionMajor = PCAP_VERSION_MAJOR;
+    fileHdr.versionMinor = PCAP_VERSION_MINOR;
+    fileHdr.thisZone     = 0;
+    fileHdr.sigFigs      = 0;
+    fileHdr.snapLen      = PCAP_SNAP_LEN;
+    fileHdr.linkType     = PCAP_LINKTYPE_RAW;
+
+    s_pcapSize = 0;
+    if (write(s_pcapFd, &fileHdr, sizeof(PcapFileHdr)) > 0)
+    {
+        s_pcapSize = sizeof(PcapFileHdr);
+    }
+
+    return ROK;
+}
+
+/**
+ * @brief
+ *    Moves the capture file to <file>.1, and the earlier rotated files one
+ *    suffix up, the oldest file is removed. Called with the file lock held.
+ */
+VOID Pcap::rotateFile()
+{
+    ::close(s_pcapFd);
+    s_pcapFd = -1;
+
+    for (U32 i = DFLT_PCAP_FILE_ROTATIONS; i > 1; i--)
+    {
+        std::string from = s_pcapFileName + "." + std::to_string(i - 1);
+        std::string to   = s_pcapFileName + "." + std::to_string(i);
+        rename(from.c_str(), to.c_str());
+    }
+
+    rename(s_pcapFileName.c_str(), (s_pcapFileName + ".1").c_str());
+    if (ROK != openFile())
+    {
+        LOG_ERROR("Packet capture stopped");
+    }
+}
+
+/**
+ * @brief
+ *    Writes the records of a thread buffer to the file, the file is rotated
+ *    first if the records take it beyond the configured size
+ */
+VOID Pcap::writeBuf(const U8 *pBuf, U32 len)
+{
+    std::lock_guard<std::mutex> guard(s_pcapLock);
+
+    if ((s_pcapFd < 0) || (0 == len))
+    {
+        return;
+    }
+
+    if ((0 != s_pcapMaxSize) && (s_pcapSize + len > s_pcapMaxSize) &&
+        (s_pcapSize > sizeof(PcapFileHdr)))
+    {
+        rotateFile();
+        if (s_pcapFd < 0)
+        {
+            return;
+        }
+    }
+
+    U32 off = 0;
+    while (off < len)
+    {
+        ssize_t ret = write(s_pcapFd, pBuf + off, len - off);
+        if (ret < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            LOG_ERROR("Writing capture file, [%s]", strerror(errno));
+            break;
+        }
+
+        off += ret;
+    }
+
+    s_pcapSize += off;
+}
@@ -0,0 +1,60 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _PCAP_HPP_
+#define _PCAP_HPP_
+
+#include <string>
+
+/* Captures the GTP-C messages sent and received by the simulator to a pcap
+ * file, which is opened in Wireshark. A message is written as a raw IPv4
+ * or IPv6 packet, with IP and UDP headers made up from the local and the
+ * peer end points of the message.
+ *
+ * Every thread sending or receiving messages copies the records into a
+ * buffer of its own, the buffer is written to the file when it is full, a
+ * second after its first record or when the thread stops, so capturing a
+ * message is a copy and the lock on the file is taken once per buffer. The
+ * buffer of a thread with no new messages is written from its socket poll.
+ * The records of different threads are not in time order in the file. The
+ * file is rotated when it grows beyond the configured size, the previous
+ * files are kept with the suffix .1, .2 and so on.
+ */
+class Pcap
+{
+   public:
+      static RETVAL     open(const std::string &fileName, U32 maxSizeMb);
+      static VOID       close();
+      static VOID       flush();
+      static VOID       flushIfDue();
+      static VOID       capture(const IPEndPoint *pSrc, const IPEndPoint *pDst,
+                              const U8 *pData, U32 len);
+
+      /* checked before capture(), so that the messages are not touched when
+       * the capture is off
+       */
+      static BOOL       isOpen() {return s_isOpen;}
+
+   private:
+      static RETVAL     openFile();
+      static VOID       rotateFile();
+      static VOID       writeBuf(const U8 *pBuf, U32 len);
+
+      static BOOL       s_isOpen;
+};
+
+#endif /* _PCAP_HPP_ */
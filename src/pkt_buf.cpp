@@ -0,0 +1,137 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "obj_pool.hpp"
+#include "gtp_types.hpp"
+#include "pkt_buf.hpp"
+
+/* Packet buffer pool of a thread. The owning thread allocates and frees
+ * through the free list of the object pool, a buffer released by another
+ * thread is pushed to the remote free list and is taken back by the owner
+ * on its next allocation.
+ */
+class PktBufPool: public ObjPoolBase
+{
+   public:
+      PktBufPool() : ObjPoolBase("PktBuf", sizeof(PktBuf))
+      {
+         m_pRemoteFree = NULL;
+      }
+
+      PktBuf *alloc()
+      {
+         if (NULL != m_pRemoteFree.load(std::memory_order_relaxed))
+         {
+            reclaim();
+         }
+
+         return static_cast<PktBuf *>(ObjPoolBase::alloc());
+      }
+
+      VOID free(PktBuf *pPkt)
+      {
+         ObjPoolBase::free(pPkt);
+      }
+
+      VOID freeRemote(PktBuf *pPkt)
+      {
+         PktBuf *pHead = m_pRemoteFree.load(std::memory_order_relaxed);
+         do
+         {
+            pPkt->m_pNext = pHead;
+         } while (!m_pRemoteFree.compare_exchange_weak(pHead, pPkt,
+                     std::memory_order_release, std::memory_order_relaxed));
+      }
+
+   private:
+      /* the whole list is taken at once, so a buffer pushed meanwhile
+       * can not be lost and the list is never popped one by one
+       */
+      VOID reclaim()
+      {
+         PktBuf *pPkt = m_pRemoteFree.exchange(NULL, std::memory_order_acquire);
+         while (NULL != pPkt)
+         {
+            PktBuf *pNext = pPkt->m_pNext;
+            ObjPoolBase::free(pPkt);
+            pPkt = pNext;
+         }
+      }
+
+      std::atomic<PktBuf *>   m_pRemoteFree;
+};
+
+/* The pool of a thread is never deleted, buffers handed over to the
+ * other workers may still be released after the thread has exited
+ */
+static thread_local PktBufPool *s_pPktBufPool = NULL;
+
+/**
+ * @brief
+ *    Allocates a packet buffer from the pool of the calling thread, with a
+ *    single reference
+ */
+PktBuf *PktBuf::alloc()
+{
+    if (NULL == s_pPktBufPool)
+    {
+        s_pPktBufPool = new PktBufPool;
+    }
+
+    PktBuf *pPkt  = s_pPktBufPool->alloc();
+    pPkt->m_pPool = s_pPktBufPool;
+    pPkt->m_refCount.store(1, std::memory_order_relaxed);
+    pPkt->connId  = 0;
+    pPkt->len     = 0;
+
+    return pPkt;
+}
+
+VOID PktBuf::ref()
+{
+    m_refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief
+ *    Drops a reference, the buffer is returned to the pool of the thread
+ *    which allocated it when the last reference is dropped
+ */
+VOID PktBuf::unref()
+{
+    /* the common case of a single owner does not need the atomic update */
+    if ((1 != m_refCount.load(std::memory_order_acquire)) &&
+        (1 != m_refCount.fetch_sub(1, std::memory_order_acq_rel)))
+    {
+        return;
+    }
+
+    if (m_pPool == s_pPktBufPool)
+    {
+        m_pPool->free(this);
+    }
+    else
+    {
+        m_pPool->freeRemote(this);
+    }
+}
@@ -0,0 +1,63 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PKT_BUF_HPP_
+#define _PKT_BUF_HPP_
+
+#include <atomic>
+
+#include "types.hpp"
+
+#define GSIM_PKT_BUF_LEN         2048
+
+class PktBufPool;
+
+/* Received datagram. The socket reads the datagram directly into a packet
+ * buffer taken from the pool of the receiving thread, and the buffer is
+ * passed by pointer through the receive path, the GTP-C message decoder
+ * works as a view over the buffer.
+ *
+ * The buffer is reference counted, it goes back to the pool it was taken
+ * from when the last reference is dropped, which may be on a worker other
+ * than the receiving thread when the message is handed over.
+ */
+class PktBuf
+{
+   public:
+      TransConnId       connId;
+      IPEndPoint        peerEp;
+      U32               len;
+      GtpMsgDesc        desc;    /* header pre-parsed by procGtpcMsg() */
+
+      static PktBuf    *alloc();
+      VOID              ref();
+      VOID              unref();
+
+      U8               *data() {return m_data;}
+      U32               size() {return GSIM_PKT_BUF_LEN;}
+
+   private:
+      friend class PktBufPool;
+
+      PktBuf() {}
+
+      std::atomic<U32>  m_refCount;
+      PktBufPool       *m_pPool;
+      PktBuf           *m_pNext;   /* link in the remote free list */
+      U8                m_data[GSIM_PKT_BUF_LEN];
+};
+
+#endif
@@ -26,32 +26,47 @@
 #include "gtp_if.hpp"
 #include "gtp_ie.hpp"
 #include "gtp_msg.hpp"
+#include "gtp_tmpl.hpp"
+#include "thread.hpp"
+#include "worker.hpp"
 #include "procedure.hpp"
 
+/* job counters, every worker updates its own table indexed by the job id */
+static U32                     s_numJobs = 0;
+static thread_local JobStats  *s_pJobStats = NULL;
+static JobStats               *s_workerJobStats[GSIM_MAX_WORKERS];
+
 Job::Job()
 {
+   init();
    m_type    = JOB_TYPE_INV;
-   m_pGtpMsg = NULL;
 }
 
 Job::Job(GtpMsg *pGtpMsg, JobType_t taskType)
 {
+   init();
    m_type          = taskType;
    m_pGtpMsg       = pGtpMsg;
-   m_numSnd        = 0;
-   m_numRcv        = 0;
-   m_numSndRetrans = 0;
-   m_numRcvRetrans = 0;
-   m_numTimeOut    = 0;
-   m_numUnexp      = 0;
 
    STRCPY(m_msgName, gtpGetMsgName(pGtpMsg->type()));
 }
 
 Job::Job(Time_t wait)
 {
-    m_type = JOB_TYPE_WAIT;
-    m_wait = wait;
+    init();
+    m_type    = JOB_TYPE_WAIT;
+    m_wait    = wait;
+}
+
+/* jobs are created only while the scenario is loaded, before the workers
+ * start
+ */
+VOID Job::init()
+{
+   m_id      = s_numJobs++;
+   m_pGtpMsg = NULL;
+   m_pTmpl   = NULL;
+   m_wait    = 0;
 }
 
 Job::~Job()
@@ -60,6 +75,11 @@ Job::~Job()
    {
       delete m_pGtpMsg;
    }
+
+   if (m_pTmpl)
+   {
+      delete m_pTmpl;
+   }
 }
 
 /**
@@ -74,6 +94,77 @@ GtpMsg* Job::getGtpMsg()
    return m_pGtpMsg;
 }
 
+/**
+ * @brief
+ *    Compiles the wire template of a send job, the message is always sent
+ *    from the template and the GTP message is not modified once the
+ *    scenario is loaded
+ */
+RETVAL Job::compileTmpl()
+{
+   if ((JOB_TYPE_SEND == m_type) && (NULL == m_pTmpl))
+   {
+      m_pTmpl = GtpMsgTmpl::compile(m_pGtpMsg);
+      if (NULL == m_pTmpl)
+      {
+         return RFAILED;
+      }
+   }
+
+   return ROK;
+}
+
+/**
+ * @brief
+ *    Returns the counters of the job of the calling worker
+ */
+JobStats* Job::stats()
+{
+   return &s_pJobStats[m_id];
+}
+
+/**
+ * @brief
+ *    Sums up the counters of the job of all the workers
+ *
+ * @param pTotal
+ */
+VOID Job::getTotalStats(JobStats *pTotal)
+{
+   MEMSET(pTotal, 0, sizeof(JobStats));
+
+   for (U32 i = 0; i < GSIM_MAX_WORKERS; i++)
+   {
+      JobStats *pStats = s_workerJobStats[i];
+      if (NULL == pStats)
+      {
+         continue;
+      }
+
+      pTotal->numSnd        += pStats[m_id].numSnd;
+      pTotal->numRcv        += pStats[m_id].numRcv;
+      pTotal->numSndRetrans += pStats[m_id].numSndRetrans;
+      pTotal->numRcvRetrans += pStats[m_id].numRcvRetrans;
+      pTotal->numTimeOut    += pStats[m_id].numTimeOut;
+      pTotal->numUnexp      += pStats[m_id].numUnexp;
+      pTotal->latency.add(&pStats[m_id].latency);
+   }
+}
+
+/**
+ * @brief
+ *    Creates the job counter table of the calling worker, once the
+ *    scenario is loaded
+ *
+ * @param workerId
+ */
+VOID Job::attachWorker(U32 workerId)
+{
+   s_pJobStats = new JobStats[s_numJobs];
+   MEMSET(s_pJobStats, 0, s_numJobs * sizeof(JobStats));
+   s_workerJobStats[workerId] = s_pJobStats;
+}
+
 BOOL Procedure::addJob(Job *job)
 {
    BOOL fullProc = FALSE;
@@ -17,8 +17,11 @@
 #ifndef _SCENARIO_MSG_HPP_
 #define _SCENARIO_MSG_HPP_
 
+#include "latency.hpp"
+
 class Job;
 class Procedure;
+class GtpMsgTmpl;
 
 typedef std::vector<Job*>        JobSequence;
 typedef JobSequence::iterator    JobSeqItr;
@@ -42,6 +45,22 @@ typedef enum
    PROC_TYPE_REQ_TRIG_REP
 } ProcedureType_t;
 
+/* Message counters of a job. The scenario is shared read only by all the
+ * workers, every worker counts the messages of its own sessions in its own
+ * table of job counters. The latency of a request job is the time from the
+ * first transmission of the request to the reception of its response.
+ */
+typedef struct
+{
+   Counter        numSnd;
+   Counter        numRcv;
+   Counter        numSndRetrans;
+   Counter        numRcvRetrans;
+   Counter        numTimeOut;
+   Counter        numUnexp;
+   LatencyHist    latency;
+} JobStats;
+
 class Job
 {
    public:
@@ -51,19 +70,23 @@ class Job
       Job(Time_t wait);
 
       GtpMsg*        getGtpMsg();
+      GtpMsgTmpl*    getTmpl() { return m_pTmpl; }
+      RETVAL         compileTmpl();
       inline JobType_t type() { return m_type; }
       inline Time_t wait() { return m_wait; }
 
-      Counter        m_numSnd;
-      Counter        m_numRcv;
-      Counter        m_numSndRetrans;
-      Counter        m_numRcvRetrans;
-      Counter        m_numTimeOut;
-      Counter        m_numUnexp;
+      JobStats*      stats();
+      VOID           getTotalStats(JobStats *pTotal);
+      static VOID    attachWorker(U32 workerId);
+
       S8             m_msgName[GTP_MSG_NAME_LEN];
 
    private:
+      VOID           init();
+
+      U32            m_id;       /* index in the job counter tables */
       GtpMsg         *m_pGtpMsg;
+      GtpMsgTmpl     *m_pTmpl;
       JobType_t      m_type;
       Time_t         m_wait;
 };
@@ -0,0 +1,290 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_types.hpp"
+#include "sim_cfg.hpp"
+#include "rate_profile.hpp"
+
+RateProfile *RateProfile::s_pProfile = NULL;
+
+PRIVATE VOID throwProfileError(U32 line, const S8 *pMsg)
+{
+    throw GsimError("Rate profile line " + std::to_string(line) + ": " +
+                    pMsg);
+}
+
+/* session rate, at most the maximum session rate */
+PRIVATE BOOL parseRate(const std::string &tok, double *pRate)
+{
+    S8 *pEnd = NULL;
+
+    *pRate = strtod(tok.c_str(), &pEnd);
+    return ((pEnd != tok.c_str()) && ('\0' == *pEnd) && (*pRate >= 0) &&
+            (*pRate <= DFLT_MAX_SESSION_RATE));
+}
+
+/* time in seconds, or with a ms, s, m or h suffix */
+PRIVATE BOOL parseTime(const std::string &tok, Time_t *pTime)
+{
+    S8    *pEnd = NULL;
+    double val  = strtod(tok.c_str(), &pEnd);
+    double unit = 0;
+
+    if (pEnd == tok.c_str())
+    {
+        return FALSE;
+    }
+
+    std::string suffix(pEnd);
+    if (suffix.empty() || ("s" == suffix))
+    {
+        unit = 1000;
+    }
+    else if ("ms" == suffix)
+    {
+        unit = 1;
+    }
+    else if ("m" == suffix)
+    {
+        unit = 60 * 1000;
+    }
+    else if ("h" == suffix)
+    {
+        unit = 60 * 60 * 1000;
+    }
+
+    *pTime = (Time_t)(val * unit + 0.5);
+    return ((0 != unit) && (val > 0) && (*pTime > 0));
+}
+
+/* increment of a step, a number of sessions per second or a percentage of
+ * the rate of the previous step
+ */
+PRIVATE BOOL parseStep(const std::string &tok, double *pStep, BOOL *pPct)
+{
+    S8 *pEnd = NULL;
+
+    *pStep = strtod(tok.c_str(), &pEnd);
+    if (pEnd == tok.c_str())
+    {
+        return FALSE;
+    }
+
+    *pPct = ('%' == *pEnd);
+    if (*pPct)
+    {
+        pEnd++;
+        *pStep = 1 + *pStep / 100;
+    }
+
+    return (('\0' == *pEnd) && (!*pPct || (*pStep > 0)));
+}
+
+/**
+ * @brief
+ *    Reads a rate profile file, the profile is used by the traffic tasks
+ *    of all the workers
+ *
+ * @param fileName
+ */
+VOID RateProfile::load(const std::string &fileName)
+{
+    LOG_ENTERFN();
+
+    std::ifstream in(fileName.c_str());
+    if (!in.is_open())
+    {
+        throw GsimError("Cannot open rate profile file " + fileName);
+    }
+
+    unload();
+    s_pProfile = parse(in);
+    LOG_INFO("Rate profile [%s], segments [%u], duration [%llu] ms",
+        fileName.c_str(), s_pProfile->numSegments(),
+        (unsigned long long)s_pProfile->duration());
+
+    LOG_EXITVOID();
+}
+
+VOID RateProfile::unload()
+{
+    delete s_pProfile;
+    s_pProfile = NULL;
+}
+
+/**
+ * @brief
+ *    Parses the segments of a rate profile, throws GsimError with the line
+ *    number on a malformed segment
+ *
+ * @param in
+ *
+ * @return
+ *    profile with at least one segment
+ */
+RateProfile *RateProfile::parse(std::istream &in)
+{
+    RateProfile *pProfile = new RateProfile;
+    std::string  line;
+    U32          lineNum = 0;
+
+    while (std::getline(in, line))
+    {
+        lineNum++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream       lineIn(line);
+        std::vector<std::string> toks;
+        std::string              tok;
+        while (lineIn >> tok)
+        {
+            toks.push_back(tok);
+        }
+
+        if (toks.empty())
+        {
+            continue;
+        }
+
+        RateSegment seg;
+        MEMSET(&seg, 0, sizeof(seg));
+        seg.start = pProfile->m_duration;
+
+        BOOL valid = FALSE;
+        if ("ramp" == toks[0])
+        {
+            seg.type = RATE_SEG_RAMP;
+            valid    = (4 == toks.size()) && parseRate(toks[1], &seg.rate) &&
+                    parseRate(toks[2], &seg.endRate) &&
+                    parseTime(toks[3], &seg.duration);
+        }
+        else if (("hold" == toks[0]) || ("plateau" == toks[0]))
+        {
+            seg.type = RATE_SEG_HOLD;
+            valid    = (3 == toks.size()) && parseRate(toks[1], &seg.rate) &&
+                    parseTime(toks[2], &seg.duration);
+        }
+        else if ("step" == toks[0])
+        {
+            seg.type = RATE_SEG_STEP;
+            valid    = (5 == toks.size()) && parseRate(toks[1], &seg.rate) &&
+                    parseStep(toks[2], &seg.step, &seg.stepPct) &&
+                    parseTime(toks[3], &seg.interval) &&
+                    parseTime(toks[4], &seg.duration);
+        }
+        else if ("sine" == toks[0])
+        {
+            seg.type = RATE_SEG_SINE;
+            valid    = (5 == toks.size()) && parseRate(toks[1], &seg.rate) &&
+                    parseRate(toks[2], &seg.amplitude) &&
+                    parseTime(toks[3], &seg.interval) &&
+                    parseTime(toks[4], &seg.duration);
+        }
+        else
+        {
+            delete pProfile;
+            throwProfileError(lineNum, "unknown segment, supported "
+                                       "segments are ramp, hold, step, sine");
+        }
+
+        if (!valid)
+        {
+            delete pProfile;
+            throwProfileError(lineNum, "invalid rate or time");
+        }
+
+        pProfile->m_segs.push_back(seg);
+        pProfile->m_duration += seg.duration;
+    }
+
+    if (pProfile->m_segs.empty())
+    {
+        delete pProfile;
+        throw GsimError("Rate profile has no segments");
+    }
+
+    return pProfile;
+}
+
+/**
+ * @brief
+ *    Target session rate of the profile
+ *
+ * @param elapsed
+ *    milli-seconds since the start of the profile
+ *
+ * @return
+ *    sessions per second, 0 after the end of the profile
+ */
+double RateProfile::rate(Time_t elapsed) const
+{
+    if (elapsed >= m_duration)
+    {
+        return 0;
+    }
+
+    /* last segment starting at or before the elapsed time, a profile has
+     * only a few segments
+     */
+    const RateSegment *pSeg = &m_segs[0];
+    for (U32 i = 1; (i < m_segs.size()) && (m_segs[i].start <= elapsed); i++)
+    {
+        pSeg = &m_segs[i];
+    }
+
+    double t    = (double)(elapsed - pSeg->start);
+    double rate = pSeg->rate;
+    switch (pSeg->type)
+    {
+        case RATE_SEG_RAMP:
+            rate += (pSeg->endRate - pSeg->rate) * t / pSeg->duration;
+            break;
+
+        case RATE_SEG_STEP:
+        {
+            double steps = floor(t / pSeg->interval);
+            if (pSeg->stepPct)
+            {
+                rate *= pow(pSeg->step, steps);
+            }
+            else
+            {
+                rate += pSeg->step * steps;
+            }
+            break;
+        }
+
+        case RATE_SEG_SINE:
+            rate += pSeg->amplitude * sin(2 * M_PI * t / pSeg->interval);
+            break;
+
+        default:
+            break;
+    }
+
+    return GSIM_MIN(GSIM_MAX(rate, 0.0), (double)DFLT_MAX_SESSION_RATE);
+}
@@ -0,0 +1,89 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _RATE_PROFILE_HPP_
+#define _RATE_PROFILE_HPP_
+
+#include <istream>
+#include <string>
+#include <vector>
+
+/* interval at which the traffic task samples the target rate of the
+ * profile, when no session is due earlier
+ */
+#define RATE_PROFILE_EVAL_PERIOD    10    /* milli-seconds */
+
+typedef enum
+{
+   RATE_SEG_RAMP,       /* linear change from the start to the end rate */
+   RATE_SEG_HOLD,       /* constant rate, the plateau after a ramp */
+   RATE_SEG_STEP,       /* rate changed by a fixed step every interval */
+   RATE_SEG_SINE,       /* sine wave around a mean rate */
+   RATE_SEG_MAX
+} RateSegTypeEn;
+
+/* segment of a rate profile, the rates are in sessions per second and the
+ * times in milli-seconds
+ */
+typedef struct
+{
+   RateSegTypeEn  type;
+   Time_t         start;      /* from the start of the profile */
+   Time_t         duration;
+   double         rate;       /* start rate, mean rate of a sine */
+   double         endRate;    /* end rate of a ramp */
+   double         step;       /* increment, factor of a percentage step */
+   BOOL           stepPct;
+   Time_t         interval;   /* step interval, period of a sine */
+   double         amplitude;
+} RateSegment;
+
+/* Load shape of the traffic, a sequence of segments read from a profile
+ * file, one segment per line:
+ *
+ *    ramp  <from> <to> <duration>
+ *    hold  <rate> <duration>
+ *    step  <from> <increment>[%] <interval> <duration>
+ *    sine  <mean> <amplitude> <period> <duration>
+ *
+ * The rates are the sessions per second of all the workers, the times are
+ * seconds or have a ms, s, m or h suffix. A percentage step is compounded.
+ * Text after a '#' is a comment. The profile is loaded once and shared
+ * read only by the traffic tasks of all the workers, the traffic stops
+ * at the end of the last segment.
+ */
+class RateProfile
+{
+   public:
+      static VOID                load(const std::string &fileName);
+      static VOID                unload();
+      static const RateProfile   *get() {return s_pProfile;}
+      static RateProfile         *parse(std::istream &in);
+
+      double                     rate(Time_t elapsed) const;
+      Time_t                     duration() const {return m_duration;}
+      U32                        numSegments() const {return m_segs.size();}
+
+   private:
+      RateProfile() {m_duration = 0;}
+
+      static RateProfile         *s_pProfile;
+
+      std::vector<RateSegment>   m_segs;
+      Time_t                     m_duration;
+};
+
+#endif /* _RATE_PROFILE_HPP_ */
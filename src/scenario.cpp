@@ -34,7 +34,7 @@ using namespace pugi;
 #include "sim_cfg.hpp"
 #include "scenario.hpp"
 
-class Scenario* Scenario::m_pMainScn = NULL;  
+class Scenario* Scenario::m_pMainScn = NULL;
 EXTERN VOID parseXmlScenario(const S8*, JobSequence*) throw (ErrCodeEn);
 
 Scenario* Scenario::getInstance()
@@ -104,6 +104,16 @@ VOID Scenario::init(const S8 *pScnFile) throw (ErrCodeEn)
       m_scnType = SCN_TYPE_WAITING;
    }
 
+   for (JobSeqItr itr = jobSeq.begin(); itr != jobSeq.end(); itr++)
+   {
+      if (ROK != (*itr)->compileTmpl())
+      {
+         LOG_FATAL("Encoding of scenario message [%s] failed",\
+               (*itr)->m_msgName);
+         throw ERR_XML_PROCESSING;
+      }
+   }
+
    createProcedure(&jobSeq);
 }
 
@@ -47,6 +47,9 @@ class Scenario
       Scenario();
       VOID createProcedure(JobSequence *jobSeq);
 
+      /* the scenario is loaded once by the main thread before the workers
+       * start, and is shared read only by all the workers
+       */
       static class Scenario   *m_pMainScn;
       U32            m_lastRunTime;
       U32            m_scnRunIntvl;
@@ -31,17 +31,22 @@
 #include "gtp_if.hpp"
 #include "gtp_ie.hpp"
 #include "gtp_msg.hpp"
+#include "gtp_tmpl.hpp"
 #include "sim_cfg.hpp"
 #include "procedure.hpp"
 #include "gtp_stats.hpp"
 #include "gtp_peer.hpp"
 #include "scenario.hpp"
+#include "obj_pool.hpp"
 #include "tunnel.hpp"
 #include "traffic.hpp"
+#include "imsi_table.hpp"
+#include "flight_rec.hpp"
 #include "session.hpp"
+#include "pkt_buf.hpp"
 
-static UeSessionMap s_ueSessionMap;
-static U32          g_sessionId = 0;
+static thread_local ImsiTable    s_ueSessionTable;
+static thread_local U32          g_sessionId = 0;
 
 /**
  * @brief
@@ -61,7 +66,6 @@ UeSession::UeSession(Scenario *pScn, GtpImsiKey imsi)
     m_peerEp.port   = Config::getInstance()->getRemoteGtpcPort();
     m_bitmask       = 0;
     m_imsiKey       = imsi;
-    m_bearerVec.reserve(GTP_MAX_BEARERS);
     m_currProcItr = m_pScn->getFirstProcedure();
 
     for (U32 i = 0; i < GTP_MAX_BEARERS; i++)
@@ -78,7 +82,13 @@ UeSession::UeSession(Scenario *pScn, GtpImsiKey imsi)
  */
 UeSession::~UeSession()
 {
-    s_ueSessionMap.erase(m_imsiKey);
+    s_ueSessionTable.erase(&m_imsiKey);
+
+    /* request timed out or session aborted while waiting for a response */
+    if (GSIM_CHK_MASK(m_bitmask, GSIM_UE_SSN_WAITING_FOR_RSP))
+    {
+        Stats::decStats(GSIM_STAT_NUM_PENDING_REQS);
+    }
 
     if (NULL != m_currProcCache.sentMsg)
         delete m_currProcCache.sentMsg;
@@ -116,6 +126,16 @@ UeSession::~UeSession()
     LOG_DEBUG("Deleting UE Session [%d]", m_sessionId);
 }
 
+VOID *UeSession::operator new(size_t size)
+{
+    return poolAlloc<UeSession>(size, "UeSession");
+}
+
+VOID UeSession::operator delete(VOID *pObj, size_t size)
+{
+    poolFree<UeSession>(pObj, size, "UeSession");
+}
+
 RETVAL UeSession::run(VOID *arg)
 {
     RETVAL ret = ROK;
@@ -133,7 +153,7 @@ RETVAL UeSession::run(VOID *arg)
         if (NULL != arg)
         {
             LOG_TRACE("Processing Recv() Task");
-            ret = handleRecv((UdpData_t *)arg);
+            ret = handleRecv((PktBuf *)arg);
         }
         else
         {
@@ -166,7 +186,7 @@ RETVAL UeSession::handleSend()
         ret = handleOutReqTimeout();
         if (ERR_MAX_RETRY_EXCEEDED == ret)
         {
-            currProc->m_initial->m_numTimeOut++;
+            currProc->m_initial->stats()->numTimeOut++;
             Stats::incStats(GSIM_STAT_NUM_SESSIONS_FAIL);
             delete m_currProcCache.sentMsg;
             m_currProcCache.sentMsg = NULL;
@@ -245,7 +265,7 @@ RETVAL UeSession::handleOutReqMsg(GtpMsg *gtpMsg)
     m_currProcCache.seqNumber = generateSeqNum(&m_peerEp, GTP_MSG_CAT_REQ);
     m_currProcCache.reqType   = gtpMsg->type();
     UdpData_t *pNwData        = new UdpData_t;
-    encGtpcOutMsg(pPdn, gtpMsg, &pNwData->buf, &m_peerEp);
+    encGtpcOutMsg(pPdn, currProc->m_initial, &pNwData->buf);
 
     /* initial message, send the message over default send socket */
     m_retryCnt      = 0;
@@ -255,9 +275,12 @@ RETVAL UeSession::handleOutReqMsg(GtpMsg *gtpMsg)
     LOG_DEBUG("Sending GTPC Message [%s]", gtpGetMsgName(msgType));
     Buffer *buf = new Buffer(pNwData->buf);
     sendMsg(pNwData->connId, &pNwData->peerEp, buf);
-    currProc->m_initial->m_numSnd++;
-    m_currProcCache.sentMsg = pNwData;
+    recordMsg(MSG_EVENT_SENT, pNwData->buf.pVal, pNwData->buf.len);
+    currProc->m_initial->stats()->numSnd++;
+    m_currProcCache.sentMsg  = pNwData;
+    m_currProcCache.sentTime = getMicroSeconds();
     GSIM_SET_MASK(this->m_bitmask, GSIM_UE_SSN_WAITING_FOR_RSP);
+    Stats::incStats(GSIM_STAT_NUM_PENDING_REQS);
 
     LOG_EXITFN(ret);
 }
@@ -279,8 +302,14 @@ RETVAL UeSession::handleOutReqTimeout()
     /* Recived task is run because GTP-C message request timedout
      * waiting for a response, retransmit the request message
      */
+    Stats::incStats(GSIM_STAT_NUM_REQ_TIMEOUTS);
     if (m_retryCnt >= m_n3req)
     {
+        UdpData_t *pSentMsg = m_currProcCache.sentMsg;
+        recordMsg(MSG_EVENT_TIMEOUT, pSentMsg->buf.pVal, pSentMsg->buf.len);
+        dumpFailure("Request timed out", pSentMsg->buf.pVal,
+            pSentMsg->buf.len);
+
         delete m_currProcCache.sentMsg;
         m_currProcCache.sentMsg = NULL;
         LOG_DEBUG("Maximum Retries reached");
@@ -295,8 +324,10 @@ RETVAL UeSession::handleOutReqTimeout()
         Buffer *buf = new Buffer(m_currProcCache.sentMsg->buf);
         sendMsg(m_currProcCache.sentMsg->connId,
             &m_currProcCache.sentMsg->peerEp, buf);
+        recordMsg(MSG_EVENT_RESENT, m_currProcCache.sentMsg->buf.pVal,
+            m_currProcCache.sentMsg->buf.len);
 
-        currProc->m_initial->m_numSndRetrans++;
+        currProc->m_initial->stats()->numSndRetrans++;
         m_retryCnt++;
 
         // if response is not received within T3 timer expiry
@@ -317,8 +348,7 @@ RETVAL UeSession::handleOutRspMsg(GtpMsg *gtpMsg)
 
     LOG_DEBUG("Encoding OUT Message");
     UdpData_t *pNwData = new UdpData_t;
-    encGtpcOutMsg(
-        pPdn, currProc->m_trigMsg->getGtpMsg(), &pNwData->buf, &m_peerEp);
+    encGtpcOutMsg(pPdn, currProc->m_trigMsg, &pNwData->buf);
 
     /* send the response/triggered message over the same socket
      * over which the request/command is received
@@ -329,7 +359,8 @@ RETVAL UeSession::handleOutRspMsg(GtpMsg *gtpMsg)
     LOG_DEBUG("Sending GTPC Message [%s]", gtpGetMsgName(msgType));
     Buffer *buf = new Buffer(pNwData->buf);
     sendMsg(pNwData->connId, &pNwData->peerEp, buf);
-    currProc->m_trigMsg->m_numSnd++;
+    recordMsg(MSG_EVENT_SENT, pNwData->buf.pVal, pNwData->buf.len);
+    currProc->m_trigMsg->stats()->numSnd++;
 
     delete m_prevProcCache.sentMsg;
     m_prevProcCache.sentMsg = pNwData;
@@ -350,18 +381,21 @@ RETVAL UeSession::handleOutRspMsg(GtpMsg *gtpMsg)
     LOG_EXITFN(ROK);
 }
 
-RETVAL UeSession::handleRecv(UdpData_t *data)
+RETVAL UeSession::handleRecv(PktBuf *data)
 {
     LOG_ENTERFN();
 
     RETVAL ret = ROK;
 
     /* Receive task is run because a GTPC message is received for this
-     * session
+     * session, the message is decoded in place in the packet buffer from
+     * the header pre-parsed on reception
      */
-    GtpMsg           gtpMsg(&data->buf);
+    GtpMsg           gtpMsg(data->data(), &data->desc);
     GtpMsgCategory_t msgCat = gtpMsg.category();
 
+    recordMsg(MSG_EVENT_RCVD, data->data(), data->len);
+
     if (msgCat == GTP_MSG_CAT_REQ)
     {
         LOG_DEBUG("Processing Incoming Request message");
@@ -381,32 +415,36 @@ RETVAL UeSession::handleRecv(UdpData_t *data)
         }
     }
 
-    delete data;
+    data->unref();
     LOG_EXITFN(ret);
 }
 
-RETVAL UeSession::handleIncReqMsg(GtpMsg *rcvdReq, UdpData_t *rcvdData)
+RETVAL UeSession::handleIncReqMsg(GtpMsg *rcvdReq, PktBuf *rcvdData)
 {
     LOG_ENTERFN();
 
-    if (isExpectedReq(rcvdReq))
+    if (isExpectedReq(&rcvdData->desc.hdr))
     {
-        (*m_currProcItr)->m_initial->m_numRcv++;
+        (*m_currProcItr)->m_initial->stats()->numRcv++;
     }
-    else if (isPrevProcReq(rcvdReq))
+    else if (isPrevProcReq(&rcvdData->desc.hdr))
     {
         /* resend the response message */
         Buffer *buf = new Buffer(m_prevProcCache.sentMsg->buf);
         sendMsg(m_prevProcCache.sentMsg->connId,
             &m_prevProcCache.sentMsg->peerEp, buf);
-        (*m_prevProcItr)->m_initial->m_numRcvRetrans++;
-        (*m_prevProcItr)->m_trigMsg->m_numSndRetrans++;
+        recordMsg(MSG_EVENT_RESENT, m_prevProcCache.sentMsg->buf.pVal,
+            m_prevProcCache.sentMsg->buf.len);
+        (*m_prevProcItr)->m_initial->stats()->numRcvRetrans++;
+        (*m_prevProcItr)->m_trigMsg->stats()->numSndRetrans++;
         this->stop();
         LOG_EXITFN(ROK);
     }
     else
     {
-        (*m_currProcItr)->m_initial->m_numUnexp++;
+        (*m_currProcItr)->m_initial->stats()->numUnexp++;
+        dumpFailure("Unexpected request received", rcvdData->data(),
+            rcvdData->len);
         this->stop();
         LOG_EXITFN(ROK);
     }
@@ -434,7 +472,7 @@ RETVAL UeSession::handleIncReqMsg(GtpMsg *rcvdReq, UdpData_t *rcvdData)
     m_prevProcCache.reqType   = m_currProcCache.reqType;
 
     updatePeerSeqNumber(&rcvdData->peerEp, m_currProcCache.seqNumber);
-    decAndStoreGtpcIncMsg(pdn, rcvdReq, &rcvdData->peerEp);
+    decAndStoreGtpcIncMsg(pdn, rcvdReq, rcvdData);
 
     /* run the procedure again to send the response */
     GSIM_SET_MASK(this->m_bitmask, GSIM_UE_SSN_SEND_RSP);
@@ -443,7 +481,7 @@ RETVAL UeSession::handleIncReqMsg(GtpMsg *rcvdReq, UdpData_t *rcvdData)
     LOG_EXITFN(ROK);
 }
 
-BOOL UeSession::isExpectedRsp(GtpMsg *rspMsg)
+BOOL UeSession::isExpectedRsp(const GtpMsgHdr *pRspHdr)
 {
     LOG_ENTERFN();
 
@@ -451,8 +489,8 @@ BOOL UeSession::isExpectedRsp(GtpMsg *rspMsg)
     Procedure *currProc       = *m_currProcItr;
     GtpMsg *   expectedRspMsg = currProc->m_trigMsg->getGtpMsg();
 
-    if ((expectedRspMsg->type() == rspMsg->type()) &&
-        (m_currProcCache.seqNumber == rspMsg->seqNumber()))
+    if ((expectedRspMsg->type() == pRspHdr->msgType) &&
+        (m_currProcCache.seqNumber == pRspHdr->seqN))
     {
         expected = TRUE;
     }
@@ -460,7 +498,7 @@ BOOL UeSession::isExpectedRsp(GtpMsg *rspMsg)
     LOG_EXITFN(expected);
 }
 
-BOOL UeSession::isExpectedReq(GtpMsg *reqMsg)
+BOOL UeSession::isExpectedReq(const GtpMsgHdr *pReqHdr)
 {
     LOG_ENTERFN();
 
@@ -468,8 +506,8 @@ BOOL UeSession::isExpectedReq(GtpMsg *reqMsg)
     Procedure *currProc = *m_currProcItr;
 
     GtpMsg *expectedReqMsg = currProc->m_initial->getGtpMsg();
-    if ((expectedReqMsg->type() == reqMsg->type()) &&
-        (m_currProcCache.seqNumber < reqMsg->seqNumber()))
+    if ((expectedReqMsg->type() == pReqHdr->msgType) &&
+        (m_currProcCache.seqNumber < pReqHdr->seqN))
     {
         expected = TRUE;
     }
@@ -477,15 +515,15 @@ BOOL UeSession::isExpectedReq(GtpMsg *reqMsg)
     LOG_EXITFN(expected);
 }
 
-BOOL UeSession::isPrevProcRsp(GtpMsg *rspMsg)
+BOOL UeSession::isPrevProcRsp(const GtpMsgHdr *pRspHdr)
 {
     LOG_ENTERFN();
 
     BOOL prevProcRsp = FALSE;
 
     if ((GSIM_CHK_MASK(m_bitmask, GSIM_UE_SSN_PREV_PROC_PRES)) &&
-        (m_prevProcCache.rspType == rspMsg->type()) &&
-        (m_prevProcCache.seqNumber == rspMsg->seqNumber()))
+        (m_prevProcCache.rspType == pRspHdr->msgType) &&
+        (m_prevProcCache.seqNumber == pRspHdr->seqN))
     {
         prevProcRsp = TRUE;
     }
@@ -493,15 +531,15 @@ BOOL UeSession::isPrevProcRsp(GtpMsg *rspMsg)
     LOG_EXITFN(prevProcRsp);
 }
 
-BOOL UeSession::isPrevProcReq(GtpMsg *reqMsg)
+BOOL UeSession::isPrevProcReq(const GtpMsgHdr *pReqHdr)
 {
     LOG_ENTERFN();
 
     BOOL prevProcReq = FALSE;
 
     if ((GSIM_CHK_MASK(m_bitmask, GSIM_UE_SSN_PREV_PROC_PRES)) &&
-        (m_prevProcCache.reqType == reqMsg->type()) &&
-        (m_prevProcCache.seqNumber == reqMsg->seqNumber()))
+        (m_prevProcCache.reqType == pReqHdr->msgType) &&
+        (m_prevProcCache.seqNumber == pReqHdr->seqN))
     {
         prevProcReq = TRUE;
     }
@@ -509,17 +547,19 @@ BOOL UeSession::isPrevProcReq(GtpMsg *reqMsg)
     LOG_EXITFN(prevProcReq);
 }
 
-PUBLIC RETVAL UeSession::handleIncRspMsg(GtpMsg *rspMsg, UdpData_t *rcvdData)
+PUBLIC RETVAL UeSession::handleIncRspMsg(GtpMsg *rspMsg, PktBuf *rcvdData)
 {
     LOG_ENTERFN();
 
     Procedure *currProc = *m_currProcItr;
 
-    if (isExpectedRsp(rspMsg))
+    if (isExpectedRsp(&rcvdData->desc.hdr))
     {
         LOG_DEBUG("Expected response message received");
 
-        currProc->m_trigMsg->m_numRcv++;
+        currProc->m_trigMsg->stats()->numRcv++;
+        currProc->m_initial->stats()->latency.record(
+            getMicroSeconds() - m_currProcCache.sentTime);
 
         m_prevProcCache.connId    = rcvdData->connId;
         m_prevProcCache.seqNumber = m_currProcCache.seqNumber;
@@ -528,8 +568,10 @@ PUBLIC RETVAL UeSession::handleIncRspMsg(GtpMsg *rspMsg, UdpData_t *rcvdData)
         GSIM_SET_MASK(this->m_bitmask, GSIM_UE_SSN_PREV_PROC_PRES);
         m_prevProcItr = m_currProcItr;
 
-        decAndStoreGtpcIncMsg(m_pCurrPdn, rspMsg, &rcvdData->peerEp);
+        decAndStoreGtpcIncMsg(m_pCurrPdn, rspMsg, rcvdData);
         GSIM_UNSET_MASK(this->m_bitmask, GSIM_UE_SSN_WAITING_FOR_RSP);
+        Stats::decStats(GSIM_STAT_NUM_PENDING_REQS);
+        Stats::incStats(GSIM_STAT_NUM_RSPS_RCVD);
 
         delete m_currProcCache.sentMsg;
         m_currProcCache.sentMsg = NULL;
@@ -543,17 +585,19 @@ PUBLIC RETVAL UeSession::handleIncRspMsg(GtpMsg *rspMsg, UdpData_t *rcvdData)
             m_currProcItr = m_pScn->getNextProcedure(m_currProcItr);
         }
     }
-    else if (isPrevProcRsp(rspMsg))
+    else if (isPrevProcRsp(&rcvdData->desc.hdr))
     {
         /* may be a retransmitted response for previous procedure */
         LOG_DEBUG("Response Message for previous procedure received");
-        (*m_prevProcItr)->m_trigMsg->m_numRcvRetrans++;
+        (*m_prevProcItr)->m_trigMsg->stats()->numRcvRetrans++;
     }
     else
     {
         /* unexpecte response message received */
         LOG_DEBUG("Unexpected response Message received");
-        currProc->m_trigMsg->m_numUnexp++;
+        currProc->m_trigMsg->stats()->numUnexp++;
+        dumpFailure("Unexpected response received", rcvdData->data(),
+            rcvdData->len);
     }
 
     LOG_EXITFN(ROK);
@@ -587,14 +631,13 @@ RETVAL UeSession::handleWait()
  */
 UeSession *UeSession::createUeSession(GtpImsiKey imsiKey)
 {
-    U8 *pImsi = imsiKey.val;
-
     Scenario * pScn   = Scenario::getInstance();
     UeSession *pUeSsn = new UeSession(pScn, imsiKey);
-    s_ueSessionMap.insert(UeSessionMapPair(imsiKey, pUeSsn));
+    s_ueSessionTable.insert(&imsiKey, pUeSsn);
 
-    LOG_ERROR("Creating UE Session [%x%x%x%x%x%x%x%x]", pImsi[0], pImsi[1],
-        pImsi[2], pImsi[3], pImsi[4], pImsi[5], pImsi[6], pImsi[7]);
+    LOG_DEBUG("Creating UE Session [%x%x%x%x%x%x%x%x]", imsiKey.val[0],
+        imsiKey.val[1], imsiKey.val[2], imsiKey.val[3], imsiKey.val[4],
+        imsiKey.val[5], imsiKey.val[6], imsiKey.val[7]);
 
     return pUeSsn;
 }
@@ -626,13 +669,7 @@ UeSession *UeSession::getUeSession(GtpImsiKey imsiKey)
 {
     LOG_ENTERFN();
 
-    UeSession *pUeSession = NULL;
-
-    UeSessionMapItr itr = s_ueSessionMap.find(imsiKey);
-    if (itr != s_ueSessionMap.end())
-    {
-        pUeSession = itr->second;
-    }
+    UeSession *pUeSession = s_ueSessionTable.find(&imsiKey);
 
     LOG_EXITFN(pUeSession);
 }
@@ -675,18 +712,20 @@ VOID UeSession::createBearers(
 
     if (pGtpMsg->type() == GTPC_MSG_CS_REQ)
     {
-        // U32 bearerCnt = pGtpMsg->getIeCount(GTP_IE_BEARER_CNTXT, instance);
-        U32 bearerCnt = pGtpMsg->getBearersToCreate();
-        for (U32 i = 1; i <= bearerCnt; i++)
+        GtpEbi_t ebi[GTP_MAX_BEARERS];
+        U32 bearerCnt = pGtpMsg->getBearerEbis(instance, ebi, GTP_MAX_BEARERS);
+        for (U32 i = 0; i < bearerCnt; i++)
         {
-            GtpIe *pIe = pGtpMsg->getIe(GTP_IE_BEARER_CNTXT, instance, i);
-            GtpBearerContext *bearerCntxt =
-                dynamic_cast<GtpBearerContext *>(pIe);
-            GtpEbi_t ebi = bearerCntxt->getEbi();
-
-            GtpBearer *pBearer = new GtpBearer(pPdn, ebi);
-            GSIM_SET_BEARER_MASK(pPdn->bearerMask, ebi);
-            m_bearerVec[GTP_BEARER_INDEX(ebi)] = pBearer;
+            U32 bearerIndx = GTP_BEARER_INDEX((U32)ebi[i]);
+            if (bearerIndx >= GTP_MAX_BEARERS)
+            {
+                LOG_ERROR("Invalid EBI [%d]", ebi[i]);
+                continue;
+            }
+
+            GtpBearer *pBearer = new GtpBearer(pPdn, ebi[i]);
+            GSIM_SET_BEARER_MASK(pPdn->bearerMask, ebi[i]);
+            m_bearerVec[bearerIndx] = pBearer;
         }
     }
 
@@ -694,19 +733,25 @@ VOID UeSession::createBearers(
 }
 
 VOID UeSession::decAndStoreGtpcIncMsg(
-    GtpcPdn *pPdn, GtpMsg *pGtpMsg, const IPEndPoint *pPeerEp)
+    GtpcPdn *pPdn, GtpMsg *pGtpMsg, PktBuf *rcvdData)
 {
     LOG_ENTERFN();
 
+    const IPEndPoint *pPeerEp = &rcvdData->peerEp;
+
     try
     {
-        pGtpMsg->decode();
+        /* only the sender F-TEID and the EBIs are read from the message,
+         * the IEs are not decoded
+         */
         GtpMsgType_t rcvdMsgTye = pGtpMsg->type();
         if (rcvdMsgTye == GTPC_MSG_CS_REQ || rcvdMsgTye == GTPC_MSG_CS_RSP)
         {
-            GtpFteid *pFteid =
-                dynamic_cast<GtpFteid *>(pGtpMsg->getIe(GTP_IE_FTEID, 0, 1));
-            pPdn->pCTun->m_remTeid = pFteid->getTeid();
+            RETVAL ret = pGtpMsg->getFteidTeid(0, &pPdn->pCTun->m_remTeid);
+            if (ROK != ret)
+            {
+                LOG_ERROR("Sender F-TEID missing, Error [%d]", ret);
+            }
         }
 
         pPdn->pCTun->m_peerEp.ipAddr.ipAddrType = IP_ADDR_TYPE_V4;
@@ -721,65 +766,59 @@ VOID UeSession::decAndStoreGtpcIncMsg(
     catch (ErrCodeEn &e)
     {
         LOG_ERROR("Decoding of GTP message failed, Error Code [%d]", e);
+        dumpFailure("Decoding of received message failed", rcvdData->data(),
+            rcvdData->len);
     }
 
     LOG_EXITVOID();
 }
 
-VOID UeSession::encGtpcOutMsg(
-    GtpcPdn *pPdn, GtpMsg *pGtpMsg, Buffer *pGtpBuf, IPEndPoint *peerEp)
+/**
+ * @brief Encodes an outgoing message of the session from the wire template
+ *    of the job, the session values are passed in an encode context and
+ *    the scenario, shared by the workers, is not modified
+ *
+ * @param pPdn
+ * @param pJob
+ * @param pGtpBuf
+ */
+VOID UeSession::encGtpcOutMsg(GtpcPdn *pPdn, Job *pJob, Buffer *pGtpBuf)
 {
     LOG_ENTERFN();
 
-    U8  buf[GTP_MSG_BUF_LEN];
-    U32 len = 0;
+    GtpMsg *    pGtpMsg = pJob->getGtpMsg();
+    GtpMsgPatch patch;
 
-    /* Modify the header parameters dynamically */
-    GtpMsgHdr msgHdr;
-    msgHdr.teid = pPdn->pCTun->m_remTeid;
-    msgHdr.seqN = m_currProcCache.seqNumber;
-    GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_TEID_PRES);
-    GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_SEQ_PRES);
-    pGtpMsg->setMsgHdr(&msgHdr);
+    patch.teid       = pPdn->pCTun->m_remTeid;
+    patch.seqN       = m_currProcCache.seqNumber;
+    patch.pImsi      = NULL;
+    patch.senderTeid = 0;
+    patch.pSenderIp  = NULL;
 
     GtpMsgType_t msgType = pGtpMsg->type();
     if (GTPC_MSG_CS_REQ == msgType)
     {
-        pGtpMsg->setImsi(&m_imsiKey);
-
-        RETVAL ret = pGtpMsg->setSenderFteid(
-            pPdn->pCTun->m_locTeid, &pPdn->pCTun->m_localEp.ipAddr);
-        if (ROK != ret)
-        {
-            LOG_ERROR("Encoding of sender Fteid Failed");
-            throw ret;
-        }
+        patch.pImsi = &m_imsiKey;
     }
-    else if (GTPC_MSG_CS_RSP == msgType)
+
+    if ((GTPC_MSG_CS_REQ == msgType) || (GTPC_MSG_CS_RSP == msgType))
     {
-        RETVAL ret = pGtpMsg->setSenderFteid(
-            pPdn->pCTun->m_locTeid, &pPdn->pCTun->m_localEp.ipAddr);
-        if (ROK != ret)
-        {
-            LOG_ERROR("Encoding of sender Fteid Failed");
-            throw ret;
-        }
+        patch.senderTeid = pPdn->pCTun->m_locTeid;
+        patch.pSenderIp  = &pPdn->pCTun->m_localEp.ipAddr;
     }
 
-    /* Modify the GTP-U TEID in all the bearers */
-    U32 bearerCnt = pGtpMsg->getIeCount(GTP_IE_BEARER_CNTXT, 0);
-    for (U32 i = 1; i <= bearerCnt; i++)
+    for (U32 i = 0; i < GTP_MAX_BEARERS; i++)
     {
-        GtpIe *           pIe = pGtpMsg->getIe(GTP_IE_BEARER_CNTXT, 0, i);
-        GtpBearerContext *bearerCntxt = dynamic_cast<GtpBearerContext *>(pIe);
-        GtpBearer *       pBearer     = this->getBearer(bearerCntxt->getEbi());
-        bearerCntxt->setGtpuTeid(pBearer->localTeid(), 0);
+        GtpBearer *pBearer  = m_bearerVec[i];
+        patch.bearerTeid[i] = (NULL != pBearer) ? pBearer->localTeid() : 0;
     }
 
-    MEMSET(buf, 0, GTP_MSG_BUF_LEN);
-    pGtpMsg->encode(buf, &len);
-
-    BUFFER_CPY(pGtpBuf, buf, len);
+    RETVAL ret = pJob->getTmpl()->encode(&patch, pGtpBuf);
+    if (ROK != ret)
+    {
+        LOG_ERROR("Encoding of GTPC Message failed, Error [%d]", ret);
+        throw ret;
+    }
 
     LOG_EXITVOID();
 }
@@ -802,35 +841,76 @@ RETVAL UeSession::handleDeadCall(VOID *arg)
     else
     {
         /* A retransmitted message is received for a session whose scenario
-         * is already completed
+         * is already completed, only the pre-parsed header is looked at
          */
-        UdpData_t *data = (UdpData_t *)arg;
-        GtpMsg     rcvdMsg(&data->buf);
+        PktBuf          *data = (PktBuf *)arg;
+        const GtpMsgHdr *pHdr = &data->desc.hdr;
 
-        if (isPrevProcReq(&rcvdMsg))
+        recordMsg(MSG_EVENT_RCVD, data->data(), data->len);
+
+        if (isPrevProcReq(pHdr))
         {
             /* resend the request response */
             Buffer *buf = new Buffer(m_prevProcCache.sentMsg->buf);
             sendMsg(m_prevProcCache.sentMsg->connId,
                 &m_prevProcCache.sentMsg->peerEp, buf);
-            (*m_prevProcItr)->m_initial->m_numRcvRetrans++;
-            (*m_prevProcItr)->m_trigMsg->m_numSndRetrans++;
+            recordMsg(MSG_EVENT_RESENT, m_prevProcCache.sentMsg->buf.pVal,
+                m_prevProcCache.sentMsg->buf.len);
+            (*m_prevProcItr)->m_initial->stats()->numRcvRetrans++;
+            (*m_prevProcItr)->m_trigMsg->stats()->numSndRetrans++;
         }
-        else if (isPrevProcRsp(&rcvdMsg))
+        else if (isPrevProcRsp(pHdr))
         {
-            (*m_prevProcItr)->m_trigMsg->m_numRcvRetrans++;
+            (*m_prevProcItr)->m_trigMsg->stats()->numRcvRetrans++;
         }
         else
         {
-            (*m_prevProcItr)->m_initial->m_numUnexp++;
+            (*m_prevProcItr)->m_initial->stats()->numUnexp++;
+            dumpFailure("Unexpected message received after completion",
+                data->data(), data->len);
         }
 
-        delete data;
+        data->unref();
     }
 
     LOG_EXITFN(ret);
 }
 
+/**
+ * @brief
+ *    Records a message event in the flight recorder of the session, when
+ *    the failure log is enabled
+ *
+ * @param event
+ * @param pMsg
+ *    encoded GTP-C message
+ * @param len
+ */
+VOID UeSession::recordMsg(MsgEventEn event, const U8 *pMsg, U32 len)
+{
+    if (FlightRecorder::isOpen())
+    {
+        m_flightRec.record(event, m_currRunTime, pMsg, len);
+    }
+}
+
+/**
+ * @brief
+ *    Writes the recorded message events of the session to the failure log
+ *
+ * @param pReason
+ * @param pMsg
+ *    message the failure is about
+ * @param len
+ */
+VOID UeSession::dumpFailure(const S8 *pReason, const U8 *pMsg, U32 len)
+{
+    if (FlightRecorder::isOpen())
+    {
+        m_flightRec.dump(pReason, m_sessionId, &m_imsiKey, pMsg, len);
+    }
+}
+
 GtpBearer *UeSession::getBearer(GtpEbi_t ebi)
 {
     LOG_ENTERFN();
@@ -866,15 +946,55 @@ GtpBearer::~GtpBearer()
     delete m_pUTun;
 }
 
+VOID *GtpBearer::operator new(size_t size)
+{
+    return poolAlloc<GtpBearer>(size, "GtpBearer");
+}
+
+VOID GtpBearer::operator delete(VOID *pObj, size_t size)
+{
+    poolFree<GtpBearer>(pObj, size, "GtpBearer");
+}
+
+VOID *GtpcPdn::operator new(size_t size)
+{
+    return poolAlloc<GtpcPdn>(size, "GtpcPdn");
+}
+
+VOID GtpcPdn::operator delete(VOID *pObj, size_t size)
+{
+    poolFree<GtpcPdn>(pObj, size, "GtpcPdn");
+}
+
 PUBLIC VOID cleanupUeSessions()
 {
-    UeSessionMapItr ueItr = s_ueSessionMap.begin();
-    for (; ueItr != s_ueSessionMap.end(); ueItr++)
+    /* a session removes itself from the table when deleted */
+    std::vector<UeSession *> ueSsnLst;
+    s_ueSessionTable.getAll(&ueSsnLst);
+    for (U32 i = 0; i < ueSsnLst.size(); i++)
     {
-        delete ueItr->second;
+        delete ueSsnLst[i];
     }
 }
 
+/**
+ * @brief
+ *    Sizes the UE session table and the object pools of the calling worker
+ *    for the expected number of sessions, so that the memory for the
+ *    sessions is allocated before the traffic is started
+ *
+ * @param numSessions
+ */
+PUBLIC VOID reserveUeSessions(U32 numSessions)
+{
+    s_ueSessionTable.reserve(numSessions);
+
+    ObjPool<UeSession>::local("UeSession").reserve(numSessions);
+    ObjPool<GtpcPdn>::local("GtpcPdn").reserve(numSessions);
+    ObjPool<GtpBearer>::local("GtpBearer").reserve(numSessions);
+    reserveTunnels(numSessions);
+}
+
 PUBLIC GtpcTun *getS11S4CTun(UeSession *pUeSession)
 {
     LOG_ENTERFN();
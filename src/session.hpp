@@ -19,23 +19,12 @@
 
 class Scenario;
 class UeSession;
+class PktBuf;
 
 #define GSIM_SET_BEARER_MASK(_b, _e) GSIM_SET_MASK((_b), (1 << (_e)))
 #define GSIM_UNSET_BEARER_MASK(_b, _e) GSIM_UNSET_MASK((_b), (1 << (_e)))
 #define GSIM_CHK_BEARER_MASK(_b, _e) GSIM_CHK_MASK((_b), (1 << (_e)))
 
-struct CompareImsiKey
-{
-   bool operator() (const GtpImsiKey& left, const GtpImsiKey& right) const
-   {
-      return (MEMCMP(left.val, right.val, left.len) < 0);
-   }
-};
-
-typedef std::map<GtpImsiKey, UeSession*, CompareImsiKey> UeSessionMap;
-typedef std::pair<GtpImsiKey, UeSession*>                UeSessionMapPair;
-typedef UeSessionMap::iterator                           UeSessionMapItr;
-
 class GtpcPdn
 {
    public:
@@ -46,6 +35,9 @@ class GtpcPdn
          bearerMask = 0;
       }
 
+      static VOID *operator new(size_t size);
+      static VOID  operator delete(VOID *pObj, size_t size);
+
       GtpcTun     *pCTun;  /* control plane tunnel for this PDN connection 
                             * On S11 and S4 interface this will point to same
                             * object
@@ -71,17 +63,18 @@ class GtpBearer
       ~GtpBearer();
       GtpBearer(GtpcPdn*, GtpEbi_t);
 
+      static VOID *operator new(size_t size);
+      static VOID  operator delete(VOID *pObj, size_t size);
+
       GtpEbi_t  getEbi() {return m_ebi;}
       GtpTeid_t localTeid() {return m_pUTun->localTeid();}
       VOID      setDfltBearer(BOOL b) {m_isDefBearer = b;}
 
 };
 
-typedef std::list<GtpcPdn *>        GtpcPdnLst;
+typedef std::list<GtpcPdn *, PoolAllocator<GtpcPdn *> > GtpcPdnLst;
 typedef GtpcPdnLst::iterator        GtpcPdnLstItr;
 
-typedef std::vector<GtpBearer*>     GtpBearerVec;
-
 typedef struct
 {
    GtpMsgType_t   reqType;
@@ -96,11 +89,15 @@ typedef struct _ProcCache_t_
    GtpMsgType_t      rspType;
    TransConnId       connId;
    UdpData_t         *sentMsg;
+   Time_t            sentTime;   /* first transmission of the request, in
+                                  * micro-seconds
+                                  */
 
    _ProcCache_t_()
    {
       sentMsg = NULL;
       seqNumber = 0;
+      sentTime = 0;
    }
 } ProcCache_t;
 
@@ -110,6 +107,9 @@ class UeSession: public Task
       UeSession(Scenario *pScn, GtpImsiKey);
       ~UeSession();
 
+      static VOID       *operator new(size_t size);
+      static VOID       operator delete(VOID *pObj, size_t size);
+
       RETVAL            run(VOID *arg = NULL);  
       static UeSession  *createUeSession(GtpImsiKey);
       static UeSession  *getUeSession(GtpTeid_t);
@@ -138,7 +138,7 @@ class UeSession: public Task
       IPEndPoint        m_peerEp;
       EpcNodeType_t     m_nodeType; 
       GtpcPdnLst        m_pdnLst;     
-      GtpBearerVec      m_bearerVec;
+      GtpBearer         *m_bearerVec[GTP_MAX_BEARERS];
       Time_t            m_wakeTime;
       GtpcPdn           *m_pCurrPdn;
       Scenario          *m_pScn;
@@ -146,33 +146,38 @@ class UeSession: public Task
       ProcCache_t       m_currProcCache;
       ProcedureItr      m_currProcItr;
       ProcedureItr      m_prevProcItr;
+      FlightRecorder    m_flightRec;
 
-      BOOL              isExpectedRsp(GtpMsg *rspMsg);
-      BOOL              isExpectedReq(GtpMsg *rspMsg);
-      BOOL              isPrevProcRsp(GtpMsg *rspMsg);
-      BOOL              isPrevProcReq(GtpMsg *rspMsg);
+      BOOL              isExpectedRsp(const GtpMsgHdr *pRspHdr);
+      BOOL              isExpectedReq(const GtpMsgHdr *pReqHdr);
+      BOOL              isPrevProcRsp(const GtpMsgHdr *pRspHdr);
+      BOOL              isPrevProcReq(const GtpMsgHdr *pReqHdr);
       VOID              createBearers(GtpcPdn *pPdn, GtpMsg  *pGtpMsg,\
                               GtpInstance_t instance);
-      VOID              encGtpcOutMsg(GtpcPdn *pPdn, GtpMsg *pGtpMsg,\
-                              Buffer *pBuf, IPEndPoint *ep);
+      VOID              encGtpcOutMsg(GtpcPdn *pPdn, Job *pJob,\
+                              Buffer *pBuf);
       VOID              decAndStoreGtpcIncMsg(GtpcPdn*, GtpMsg*,\
-                              const IPEndPoint*);
+                              PktBuf*);
       GtpBearer*        getBearer(GtpEbi_t ebi);
       GtpcTun*          createCTun(GtpcPdn *pPdn);
       RETVAL            handleSend();
       RETVAL            handleWait();
-      RETVAL            handleRecv(UdpData_t* data);
-      RETVAL            handleIncReqMsg(GtpMsg *pGtpMsg, UdpData_t *rcvdData);
-      RETVAL            handleIncRspMsg(GtpMsg *pGtpMsg, UdpData_t *rcvdData);
+      RETVAL            handleRecv(PktBuf* data);
+      RETVAL            handleIncReqMsg(GtpMsg *pGtpMsg, PktBuf *rcvdData);
+      RETVAL            handleIncRspMsg(GtpMsg *pGtpMsg, PktBuf *rcvdData);
       RETVAL            handleOutRspMsg(GtpMsg *gtpMsg);
       RETVAL            handleOutReqMsg(GtpMsg *gtpMsg);
       RETVAL            handleOutReqTimeout();
       RETVAL            handleDeadCall(VOID *arg);
       VOID              handleCompletedTask();
+      VOID              recordMsg(MsgEventEn event, const U8 *pMsg, U32 len);
+      VOID              dumpFailure(const S8 *pReason, const U8 *pMsg,\
+                              U32 len);
 };
 
 EXTERN UeSession* getUeSession(const U8* pImsi);
 EXTERN VOID       cleanupUeSessions();
+EXTERN VOID       reserveUeSessions(U32 numSessions);
 EXTERN GtpcTun*   getS11S4CTun(UeSession *pUeSession);
 
 #endif
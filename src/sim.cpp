@@ -39,9 +39,17 @@ using std::vector;
 #include "display.hpp"
 #include "scenario.hpp"
 #include "gtp_peer.hpp"
+#include "thread.hpp"
+#include "worker.hpp"
+#include "obj_pool.hpp"
+#include "stats_export.hpp"
+#include "pcap.hpp"
+#include "flight_rec.hpp"
+#include "rate_profile.hpp"
 #include "sim.hpp"
 
 EXTERN VOID      cleanupUeSessions();
+EXTERN VOID      reserveUeSessions(U32 numSessions);
 class Simulator *Simulator::pSim = NULL;
 
 Simulator *Simulator::getInstance()
@@ -80,14 +88,82 @@ VOID Simulator::run(VOID *arg)
 {
     LOG_ENTERFN();
 
+    Config *pCfg = Config::getInstance();
+
+    /* worker 0 runs on the main thread, it owns the keyboard and the
+     * display along with its share of the sessions
+     */
+    setTimerTick(pCfg->getTimerTick());
+    getMilliSeconds();
+    ObjPoolBase::setHugePages(pCfg->getHugePages());
+    Worker::createWorkers(pCfg->getNumWorkers());
+    Stats::attachWorker(0);
+    attachTimerStats(0);
+
+    /* the scenario is loaded once and shared by all the workers */
     m_pScn = Scenario::getInstance();
-    m_pScn->init(Config::getInstance()->getScnFile());
+    m_pScn->init(pCfg->getScnFile());
+    Worker::self()->attach(m_pScn);
+    Job::attachWorker(0);
+
+    /* load shape of the traffic, shared by the workers like the scenario */
+    if (!pCfg->getRateProfile().empty())
+    {
+        RateProfile::load(pCfg->getRateProfile());
+    }
+
+    // Capture of the messages, opened before any thread sends or receives
+    if (!pCfg->getPcapFile().empty())
+    {
+        RETVAL ret = Pcap::open(pCfg->getPcapFile(), pCfg->getPcapFileSize());
+        if (ROK != ret)
+        {
+            LOG_FATAL("Opening capture file [%s]",
+                pCfg->getPcapFile().c_str());
+            throw (ErrCodeEn)ret;
+        }
+    }
+
+    // Message history of the sessions, written only for failed sessions
+    if (!pCfg->getFailureLog().empty())
+    {
+        RETVAL ret = FlightRecorder::open(pCfg->getFailureLog());
+        if (ROK != ret)
+        {
+            LOG_FATAL("Opening failure log [%s]",
+                pCfg->getFailureLog().c_str());
+            throw (ErrCodeEn)ret;
+        }
+    }
+
+    /* receive thread creates the listener socket, which is used by the
+     * workers for sending the replies
+     */
+    RxThread *pRxThread = NULL;
+    if (pCfg->getPipelineMode())
+    {
+        pRxThread = new RxThread;
+        if (ROK != pRxThread->startRx())
+        {
+            LOG_FATAL("Initializing Receive thread");
+            throw ERR_THREAD_CREATE;
+        }
+    }
 
     /* Creates UDP sockets for listing of gtp messages */
     LOG_DEBUG("Initializing Transport connections");
     if (ROK != initTransport())
     {
         LOG_FATAL("Initializing Transport connections");
+        stopRxThread(pRxThread);
+        LOG_EXITVOID();
+    }
+
+    if (((pCfg->getNumWorkers() > 1) || pCfg->getPipelineMode()) &&
+        (ROK != setupInboxSock(Worker::self()->inboxFd())))
+    {
+        LOG_FATAL("Initializing Worker inbox");
+        stopRxThread(pRxThread);
         LOG_EXITVOID();
     }
 
@@ -99,7 +175,135 @@ VOID Simulator::run(VOID *arg)
     Display *pDisp = Display::getInstance();
     pDisp->init();
 
-    if (SCN_TYPE_INITIATING == m_pScn->getScnType())
+    // Periodic statistics samples written to a file by a thread of its own
+    StatsExport *pExport = NULL;
+    if (!pCfg->getStatsFile().empty())
+    {
+        pExport    = new StatsExport;
+        RETVAL ret = pExport->startExport();
+        if (ROK != ret)
+        {
+            LOG_FATAL("Starting statistics export to [%s]",
+                pCfg->getStatsFile().c_str());
+            throw (ErrCodeEn)ret;
+        }
+    }
+
+    for (U32 i = 1; i < pCfg->getNumWorkers(); i++)
+    {
+        if (0 != Worker::getWorker(i)->start(NULL))
+        {
+            LOG_FATAL("Creating Worker thread [%d]", i);
+            throw ERR_THREAD_CREATE;
+        }
+    }
+
+    LOG_DEBUG("Generating Signalling traffic");
+    startTraffic();
+
+    /* last sample is taken before the workers exit, the statistics of a
+     * worker are gone with the worker thread
+     */
+    if (NULL != pExport)
+    {
+        pExport->stopExport();
+        delete pExport;
+    }
+
+    for (U32 i = 1; i < pCfg->getNumWorkers(); i++)
+    {
+        Worker *pWorker = Worker::getWorker(i);
+        pWorker->join();
+    }
+
+    stopRxThread(pRxThread);
+    Pcap::close();
+    FlightRecorder::close();
+    RateProfile::unload();
+    pKb->abort();
+    Display::dumpLatency();
+    Worker::deleteWorkers();
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Stops the receive thread of the pipeline mode, after the workers
+ *    have stopped
+ *
+ * @param pRxThread
+ */
+VOID Simulator::stopRxThread(RxThread *pRxThread)
+{
+    if (NULL != pRxThread)
+    {
+        Keyboard::key = KB_KEY_SIM_QUIT;
+        pRxThread->join();
+        delete pRxThread;
+    }
+}
+
+/**
+ * @brief
+ *    Worker thread, attaches to the scenario loaded by the main thread and
+ *    creates its sockets before running the scheduler
+ */
+VOID Simulator::runWorker()
+{
+    LOG_ENTERFN();
+
+    Worker *pWorker = Worker::self();
+    BOOL    ready   = TRUE;
+
+    getMilliSeconds();
+    Stats::attachWorker(pWorker->id());
+    Job::attachWorker(pWorker->id());
+    attachTimerStats(pWorker->id());
+    pWorker->attach(Scenario::getInstance());
+
+    if ((ROK != initTransport()) ||
+        (ROK != setupInboxSock(pWorker->inboxFd())))
+    {
+        ready = FALSE;
+    }
+
+    if (!ready)
+    {
+        LOG_FATAL("Initializing Worker [%d]", pWorker->id());
+        Keyboard::key = KB_KEY_SIM_QUIT;
+    }
+
+    startTraffic();
+    Pcap::flush();
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Waits for all the workers to be ready, and runs the scheduler of the
+ *    calling worker till the simulator is stopped
+ */
+VOID Simulator::startTraffic()
+{
+    LOG_ENTERFN();
+
+    Config *pCfg        = Config::getInstance();
+    U32     maxSessions = pCfg->getNumSessions();
+
+    reserveUeSessions(getWorkerShare(maxSessions));
+    Worker::waitAllReady();
+
+    /* a worker may not get any share of the sessions, if the rate or the
+     * number of sessions is less than the number of workers. The rate of a
+     * rate profile is shared by all the workers.
+     */
+    if ((KB_KEY_SIM_QUIT != Keyboard::key) &&
+        (SCN_TYPE_INITIATING == Scenario::getInstance()->getScnType()) &&
+        ((NULL != RateProfile::get()) ||
+         (0 != getWorkerShare(pCfg->getCallRate()))) &&
+        ((0 == maxSessions) || (0 != getWorkerShare(maxSessions))))
     {
         TrafficTask *pTTask = new TrafficTask;
         if (pTTask == NULL)
@@ -111,15 +315,13 @@ VOID Simulator::run(VOID *arg)
          * and ordering of message
          */
         IPEndPoint peer;
-        peer.ipAddr = Config::getInstance()->getRemoteIpAddr();
-        peer.port   = Config::getInstance()->getRemoteGtpcPort();
+        peer.ipAddr = pCfg->getRemoteIpAddr();
+        peer.port   = pCfg->getRemoteGtpcPort();
         addPeerData(peer);
     }
 
-    LOG_DEBUG("Generating Signalling traffic");
     startScheduler();
 
-    pKb->abort();
     TaskMgr::deleteAllTasks();
     deletePeerTable();
 
@@ -158,27 +360,64 @@ VOID Simulator::startScheduler()
             TaskMgr::resumePausedTasks();
         }
 
-        TaskList *  pRunningTasks = TaskMgr::getRunningTasks();
-        TaskListItr itr           = pRunningTasks->begin();
-        while (itr != pRunningTasks->end())
+        TaskList *pRunningTasks = TaskMgr::getRunningTasks();
+        TaskLink *pLink         = pRunningTasks->begin();
+        while (pLink != pRunningTasks->end())
         {
-            Task *t = *itr;
+            Task *t = pLink->pTask;
 
-            // increment the iterator here, because after the task is run
+            // move to the next link here, because after the task is run
             // it will be paused state which will move the task from running
             // task list to paused task list.
-            itr++;
+            pLink = pLink->pNext;
             if (ROK != t->run())
             {
                 t->abort();
             }
         }
 
-        getMilliSeconds();
+        // write the messages queued by the tasks before waiting on poll
+        flushSockets();
 
-        // read the sockets for keyboard events and gtp messages
-        socketPoll(1);
+        // read the sockets for keyboard events and gtp messages, sleep
+        // until the next paused task is due if there are no tasks ready
+        // to run
+        if (pRunningTasks->empty())
+        {
+            waitForTasks();
+        }
+        else
+        {
+            socketPoll(0);
+        }
     }
 
     LOG_EXITVOID();
 }
+
+/**
+ * @brief
+ *    Waits on the socket poll till the first paused task is due or a
+ *    socket is ready. The wait is bounded by GSIM_SCHED_MAX_WAIT, so that
+ *    a key press read by worker 0 is seen by the other workers.
+ */
+VOID Simulator::waitForTasks()
+{
+    Time_t now  = getSchedMicroSeconds();
+    Time_t wake = now + GSIM_SCHED_MAX_WAIT;
+
+    /* paused tasks are not resumed while the traffic is paused */
+    if (KB_KEY_PAUSE_TRAFFIC != Keyboard::key)
+    {
+        wake = TaskMgr::getNextWakeTime(wake);
+    }
+
+    if (wake <= now)
+    {
+        socketPoll(0);
+        return;
+    }
+
+    setSchedTimer(wake, now);
+    socketPoll(-1);
+}
@@ -29,11 +29,15 @@ class Simulator
       static Simulator* getInstance();
 
       void run(VOID *arg = NULL);
+      void runWorker();
       void postEvent();
 
    private:
       Simulator();
+      VOID startTraffic();
+      VOID stopRxThread(class RxThread *pRxThread);
       VOID startScheduler();
+      VOID waitForTasks();
 
       static class Simulator  *pSim;
       class Scenario          *m_pScn;
@@ -85,6 +85,22 @@ Config::Config()
     m_ifTypeStr                          = "";
     m_nodeType                           = EPC_NODE_INV;
     m_traceMsg                           = FALSE;
+    m_recvBatchSize                      = DFLT_RECV_BATCH_SIZE;
+    m_sendBatchSize                      = DFLT_SEND_BATCH_SIZE;
+    m_ioBackend                          = IO_BACKEND_EPOLL;
+    m_timerTick                          = DFLT_TIMER_TICK;
+    m_numWorkers                         = DFLT_NUM_WORKERS;
+    m_pipelineMode                       = FALSE;
+    m_handoffRingSize                    = DFLT_HANDOFF_RING_SIZE;
+    m_hugePages                          = FALSE;
+    m_statsFormat                        = STATS_FORMAT_CSV;
+    m_statsIntvl                         = DFLT_STATS_INTERVAL;
+    m_statsFileSize                      = DFLT_STATS_FILE_SIZE;
+    m_pcapFileSize                       = 0;
+    m_pacingMode                         = PACING_MODE_BURST;
+    m_pacingBurst                        = DFLT_PACING_BURST;
+    m_maxOutstanding                     = 0;
+    m_aimd                               = FALSE;
     pid_t pid                            = getpid();
     m_localIpAddrStr                     = DFLT_LOCAL_IP_ADDR;
 
@@ -227,6 +243,123 @@ VOID Config::setConfig(cxxopts::ParseResult options)
         auto value = options["log-level"].as<std::uint32_t>();
         setLogLevel(value);
     }
+
+    if (options.count("recv-batch"))
+    {
+        auto value = options["recv-batch"].as<std::uint32_t>();
+        setRecvBatchSize(value);
+    }
+
+    if (options.count("send-batch"))
+    {
+        auto value = options["send-batch"].as<std::uint32_t>();
+        setSendBatchSize(value);
+    }
+
+    if (options.count("io-backend"))
+    {
+        auto value = options["io-backend"].as<std::string>();
+        setIoBackend(value);
+    }
+
+    if (options.count("timer-tick"))
+    {
+        auto value = options["timer-tick"].as<std::uint32_t>();
+        setTimerTick(value);
+    }
+
+    if (options.count("threads"))
+    {
+        auto value = options["threads"].as<std::uint32_t>();
+        setNumWorkers(value);
+    }
+
+    if (options.count("pipeline"))
+    {
+        setPipelineMode(TRUE);
+    }
+
+    if (options.count("ring-size"))
+    {
+        auto value = options["ring-size"].as<std::uint32_t>();
+        setHandoffRingSize(value);
+    }
+
+    if (options.count("hugepages"))
+    {
+        setHugePages(TRUE);
+    }
+
+    if (options.count("stats-file"))
+    {
+        auto value = options["stats-file"].as<std::string>();
+        setStatsFile(value);
+    }
+
+    if (options.count("stats-format"))
+    {
+        auto value = options["stats-format"].as<std::string>();
+        setStatsFormat(value);
+    }
+
+    if (options.count("stats-interval"))
+    {
+        auto value = options["stats-interval"].as<std::uint32_t>();
+        setStatsInterval(value);
+    }
+
+    if (options.count("stats-file-size"))
+    {
+        auto value = options["stats-file-size"].as<std::uint32_t>();
+        setStatsFileSize(value);
+    }
+
+    if (options.count("pcap-file"))
+    {
+        auto value = options["pcap-file"].as<std::string>();
+        setPcapFile(value);
+    }
+
+    if (options.count("pcap-file-size"))
+    {
+        auto value = options["pcap-file-size"].as<std::uint32_t>();
+        setPcapFileSize(value);
+    }
+
+    if (options.count("failure-log"))
+    {
+        auto value = options["failure-log"].as<std::string>();
+        setFailureLog(value);
+    }
+
+    if (options.count("pacing"))
+    {
+        auto value = options["pacing"].as<std::string>();
+        setPacingMode(value);
+    }
+
+    if (options.count("pacing-burst"))
+    {
+        auto value = options["pacing-burst"].as<std::uint32_t>();
+        setPacingBurst(value);
+    }
+
+    if (options.count("rate-profile"))
+    {
+        auto value = options["rate-profile"].as<std::string>();
+        setRateProfile(value);
+    }
+
+    if (options.count("max-outstanding"))
+    {
+        auto value = options["max-outstanding"].as<std::uint32_t>();
+        setMaxOutstanding(value);
+    }
+
+    if (options.count("aimd"))
+    {
+        setAimd(TRUE);
+    }
 }
 
 VOID Config::setNoOfCalls(U32 n)
@@ -647,3 +780,315 @@ std::string Config::getIfTypeStr()
 {
     return m_ifTypeStr;
 }
+
+VOID Config::setRecvBatchSize(U32 n)
+{
+    if ((0 == n) || (n > DFLT_MAX_RECV_BATCH_SIZE))
+    {
+        throw GsimError("Invalid receive batch size");
+    }
+
+    m_recvBatchSize = n;
+}
+
+U32 Config::getRecvBatchSize()
+{
+    return m_recvBatchSize;
+}
+
+VOID Config::setSendBatchSize(U32 n)
+{
+    if ((0 == n) || (n > DFLT_MAX_SEND_BATCH_SIZE))
+    {
+        throw GsimError("Invalid send batch size");
+    }
+
+    m_sendBatchSize = n;
+}
+
+U32 Config::getSendBatchSize()
+{
+    return m_sendBatchSize;
+}
+
+VOID Config::setIoBackend(std::string backend)
+{
+    if (!STRCASECMP(backend.c_str(), "epoll"))
+    {
+        m_ioBackend = IO_BACKEND_EPOLL;
+    }
+    else if (!STRCASECMP(backend.c_str(), "poll"))
+    {
+        m_ioBackend = IO_BACKEND_POLL;
+    }
+    else
+    {
+        throw GsimError("Invalid IO backend, supported values are epoll, poll");
+    }
+}
+
+VOID Config::setTimerTick(U32 tick)
+{
+    if ((tick < DFLT_MIN_TIMER_TICK) || (tick > DFLT_MAX_TIMER_TICK))
+    {
+        throw GsimError("Invalid timer tick, supported values are 10 to "
+                        "10000 micro seconds");
+    }
+
+    m_timerTick = tick;
+}
+
+U32 Config::getTimerTick()
+{
+    return m_timerTick;
+}
+
+IoBackendEn Config::getIoBackend()
+{
+    return m_ioBackend;
+}
+
+VOID Config::setNumWorkers(U32 n)
+{
+    if ((0 == n) || (n > DFLT_MAX_NUM_WORKERS))
+    {
+        throw GsimError("Invalid number of threads, maximum supported is 16");
+    }
+
+    m_numWorkers = n;
+}
+
+U32 Config::getNumWorkers()
+{
+    return m_numWorkers;
+}
+
+VOID Config::setPipelineMode(BOOL enable)
+{
+    m_pipelineMode = enable;
+}
+
+BOOL Config::getPipelineMode()
+{
+    return m_pipelineMode;
+}
+
+VOID Config::setHandoffRingSize(U32 n)
+{
+    if ((0 == n) || (n > DFLT_MAX_HANDOFF_RING_SIZE) || (0 != (n & (n - 1))))
+    {
+        throw GsimError("Invalid ring size, must be a power of two");
+    }
+
+    m_handoffRingSize = n;
+}
+
+U32 Config::getHandoffRingSize()
+{
+    return m_handoffRingSize;
+}
+
+VOID Config::setHugePages(BOOL enable)
+{
+    m_hugePages = enable;
+}
+
+BOOL Config::getHugePages()
+{
+    return m_hugePages;
+}
+
+VOID Config::setStatsFile(string filename)
+{
+    if (filename.size() == 0)
+    {
+        throw GsimError("Invalid statistics file");
+    }
+
+    m_statsFile = filename;
+}
+
+string Config::getStatsFile()
+{
+    return m_statsFile;
+}
+
+VOID Config::setStatsFormat(std::string format)
+{
+    if (!STRCASECMP(format.c_str(), "csv"))
+    {
+        m_statsFormat = STATS_FORMAT_CSV;
+    }
+    else if (!STRCASECMP(format.c_str(), "json"))
+    {
+        m_statsFormat = STATS_FORMAT_JSON;
+    }
+    else
+    {
+        throw GsimError("Invalid statistics format, supported values are "
+                        "csv, json");
+    }
+}
+
+StatsFormatEn Config::getStatsFormat()
+{
+    return m_statsFormat;
+}
+
+VOID Config::setStatsInterval(U32 n)
+{
+    if (n < 10)
+    {
+        throw GsimError("Invalid statistics interval, minimum is 10 ms");
+    }
+
+    m_statsIntvl = n;
+}
+
+U32 Config::getStatsInterval()
+{
+    return m_statsIntvl;
+}
+
+VOID Config::setStatsFileSize(U32 n)
+{
+    if (0 == n)
+    {
+        throw GsimError("Invalid statistics file size");
+    }
+
+    m_statsFileSize = n;
+}
+
+U32 Config::getStatsFileSize()
+{
+    return m_statsFileSize;
+}
+
+VOID Config::setPcapFile(string filename)
+{
+    if (filename.size() == 0)
+    {
+        throw GsimError("Invalid capture file");
+    }
+
+    m_pcapFile = filename;
+}
+
+string Config::getPcapFile()
+{
+    return m_pcapFile;
+}
+
+VOID Config::setPcapFileSize(U32 n)
+{
+    m_pcapFileSize = n;
+}
+
+U32 Config::getPcapFileSize()
+{
+    return m_pcapFileSize;
+}
+
+VOID Config::setFailureLog(string filename)
+{
+    if (filename.size() == 0)
+    {
+        throw GsimError("Invalid failure log file");
+    }
+
+    m_failureLog = filename;
+}
+
+string Config::getFailureLog()
+{
+    return m_failureLog;
+}
+
+VOID Config::setPacingMode(std::string mode)
+{
+    if (!STRCASECMP(mode.c_str(), "burst"))
+    {
+        m_pacingMode = PACING_MODE_BURST;
+    }
+    else if (!STRCASECMP(mode.c_str(), "uniform"))
+    {
+        m_pacingMode = PACING_MODE_UNIFORM;
+    }
+    else if (!STRCASECMP(mode.c_str(), "poisson"))
+    {
+        m_pacingMode = PACING_MODE_POISSON;
+    }
+    else
+    {
+        throw GsimError("Invalid pacing mode, supported values are burst, "
+                        "uniform, poisson");
+    }
+}
+
+PacingModeEn Config::getPacingMode()
+{
+    return m_pacingMode;
+}
+
+VOID Config::setPacingBurst(U32 n)
+{
+    if (0 == n)
+    {
+        throw GsimError("Invalid pacing burst size");
+    }
+
+    m_pacingBurst = n;
+}
+
+U32 Config::getPacingBurst()
+{
+    return m_pacingBurst;
+}
+
+VOID Config::setRateProfile(string filename)
+{
+    if (filename.size() == 0)
+    {
+        throw GsimError("Invalid rate profile file");
+    }
+
+    m_rateProfile = filename;
+}
+
+string Config::getRateProfile()
+{
+    return m_rateProfile;
+}
+
+VOID Config::setMaxOutstanding(U32 n)
+{
+    if ((0 == n) || (n > DFLT_MAX_CONC_WINDOW))
+    {
+        throw GsimError("Invalid maximum outstanding requests, supported "
+                        "values are 1 to 1000000");
+    }
+
+    m_maxOutstanding = n;
+}
+
+U32 Config::getMaxOutstanding()
+{
+    return m_maxOutstanding;
+}
+
+VOID Config::setAimd(BOOL enable)
+{
+    if (enable && (0 == m_maxOutstanding))
+    {
+        throw GsimError("AIMD requires the initial window, set with "
+                        "max-outstanding");
+    }
+
+    m_aimd = enable;
+}
+
+BOOL Config::getAimd()
+{
+    return m_aimd;
+}
@@ -35,6 +35,23 @@ using namespace std;
 #define DFLT_MAX_SESSION_RATE 1000000 // 1 session per rate period
 #define DFLT_TRACE_MSG_FILE_NAME_LEN 64
 #define DFLT_DEAD_CALL_WAIT 20000 // milli seconds
+#define DFLT_RECV_BATCH_SIZE 64   // datagrams read per recvmmsg() call
+#define DFLT_MAX_RECV_BATCH_SIZE 1024
+#define DFLT_SEND_BATCH_SIZE 64   // datagrams written per sendmmsg() call
+#define DFLT_MAX_SEND_BATCH_SIZE 1024
+#define DFLT_TIMER_TICK 1000          // micro seconds, time wheel resolution
+#define DFLT_MIN_TIMER_TICK 10
+#define DFLT_MAX_TIMER_TICK 10000
+#define DFLT_NUM_WORKERS 1
+#define DFLT_MAX_NUM_WORKERS 16       // limited by worker id bits of TEID
+#define DFLT_HANDOFF_RING_SIZE 4096   // messages, power of two
+#define DFLT_MAX_HANDOFF_RING_SIZE 65536
+#define DFLT_STATS_INTERVAL 1000      // milli seconds
+#define DFLT_STATS_FILE_SIZE 64       // mega bytes, statistics file rotated
+#define DFLT_STATS_FILE_ROTATIONS 4   // rotated statistics files kept
+#define DFLT_PCAP_FILE_ROTATIONS 4    // rotated capture files kept
+#define DFLT_PACING_BURST 1           // sessions started back to back
+#define DFLT_MAX_CONC_WINDOW 1000000  // pending requests, limiter window
 
 typedef enum {
     DISP_TARGET_NONE,
@@ -43,6 +60,25 @@ typedef enum {
     DISP_TARGET_MAX
 } DisplayTargetEn;
 
+typedef enum {
+    IO_BACKEND_POLL,
+    IO_BACKEND_EPOLL,
+    IO_BACKEND_MAX
+} IoBackendEn;
+
+typedef enum {
+    PACING_MODE_BURST,   // all the sessions of a rate period at its start
+    PACING_MODE_UNIFORM, // sessions evenly spaced over the rate period
+    PACING_MODE_POISSON, // sessions spaced as a Poisson process
+    PACING_MODE_MAX
+} PacingModeEn;
+
+typedef enum {
+    STATS_FORMAT_CSV,
+    STATS_FORMAT_JSON,
+    STATS_FORMAT_MAX
+} StatsFormatEn;
+
 // Config will be a singleton object, accessed using getInstance
 class Config
 {
@@ -72,6 +108,26 @@ public:
     VOID setLogLevel(std::uint32_t logLvl);
     VOID setTraceMsg(BOOL);
     VOID setTraceMsgFile(string);
+    VOID setRecvBatchSize(U32 n);
+    VOID setSendBatchSize(U32 n);
+    VOID setIoBackend(std::string backend);
+    VOID setTimerTick(U32 tick);
+    VOID setNumWorkers(U32 n);
+    VOID setPipelineMode(BOOL enable);
+    VOID setHandoffRingSize(U32 n);
+    VOID setHugePages(BOOL enable);
+    VOID setStatsFile(string filename);
+    VOID setStatsFormat(std::string format);
+    VOID setStatsInterval(U32 n);
+    VOID setStatsFileSize(U32 n);
+    VOID setPcapFile(string filename);
+    VOID setPcapFileSize(U32 n);
+    VOID setFailureLog(string filename);
+    VOID setPacingMode(std::string mode);
+    VOID setPacingBurst(U32 n);
+    VOID setRateProfile(string filename);
+    VOID setMaxOutstanding(U32 n);
+    VOID setAimd(BOOL enable);
 
     IpAddr        getRemoteIpAddr();
     string        getRemIpAddrStr();
@@ -103,6 +159,26 @@ public:
     void          setNodeType(std::string node);
     std::string   getNodeTypeStr();
     std::string   getIfTypeStr();
+    U32           getRecvBatchSize();
+    U32           getSendBatchSize();
+    IoBackendEn   getIoBackend();
+    U32           getTimerTick();
+    U32           getNumWorkers();
+    BOOL          getPipelineMode();
+    U32           getHandoffRingSize();
+    BOOL          getHugePages();
+    string        getStatsFile();
+    StatsFormatEn getStatsFormat();
+    U32           getStatsInterval();
+    U32           getStatsFileSize();
+    string        getPcapFile();
+    U32           getPcapFileSize();
+    string        getFailureLog();
+    PacingModeEn  getPacingMode();
+    U32           getPacingBurst();
+    string        getRateProfile();
+    U32           getMaxOutstanding();
+    BOOL          getAimd();
 
 private:
     Config();
@@ -136,6 +212,26 @@ private:
     string          m_imsiStr;
     Time_t          m_deadCallWait;
     string          m_nodeTypStr;
+    U32             m_recvBatchSize;
+    U32             m_sendBatchSize;
+    IoBackendEn     m_ioBackend;
+    U32             m_timerTick;   /* micro-seconds */
+    U32             m_numWorkers;
+    BOOL            m_pipelineMode;
+    U32             m_handoffRingSize;
+    BOOL            m_hugePages;
+    string          m_statsFile;     // periodic statistics export file
+    StatsFormatEn   m_statsFormat;
+    U32             m_statsIntvl;    // milli seconds
+    U32             m_statsFileSize; // mega bytes
+    string          m_pcapFile;      // capture of the GTP-C messages
+    U32             m_pcapFileSize;  // mega bytes, 0 if not rotated
+    string          m_failureLog;    // message history of failed sessions
+    PacingModeEn    m_pacingMode;
+    U32             m_pacingBurst;
+    string          m_rateProfile;   // load shape of the session rate
+    U32             m_maxOutstanding; // pending requests, 0 if no limit
+    BOOL            m_aimd;          // window tuned to the peer capacity
 };
 
 #endif
@@ -21,13 +21,17 @@
 #include <exception>
 #include <poll.h>
 #include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 #include <string.h>
 #include <list>
+#include <vector>
 
 #include "types.hpp"
 #include "macros.hpp"
 #include "logger.hpp"
 #include "error.hpp"
+#include "timer.hpp"
 #include "thread.hpp"
 #include "transport.hpp"
 #include "keyboard.hpp"
@@ -35,82 +39,247 @@
 #include "socket.hpp"
 #include "sim_cfg.hpp"
 #include "gtp_macro.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "pkt_buf.hpp"
+#include "pcap.hpp"
 
 /******************* Function Declarations ***********************************/
-EXTERN VOID procGtpcMsg(UdpData_t *data);
+EXTERN VOID procGtpcMsg(PktBuf *data);
+EXTERN VOID procGtpcMsgBatch(PktBuf **msgs, U32 numMsgs);
 PRIVATE RETVAL sendMsgV4(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data);
 PRIVATE RETVAL sendMsgV6(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data);
-PRIVATE RETVAL handleGtpcSock(GSimSocket *pSock);
+PRIVATE BOOL handleGtpcSock(GSimSocket *pSock);
 PRIVATE RETVAL handleGtpuSock(GSimSocket *pSock);
 PRIVATE VOID handleStdinSock(GSimSocket *pSock);
+PRIVATE VOID handleTimerSock(GSimSocket *pSock);
+EXTERN VOID procWorkerInbox();
+PRIVATE BOOL handleSockEvents(GSimSocket *pSock, U32 events);
+PRIVATE VOID pollSockets(S32 wait);
+PRIVATE VOID epollSockets(S32 wait);
+PRIVATE TransConnId registerSocket(GSimSocket *pSock, U32 events);
+PRIVATE VOID unregisterSocket(GSimSocket *pSock);
+PRIVATE VOID initRecvSlots(U32 batchSize);
+PRIVATE RETVAL initSocketEvents(Config *pCfg);
+PRIVATE RETVAL createTimerSock();
+PRIVATE VOID sockAddrToEp(const struct sockaddr_storage *pAddr,
+    IPEndPoint *pEp);
+PRIVATE socklen_t epToSockAddr(IPEndPoint *pEp,
+    struct sockaddr_storage *pAddr);
 /******************* Function Declarations ***********************************/
 
-GSimSocket *       g_gsimSockArr[GSIM_MAX_SOCK_CNT];
-GSimPollFd         s_pollFdArr[GSIM_MAX_POLL_FDS];
-static U32         s_pollFdCnt = 0;
-static GSimSocket *s_pListener = NULL;
-static GSimSocket *s_pSender   = NULL;
-static U8          s_recvBuf[GSIM_UDP_READ_LEN];
+/* socket registry, connection id of a socket is its index in the registry,
+ * the poll() fd array is indexed by connection id as well. Every worker
+ * has its own registry and creates its sockets in the same order, so a
+ * connection id refers to the same kind of socket in all the workers.
+ */
+static thread_local std::vector<GSimSocket *> s_sockArr;
+static thread_local std::vector<GSimPollFd>   s_pollFdArr;
+static thread_local std::vector<TransConnId>  s_freeConnIds;
+
+static thread_local IoBackendEn        s_ioBackend = IO_BACKEND_POLL;
+static thread_local S32                s_epollFd   = -1;
+static thread_local struct epoll_event s_epollEvents[GSIM_MAX_EPOLL_EVENTS];
+
+/* sockets to be read again in the next poll, and the sockets with
+ * messages in the transmit queue
+ */
+static thread_local std::vector<TransConnId> s_readyConnIds;
+static thread_local std::vector<TransConnId> s_pendingConnIds;
+static thread_local std::vector<TransConnId> s_txConnIds;
+static thread_local std::vector<TransConnId> s_txFlushConnIds;
+
+static thread_local GSimSocket *s_pListener = NULL;
+static thread_local GSimSocket *s_pSender   = NULL;
+static thread_local GSimSocket *s_pTimer    = NULL;
+
+/* scheduler time the timer is armed to expire at, micro-seconds */
+static thread_local Time_t      s_timerWake = 0;
+
+/* packet buffer for the next datagram read with recvfrom() */
+static thread_local PktBuf     *s_pRecvPkt = NULL;
+
+/* listener socket of the receive thread, pipeline mode */
+static S32 s_rxListenerFd = -1;
+
+/* receive slots used by recvmmsg(), allocated once at transport init */
+static thread_local U32             s_recvBatchSize = 1;
+static thread_local GSimRecvSlot *  s_recvSlots     = NULL;
+static thread_local struct mmsghdr *s_recvMmsgHdrs  = NULL;
+static thread_local struct iovec *  s_recvIovs      = NULL;
+static thread_local PktBuf **       s_recvBatch     = NULL;
+
+/**
+ * @brief
+ *    Returns the packet buffer to read the next datagram into, the buffer
+ *    is kept for the next read if the socket has no datagram
+ */
+PRIVATE PktBuf *getRecvPkt()
+{
+    if (NULL == s_pRecvPkt)
+    {
+        s_pRecvPkt = PktBuf::alloc();
+    }
+
+    return s_pRecvPkt;
+}
 
 /**
  * @brief
- *    Reads the UDP socket, allocates socket buffer
+ *    Reads the UDP socket directly into a packet buffer
  *
  * @return
  */
-RETVAL GSimSocket::recvMsgV4(UdpData_t **msg)
+RETVAL GSimSocket::recvMsgV4(PktBuf **msg)
 {
     struct sockaddr_in fromAddr;
     socklen_t          fromLen = sizeof(sockaddr_in);
+    PktBuf *           pPkt    = getRecvPkt();
 
-    S32 recvLen = recvfrom(m_fd, s_recvBuf, GSIM_UDP_READ_LEN, MSG_DONTWAIT,
+    S32 recvLen = recvfrom(m_fd, pPkt->data(), pPkt->size(), MSG_DONTWAIT,
         (struct sockaddr *)&fromAddr, &fromLen);
     if (recvLen > 0)
     {
-        *msg = new UdpData_t;
-        BUFFER_CPY(&(*msg)->buf, s_recvBuf, recvLen);
-        (*msg)->connId                        = m_pollFdIndex;
+        s_pRecvPkt = NULL;
+        *msg       = pPkt;
+        (*msg)->len                           = recvLen;
+        (*msg)->connId                        = m_connId;
         (*msg)->peerEp.ipAddr.ipAddrType      = IP_ADDR_TYPE_V4;
         (*msg)->peerEp.ipAddr.u.ipv4Addr.addr = ntohl(fromAddr.sin_addr.s_addr);
         (*msg)->peerEp.port                   = ntohs(fromAddr.sin_port);
         return ROK;
     }
+    else if (0 == recvLen)
+    {
+        /* an empty datagram is dropped, the buffer is kept for the next */
+        *msg = NULL;
+        return ROK;
+    }
 
     return RFAILED;
 }
 
 /**
  * @brief
- *    Peeks the gtp message, and reads the message of gtp msg length
- *    and fills the UdpData_t structre from IPv6 socket
+ *    Reads the IPv6 UDP socket directly into a packet buffer
  *
  * @param data
  *
  * @return
  */
-RETVAL GSimSocket::recvMsgV6(UdpData_t **msg)
+RETVAL GSimSocket::recvMsgV6(PktBuf **msg)
 {
     struct sockaddr_in6 fromAddr;
-    socklen_t           fromLen = 0;
+    socklen_t           fromLen = sizeof(sockaddr_in6);
+    PktBuf *            pPkt    = getRecvPkt();
 
-    U32 recvLen = recvfrom(m_fd, s_recvBuf, GSIM_UDP_READ_LEN, MSG_DONTWAIT,
+    S32 recvLen = recvfrom(m_fd, pPkt->data(), pPkt->size(), MSG_DONTWAIT,
         (struct sockaddr *)&fromAddr, &fromLen);
     if (recvLen > 0)
     {
-        *msg = new UdpData_t;
-        BUFFER_CPY(&(*msg)->buf, s_recvBuf, recvLen);
-        (*msg)->connId                   = m_pollFdIndex;
-        (*msg)->peerEp.ipAddr.ipAddrType = IP_ADDR_TYPE_V4;
+        s_pRecvPkt = NULL;
+        *msg       = pPkt;
+        (*msg)->len                      = recvLen;
+        (*msg)->connId                   = m_connId;
+        (*msg)->peerEp.ipAddr.ipAddrType = IP_ADDR_TYPE_V6;
+        (*msg)->peerEp.ipAddr.u.ipv6Addr.len = IPV6_ADDR_MAX_LEN;
         MEMCPY((*msg)->peerEp.ipAddr.u.ipv6Addr.addr,
             fromAddr.sin6_addr.s6_addr, IPV6_ADDR_MAX_LEN);
         (*msg)->peerEp.port = ntohs(fromAddr.sin6_port);
         return ROK;
     }
+    else if (0 == recvLen)
+    {
+        /* an empty datagram is dropped, the buffer is kept for the next */
+        *msg = NULL;
+        return ROK;
+    }
 
     return RFAILED;
 }
 
-RETVAL GSimSocket::recvMsg(UdpData_t **msg)
+/**
+ * @brief
+ *    Reads upto receive batch size datagrams from the socket with a single
+ *    recvmmsg() system call, directly into the packet buffers of the
+ *    receive slots
+ *
+ * @param msgs
+ *    array of atleast receive batch size entries, filled with the
+ *    messages read
+ * @param numMsgs
+ *    number of messages read, the empty datagrams are dropped
+ * @param numRecvd
+ *    number of datagrams read, including the empty ones
+ *
+ * @return
+ *    ROK if atleast one datagram is read, RFAILED otherwise
+ */
+RETVAL GSimSocket::recvMsgBatch(PktBuf **msgs, U32 *numMsgs, U32 *numRecvd)
+{
+    LOG_ENTERFN();
+
+    *numMsgs  = 0;
+    *numRecvd = 0;
+    for (U32 i = 0; i < s_recvBatchSize; i++)
+    {
+        s_recvMmsgHdrs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        s_recvMmsgHdrs[i].msg_len             = 0;
+    }
+
+    S32 cnt = recvmmsg(m_fd, s_recvMmsgHdrs, s_recvBatchSize, MSG_DONTWAIT,
+        NULL);
+    if (cnt <= 0)
+    {
+        if ((cnt < 0) && (EAGAIN != errno) && (EWOULDBLOCK != errno))
+        {
+            LOG_ERROR("recvmmsg() failed, [%s]", strerror(errno));
+        }
+
+        LOG_EXITFN(RFAILED);
+    }
+
+    *numRecvd = cnt;
+    for (S32 i = 0; i < cnt; i++)
+    {
+        U32 recvLen = s_recvMmsgHdrs[i].msg_len;
+        if (0 == recvLen)
+        {
+            continue;
+        }
+
+        PktBuf *msg = s_recvSlots[i].pPkt;
+        msg->len    = recvLen;
+        msg->connId = m_connId;
+        sockAddrToEp(&s_recvSlots[i].fromAddr, &msg->peerEp);
+        msgs[(*numMsgs)++] = msg;
+        if (Pcap::isOpen())
+        {
+            Pcap::capture(&msg->peerEp, &m_ep, msg->data(), recvLen);
+        }
+
+        s_recvSlots[i].pPkt    = PktBuf::alloc();
+        s_recvIovs[i].iov_base = s_recvSlots[i].pPkt->data();
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Reads a datagram from the socket
+ *
+ * @param msg
+ *    message read, NULL if the datagram was empty and is dropped
+ *
+ * @return
+ *    ROK if a datagram is read, RFAILED otherwise
+ */
+RETVAL GSimSocket::recvMsg(PktBuf **msg)
 {
     LOG_ENTERFN();
 
@@ -125,6 +294,11 @@ RETVAL GSimSocket::recvMsg(UdpData_t **msg)
         ret = recvMsgV6(msg);
     }
 
+    if ((ROK == ret) && (NULL != *msg) && Pcap::isOpen())
+    {
+        Pcap::capture(&(*msg)->peerEp, &m_ep, (*msg)->data(), (*msg)->len);
+    }
+
     LOG_EXITFN(ret);
 }
 
@@ -141,250 +315,1017 @@ PRIVATE RETVAL sendMsgV4(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data)
 
     S32 ret = sendto(pSock->fd(), (VOID *)data->pVal, (size_t)data->len,
         MSG_DONTWAIT, (struct sockaddr *)&destAddr, sizeof(destAddr));
+    if ((ret >= 0) && Pcap::isOpen())
+    {
+        Pcap::capture(pSock->localEp(), pDst, data->pVal, data->len);
+    }
+
+    delete data;
+    if (ret < 0)
+    {
+        LOG_FATAL("Socket sendto() failed, [%s]", strerror(errno));
+        LOG_EXITFN(ERR_SYS_SOCK_SEND);
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+PRIVATE RETVAL sendMsgV6(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data)
+{
+    struct sockaddr_in6 destAddr;
+
+    MEMCPY(destAddr.sin6_addr.s6_addr, pDst->ipAddr.u.ipv6Addr.addr,
+        pDst->ipAddr.u.ipv6Addr.len);
+    destAddr.sin6_family = AF_INET6;
+    destAddr.sin6_port   = htons(pDst->port);
+
+    S32 ret = sendto(pSock->fd(), data->pVal, data->len, MSG_DONTWAIT,
+        (struct sockaddr *)&destAddr, sizeof(destAddr));
+    if ((ret >= 0) && Pcap::isOpen())
+    {
+        Pcap::capture(pSock->localEp(), pDst, data->pVal, data->len);
+    }
+
+    delete data;
     if (ret < 0)
     {
-        LOG_FATAL("Socket sendto() failed, [%s]", strerror(errno));
-        LOG_EXITFN(ERR_SYS_SOCK_SEND);
+        LOG_FATAL("Socket sendto() failed, [%s]", strerror(errno));
+        return ERR_SYS_SOCK_SEND;
+    }
+
+    return ROK;
+}
+
+/**
+ * @brief
+ *    Waits for the socket events and processes them
+ *
+ * @param wait
+ *    milli seconds to wait for an event, -1 waits until a socket or the
+ *    scheduler timer is ready
+ */
+PUBLIC VOID socketPoll(S32 wait)
+{
+    if (IO_BACKEND_EPOLL == s_ioBackend)
+    {
+        epollSockets(wait);
+    }
+    else
+    {
+        pollSockets(wait);
+    }
+
+    // write the responses queued while processing the received messages
+    flushSockets();
+
+    // an idle thread writes its captured messages once they are due
+    if (Pcap::isOpen())
+    {
+        Pcap::flushIfDue();
+    }
+}
+
+/**
+ * @brief
+ *    Arms the scheduler timer of the calling thread to expire once, a
+ *    socket poll waiting for events returns then
+ *
+ * @param wake
+ *    scheduler time in micro-seconds, later than now
+ * @param now
+ *    scheduler time in micro-seconds
+ */
+PUBLIC VOID setSchedTimer(Time_t wake, Time_t now)
+{
+    struct itimerspec expiry;
+    Time_t            wait = wake - now;
+
+    s_timerWake = wake;
+    MEMSET(&expiry, 0, sizeof(expiry));
+    expiry.it_value.tv_sec  = wait / 1000000;
+    expiry.it_value.tv_nsec = (wait % 1000000) * 1000;
+    if (timerfd_settime(s_pTimer->fd(), 0, &expiry, NULL) < 0)
+    {
+        LOG_ERROR("timerfd_settime() failed, [%s]", strerror(errno));
+    }
+}
+
+/**
+ * @brief
+ *    Processes the events reported on a socket
+ *
+ * @param pSock
+ * @param events
+ *    poll() event mask
+ *
+ * @return
+ *    TRUE if the socket is not drained and has to be read again
+ */
+PRIVATE BOOL handleSockEvents(GSimSocket *pSock, U32 events)
+{
+    BOOL more = FALSE;
+
+    if (GSIM_CHK_MASK(events, POLLOUT) && pSock->isTxBlocked())
+    {
+        /* socket send buffer has space again, write the messages
+         * left in the transmit queue
+         */
+        LOG_DEBUG("Writing GTP-C socket transmit queue");
+        pSock->flushTxQueue();
+    }
+
+    if (GSIM_CHK_MASK(events, POLLIN))
+    {
+        switch (pSock->type())
+        {
+        case SOCK_TYPE_GTPC:
+        {
+            LOG_DEBUG("Reading GTP-C socket");
+            more = handleGtpcSock(pSock);
+            break;
+        }
+
+        case SOCK_TYPE_GTPU:
+        {
+            LOG_DEBUG("Reading GTP-U socket");
+            RETVAL ret = handleGtpuSock(pSock);
+            if (ROK != ret)
+            {
+                LOG_ERROR("Reading GTP-U socket");
+            }
+
+            break;
+        }
+
+        case SOCK_TYPE_STDIN:
+        {
+            LOG_DEBUG("Reading Keyboard Event");
+            handleStdinSock(pSock);
+            break;
+        }
+
+        case SOCK_TYPE_TIMER:
+        {
+            handleTimerSock(pSock);
+            break;
+        }
+
+        case SOCK_TYPE_INBOX:
+        {
+            LOG_DEBUG("Reading Worker inbox");
+            procWorkerInbox();
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+        }
+    }
+    else if (GSIM_CHK_MASK(events, POLLERR))
+    {
+        LOG_FATAL("Socket Error, FD [%d]", pSock->fd());
+        delete pSock;
+    }
+
+    return more;
+}
+
+/**
+ * @brief
+ *    poll() backend, scans all the registered sockets
+ *
+ * @param wait
+ */
+PRIVATE VOID pollSockets(S32 wait)
+{
+    S32 rs; /* Number of sockets with events, returned by poll */
+
+    /* Get socket events. */
+    rs = poll(&s_pollFdArr[0], s_pollFdArr.size(), wait);
+    if ((rs < 0) && (errno == EINTR))
+    {
+        LOG_ERROR("poll() error, [%s]", strerror(errno));
+        return;
+    }
+
+    for (U32 pollIndx = 0; rs > 0 && pollIndx < s_pollFdArr.size();
+         pollIndx++)
+    {
+        U32 revents = s_pollFdArr[pollIndx].revents;
+        if (0 == revents)
+        {
+            continue;
+        }
+
+        rs--;
+        s_pollFdArr[pollIndx].revents = 0;
+
+        GSimSocket *pSock = s_sockArr[pollIndx];
+        if (NULL == pSock)
+        {
+            LOG_FATAL("Null Socket, Sock Array. Index [%d]", pollIndx);
+            continue;
+        }
+
+        // poll() is level triggered, a socket not drained is reported again
+        (VOID) handleSockEvents(pSock, revents);
+    }
+}
+
+/**
+ * @brief
+ *    epoll() backend. GTP-C sockets are edge triggered, a socket not
+ *    drained within the read budget is kept in the ready list and read
+ *    again in the next call without waiting for an event.
+ *
+ * @param wait
+ */
+PRIVATE VOID epollSockets(S32 wait)
+{
+    s_pendingConnIds.swap(s_readyConnIds);
+    for (U32 i = 0; i < s_pendingConnIds.size(); i++)
+    {
+        GSimSocket *pSock = s_sockArr[s_pendingConnIds[i]];
+        if (NULL != pSock)
+        {
+            pSock->m_readPending = FALSE;
+        }
+    }
+
+    if (!s_pendingConnIds.empty())
+    {
+        wait = 0;
+    }
+
+    S32 rs = epoll_wait(s_epollFd, s_epollEvents, GSIM_MAX_EPOLL_EVENTS, wait);
+    if ((rs < 0) && (errno != EINTR))
+    {
+        LOG_ERROR("epoll_wait() error, [%s]", strerror(errno));
+    }
+
+    for (S32 i = 0; i < rs; i++)
+    {
+        GSimSocket *pSock = s_sockArr[s_epollEvents[i].data.u32];
+        if (NULL == pSock)
+        {
+            continue;
+        }
+
+        U32 events = 0;
+        if (GSIM_CHK_MASK(s_epollEvents[i].events, EPOLLIN))
+        {
+            GSIM_SET_MASK(events, POLLIN);
+        }
+
+        if (GSIM_CHK_MASK(s_epollEvents[i].events, EPOLLOUT))
+        {
+            GSIM_SET_MASK(events, POLLOUT);
+        }
+
+        if (GSIM_CHK_MASK(s_epollEvents[i].events, EPOLLERR))
+        {
+            GSIM_SET_MASK(events, POLLERR);
+        }
+
+        if (handleSockEvents(pSock, events) && !pSock->m_readPending)
+        {
+            pSock->m_readPending = TRUE;
+            s_readyConnIds.push_back(pSock->connId());
+        }
+    }
+
+    for (U32 i = 0; i < s_pendingConnIds.size(); i++)
+    {
+        GSimSocket *pSock = s_sockArr[s_pendingConnIds[i]];
+        if ((NULL == pSock) || pSock->m_readPending)
+        {
+            continue;
+        }
+
+        if (handleSockEvents(pSock, POLLIN))
+        {
+            pSock->m_readPending = TRUE;
+            s_readyConnIds.push_back(pSock->connId());
+        }
+    }
+
+    s_pendingConnIds.clear();
+}
+
+/**
+ * @brief
+ *    Writes the transmit queue of the sockets with queued messages, which
+ *    are not waiting for the socket send buffer to drain
+ */
+PUBLIC VOID flushSockets()
+{
+    s_txFlushConnIds.swap(s_txConnIds);
+    for (U32 i = 0; i < s_txFlushConnIds.size(); i++)
+    {
+        GSimSocket *pSock = s_sockArr[s_txFlushConnIds[i]];
+
+        /* a blocked socket queue is written when the socket becomes
+         * writable
+         */
+        if ((NULL != pSock) && !pSock->isTxBlocked())
+        {
+            pSock->flushTxQueue();
+        }
+    }
+
+    s_txFlushConnIds.clear();
+}
+
+/**
+ * @brief
+ *    Handles keyboard event
+ *
+ * @param pSock
+ */
+PRIVATE VOID handleStdinSock(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    if (feof(stdin))
+    {
+        delete pSock;
+    }
+
+    S32 input = getchar();
+    if (input == EOF)
+    {
+        LOG_EXITVOID();
+    }
+    else
+    {
+        Keyboard::getInstance()->processKey(input);
+    }
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Hanldes GTP-C socket, reads GTP-C messages
+ *
+ * @param pSock
+ *
+ * @return
+ *    TRUE if the read budget is exhausted before the socket is drained
+ */
+PRIVATE BOOL handleGtpcSock(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    RETVAL ret   = ROK;
+    U32    loops = GSIM_MAX_RECV_LOOPS;
+
+    if (s_recvBatchSize > 1)
+    {
+        /* same bound on messages read per poll as the single message path,
+         * a batch of fewer datagrams than the batch size means the socket
+         * is drained
+         */
+        loops = GSIM_CEIL_DIVISION(GSIM_MAX_RECV_LOOPS, s_recvBatchSize);
+        while (loops)
+        {
+            U32 numMsgs  = 0;
+            U32 numRecvd = 0;
+            ret = pSock->recvMsgBatch(s_recvBatch, &numMsgs, &numRecvd);
+            if (ROK != ret)
+            {
+                break;
+            }
+
+            if (numMsgs > 0)
+            {
+                LOG_DEBUG("Process the Received messages [%d]", numMsgs);
+                procGtpcMsgBatch(s_recvBatch, numMsgs);
+            }
+
+            if (numRecvd < s_recvBatchSize)
+            {
+                break;
+            }
+
+            loops--;
+        }
+
+        LOG_EXITFN(0 == loops);
+    }
+
+    while (loops && (ROK == ret))
+    {
+        PktBuf *msg = NULL;
+        ret         = pSock->recvMsg(&msg);
+        if ((ROK == ret) && (NULL != msg))
+        {
+            LOG_DEBUG("Process the Received messages", pSock->fd());
+            procGtpcMsg(msg);
+        }
+
+        loops--;
+    };
+
+    LOG_EXITFN((0 == loops) && (ROK == ret));
+}
+
+/**
+ * @brief
+ *    Handles the scheduler timer expiry, the expired tasks are resumed by
+ *    the scheduler once the poll returns. The time the expiry is seen
+ *    after the time the timer was armed for is the timer jitter.
+ *
+ * @param pSock
+ */
+PRIVATE VOID handleTimerSock(GSimSocket *pSock)
+{
+    U64 expirations = 0;
+
+    if (read(pSock->fd(), &expirations, sizeof(expirations)) < 0)
+    {
+        if ((EAGAIN != errno) && (EWOULDBLOCK != errno))
+        {
+            LOG_ERROR("Reading timer, [%s]", strerror(errno));
+        }
+    }
+    else if (expirations > 0)
+    {
+        Time_t now = getSchedMicroSeconds();
+        getTimerStats()->jitter.record(
+            (now > s_timerWake) ? (now - s_timerWake) : 0);
+    }
+}
+
+/**
+ * @brief
+ *    Hanldes GTP-U socket, reads GTP-U Process control messages
+ *
+ * @param pSock
+ *
+ * @return
+ */
+PRIVATE RETVAL handleGtpuSock(GSimSocket *pSock)
+{
+    LOG_ENTERFN();
+
+    RETVAL ret = ROK;
+
+    LOG_EXITFN(ret);
+}
+
+/**
+ * @brief
+ *    Creates the epoll instance of the calling thread and the receive
+ *    slots, followed by the sockets
+ */
+PRIVATE RETVAL initSocketEvents(Config *pCfg)
+{
+    s_ioBackend = pCfg->getIoBackend();
+    if (IO_BACKEND_EPOLL == s_ioBackend)
+    {
+        s_epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (s_epollFd < 0)
+        {
+            LOG_FATAL("epoll_create1() failed, [%s]", strerror(errno));
+            return ERR_SYS_EPOLL_CREATE;
+        }
+    }
+
+    initRecvSlots(pCfg->getRecvBatchSize());
+    return ROK;
+}
+
+/**
+ * @brief
+ *    Creates the scheduler timer. The timer is armed by the scheduler to
+ *    wake up the socket poll when the next paused task is due.
+ */
+PRIVATE RETVAL createTimerSock()
+{
+    try
+    {
+        s_pTimer = new GSimSocket(SOCK_TYPE_TIMER);
+    }
+    catch (ErrCodeEn &e)
+    {
+        LOG_FATAL("Creating scheduler timer");
+        return e;
+    }
+
+    return ROK;
+}
+
+PUBLIC RETVAL initTransport()
+{
+    LOG_ENTERFN();
+
+    S16        ret = ROK;
+    IPEndPoint locListnerEp;
+    IPEndPoint locSenderEp;
+
+    Config *pCfg = Config::getInstance();
+
+    ret = initSocketEvents(pCfg);
+    if (ROK != ret)
+    {
+        LOG_EXITFN(ret);
+    }
+
+    /* Simulator sends all GTP messages with source udp port number as
+     * Default GTP port + 1, using this socket
+     */
+    locSenderEp.port   = 0;
+    locSenderEp.ipAddr = *pCfg->getLocalIpAddr();
+    s_pSender          = new GSimSocket(SOCK_TYPE_GTPC, locSenderEp);
+    ret                = s_pSender->bindSocket();
+    if (ROK != ret)
+    {
+        LOG_FATAL("Binding to GTP local sending Socket");
+        LOG_EXITFN(ret);
+    }
+
+    /* This is the default GTPC socket, where the simlator listens
+     * for initiating messages
+     */
+    locListnerEp.port   = pCfg->getLocalGtpcPort();
+    locListnerEp.ipAddr = *pCfg->getLocalIpAddr();
+    if (pCfg->getPipelineMode())
+    {
+        /* listener is read by the receive thread, the worker only
+         * sends the replies on it
+         */
+        s_pListener = new GSimSocket(SOCK_TYPE_GTPC, locListnerEp,
+            s_rxListenerFd);
+    }
+    else
+    {
+        s_pListener = new GSimSocket(SOCK_TYPE_GTPC, locListnerEp);
+        if (pCfg->getNumWorkers() > 1)
+        {
+            /* every worker listens on the GTP port, kernel distributes
+             * the received messages among the workers
+             */
+            ret = s_pListener->setReusePort();
+            if (ROK != ret)
+            {
+                LOG_FATAL("Setting GTP Listener Socket options");
+                LOG_EXITFN(ret);
+            }
+        }
+
+        ret = s_pListener->bindSocket();
+        if (ROK != ret)
+        {
+            LOG_FATAL("Binding to GTP Listener Socket");
+            LOG_EXITFN(ret);
+        }
+    }
+
+    ret = createTimerSock();
+
+    LOG_EXITFN(ret);
+}
+
+/**
+ * @brief
+ *    Creates the GTP-C listener socket read by the receive thread of the
+ *    pipeline mode, the socket is shared with the workers for sending
+ */
+PUBLIC RETVAL initRxTransport()
+{
+    LOG_ENTERFN();
+
+    S16        ret = ROK;
+    IPEndPoint locListnerEp;
+
+    Config *pCfg = Config::getInstance();
+
+    ret = initSocketEvents(pCfg);
+    if (ROK != ret)
+    {
+        LOG_EXITFN(ret);
+    }
+
+    locListnerEp.port   = pCfg->getLocalGtpcPort();
+    locListnerEp.ipAddr = *pCfg->getLocalIpAddr();
+    s_pListener         = new GSimSocket(SOCK_TYPE_GTPC, locListnerEp);
+    ret                 = s_pListener->bindSocket();
+    if (ROK != ret)
+    {
+        LOG_FATAL("Binding to GTP Listener Socket");
+        LOG_EXITFN(ret);
+    }
+
+    s_rxListenerFd = s_pListener->fd();
+
+    LOG_EXITFN(ret);
+}
+
+/**
+ * @brief
+ *    Connection id of the GTP-C listener socket of the calling thread
+ */
+PUBLIC TransConnId getListenerConnId()
+{
+    return s_pListener->connId();
+}
+
+/**
+ * @brief
+ *    Allocates the receive slots and links the recvmmsg() message headers
+ *    to them once, so that a batch receive does not allocate memory
+ *
+ * @param batchSize
+ */
+PRIVATE VOID initRecvSlots(U32 batchSize)
+{
+    LOG_ENTERFN();
+
+    s_recvBatchSize = batchSize;
+    if (s_recvBatchSize <= 1)
+    {
+        LOG_EXITVOID();
+    }
+
+    s_recvSlots    = new GSimRecvSlot[s_recvBatchSize];
+    s_recvMmsgHdrs = new struct mmsghdr[s_recvBatchSize];
+    s_recvIovs     = new struct iovec[s_recvBatchSize];
+    s_recvBatch    = new PktBuf *[s_recvBatchSize];
+
+    MEMSET(s_recvMmsgHdrs, 0, sizeof(struct mmsghdr) * s_recvBatchSize);
+    for (U32 i = 0; i < s_recvBatchSize; i++)
+    {
+        s_recvSlots[i].pPkt                   = PktBuf::alloc();
+        s_recvIovs[i].iov_base                = s_recvSlots[i].pPkt->data();
+        s_recvIovs[i].iov_len                 = s_recvSlots[i].pPkt->size();
+        s_recvMmsgHdrs[i].msg_hdr.msg_iov     = &s_recvIovs[i];
+        s_recvMmsgHdrs[i].msg_hdr.msg_iovlen  = 1;
+        s_recvMmsgHdrs[i].msg_hdr.msg_name    = &s_recvSlots[i].fromAddr;
+        s_recvMmsgHdrs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+    }
+
+    LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Converts the source address of a received datagram to IPEndPoint
+ *
+ * @param pAddr
+ * @param pEp
+ */
+PRIVATE VOID sockAddrToEp(const struct sockaddr_storage *pAddr,
+    IPEndPoint *pEp)
+{
+    if (AF_INET6 == pAddr->ss_family)
+    {
+        const struct sockaddr_in6 *pAddr6 =
+            (const struct sockaddr_in6 *)pAddr;
+        pEp->ipAddr.ipAddrType       = IP_ADDR_TYPE_V6;
+        pEp->ipAddr.u.ipv6Addr.len   = IPV6_ADDR_MAX_LEN;
+        MEMCPY(pEp->ipAddr.u.ipv6Addr.addr, pAddr6->sin6_addr.s6_addr,
+            IPV6_ADDR_MAX_LEN);
+        pEp->port = ntohs(pAddr6->sin6_port);
+    }
+    else
+    {
+        const struct sockaddr_in *pAddr4 = (const struct sockaddr_in *)pAddr;
+        pEp->ipAddr.ipAddrType           = IP_ADDR_TYPE_V4;
+        pEp->ipAddr.u.ipv4Addr.addr      = ntohl(pAddr4->sin_addr.s_addr);
+        pEp->port                        = ntohs(pAddr4->sin_port);
+    }
+}
+
+/**
+ * @brief
+ *    Converts the IPEndPoint to socket address
+ *
+ * @param pEp
+ * @param pAddr
+ *
+ * @return
+ *    length of the socket address
+ */
+PRIVATE socklen_t epToSockAddr(IPEndPoint *pEp, struct sockaddr_storage *pAddr)
+{
+    if (IP_ADDR_TYPE_V4 == pEp->ipAddr.ipAddrType)
+    {
+        struct sockaddr_in *pAddr4 = (struct sockaddr_in *)pAddr;
+        pAddr4->sin_addr.s_addr    = htonl(pEp->ipAddr.u.ipv4Addr.addr);
+        pAddr4->sin_family         = AF_INET;
+        pAddr4->sin_port           = htons(pEp->port);
+        MEMSET(pAddr4->sin_zero, '\0', sizeof(pAddr4->sin_zero));
+        return sizeof(struct sockaddr_in);
     }
 
-    delete data;
-    LOG_EXITFN(ROK);
+    struct sockaddr_in6 *pAddr6 = (struct sockaddr_in6 *)pAddr;
+    MEMSET(pAddr6, 0, sizeof(struct sockaddr_in6));
+    MEMCPY(pAddr6->sin6_addr.s6_addr, pEp->ipAddr.u.ipv6Addr.addr,
+        pEp->ipAddr.u.ipv6Addr.len);
+    pAddr6->sin6_family = AF_INET6;
+    pAddr6->sin6_port   = htons(pEp->port);
+    return sizeof(struct sockaddr_in6);
 }
 
-PRIVATE RETVAL sendMsgV6(GSimSocket *pSock, IPEndPoint *pDst, Buffer *data)
+/**
+ * @brief
+ *    Allocates the socket transmit queue, messages sent over the socket
+ *    are queued and written with a single sendmmsg() call when the
+ *    scheduler flushes the sockets or when the queue is full
+ *
+ * @param batchSize
+ */
+VOID GSimSocket::initTxQueue(U32 batchSize)
 {
-    struct sockaddr_in6 destAddr;
+    m_txBatchSize = batchSize;
+    m_txCnt       = 0;
+    m_txBlocked   = FALSE;
+    m_txSlots     = NULL;
+    m_txMsgs      = NULL;
+    m_txIovs      = NULL;
+
+    if (m_txBatchSize <= 1)
+    {
+        return;
+    }
 
-    MEMCPY(destAddr.sin6_addr.s6_addr, pDst->ipAddr.u.ipv6Addr.addr,
-        pDst->ipAddr.u.ipv6Addr.len);
-    destAddr.sin6_family = AF_INET6;
-    destAddr.sin6_port   = htons(pDst->port);
+    m_txSlots = new GSimTxSlot[m_txBatchSize];
+    m_txMsgs  = new struct mmsghdr[m_txBatchSize];
+    m_txIovs  = new struct iovec[m_txBatchSize];
 
-    if (sendto(pSock->fd(), data->pVal, data->len, MSG_DONTWAIT,
-            (struct sockaddr *)&destAddr, sizeof(destAddr)) > 0)
+    MEMSET(m_txMsgs, 0, sizeof(struct mmsghdr) * m_txBatchSize);
+    for (U32 i = 0; i < m_txBatchSize; i++)
     {
-        return ROK;
+        m_txSlots[i].pBuf             = NULL;
+        m_txMsgs[i].msg_hdr.msg_iov    = &m_txIovs[i];
+        m_txMsgs[i].msg_hdr.msg_iovlen = 1;
+        m_txMsgs[i].msg_hdr.msg_name   = &m_txSlots[i].dstAddr;
     }
-
-    delete data;
-    return RFAILED;
 }
 
-PUBLIC VOID socketPoll(S32 wait)
+/**
+ * @brief
+ *    Adds the message to the socket transmit queue, the queue is written
+ *    to the socket if it becomes full. The message buffer is owned by the
+ *    queue and freed once written.
+ *
+ * @param pDst
+ * @param data
+ *
+ * @return
+ *    ROK if the message is queued, ERR_SYS_SOCK_SEND if the queue is full
+ *    and the socket send buffer has no space
+ */
+RETVAL GSimSocket::queueMsg(IPEndPoint *pDst, Buffer *data)
 {
-    S32 rs; /* Number of times to execute recv().
-             * For TCP with 1 socket per call: no. of events returned by poll
-             * For UDP and TCP with 1 global socket:recv_count is a flag that
-             * stays up as long as there's data to read
-             */
-
-    /* Get socket events. */
-    rs = poll(s_pollFdArr, s_pollFdCnt, wait);
-    if ((rs < 0) && (errno == EINTR))
+    if (m_txCnt == m_txBatchSize)
     {
-        LOG_ERROR("poll() error, [%s]", strerror(errno));
-        return;
+        // queue is full only when the previous write was blocked
+        Stats::incStats(GSIM_STAT_NUM_SEND_DROPS);
+        delete data;
+        return ERR_SYS_SOCK_SEND;
     }
 
-    for (U32 pollIndx = 0; rs > 0 && pollIndx < s_pollFdCnt; pollIndx++)
+    if (0 == m_txCnt)
     {
-        GSimSocket *pSock = g_gsimSockArr[pollIndx];
+        s_txConnIds.push_back(m_connId);
+    }
 
-        if (NULL == pSock)
-        {
-            LOG_FATAL("Null Socket, Sock Array. Index [%d]", pollIndx);
-            continue;
-        }
+    GSimTxSlot *pSlot = &m_txSlots[m_txCnt++];
+    pSlot->pBuf       = data;
+    pSlot->dstAddrLen = epToSockAddr(pDst, &pSlot->dstAddr);
 
-        if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLOUT))
-        {
-            GSIM_UNSET_MASK(s_pollFdArr[pollIndx].events, POLLOUT);
-        }
+    if ((m_txCnt == m_txBatchSize) && !isTxBlocked())
+    {
+        flushTxQueue();
+    }
 
-        if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLIN))
-        {
-            rs--;
+    return ROK;
+}
 
-            switch (pSock->type())
-            {
-            case SOCK_TYPE_GTPC:
-            {
-                LOG_DEBUG("Reading GTP-C socket");
-                RETVAL ret = handleGtpcSock(pSock);
-                if (ROK != ret)
-                {
-                    LOG_ERROR("Reading GTP-C socket");
-                }
+/**
+ * @brief
+ *    Writes the queued messages with sendmmsg(). If the socket send buffer
+ *    is full the unsent messages are kept in the queue and POLLOUT is set
+ *    so that the queue is written once the socket becomes writable.
+ */
+VOID GSimSocket::flushTxQueue()
+{
+    if (0 == m_txCnt)
+    {
+        setTxBlocked(FALSE);
+        return;
+    }
 
-                break;
-            }
+    for (U32 i = 0; i < m_txCnt; i++)
+    {
+        m_txIovs[i].iov_base                = m_txSlots[i].pBuf->pVal;
+        m_txIovs[i].iov_len                 = m_txSlots[i].pBuf->len;
+        m_txMsgs[i].msg_hdr.msg_namelen     = m_txSlots[i].dstAddrLen;
+    }
 
-            case SOCK_TYPE_GTPU:
+    U32 sent = 0;
+    while (sent < m_txCnt)
+    {
+        S32 ret = sendmmsg(m_fd, &m_txMsgs[sent], m_txCnt - sent, MSG_DONTWAIT);
+        if (ret < 0)
+        {
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
             {
-                LOG_DEBUG("Reading GTP-U socket");
-                RETVAL ret = handleGtpuSock(pSock);
-                if (ROK != ret)
-                {
-                    LOG_ERROR("Reading GTP-U socket");
-                }
-
                 break;
             }
 
-            case SOCK_TYPE_STDIN:
-            {
-                LOG_DEBUG("Reading Keyboard Event");
-                handleStdinSock(pSock);
-                break;
-            }
+            /* the error is reported for the first message of the batch,
+             * drop it and write the rest
+             */
+            LOG_ERROR("Socket sendmmsg() failed, [%s]", strerror(errno));
+            Stats::incStats(GSIM_STAT_NUM_SEND_DROPS);
+            delete m_txSlots[sent].pBuf;
+            m_txSlots[sent].pBuf = NULL;
+            sent++;
+            continue;
+        }
 
-            default:
+        Stats::incStats(GSIM_STAT_NUM_SEND_BATCHES);
+        Stats::addStats(GSIM_STAT_NUM_SEND_MSGS, ret);
+        for (U32 i = sent; i < sent + ret; i++)
+        {
+            /* only the messages written are captured, not the dropped */
+            if (Pcap::isOpen())
             {
-                break;
+                IPEndPoint dst;
+                sockAddrToEp(&m_txSlots[i].dstAddr, &dst);
+                Pcap::capture(&m_ep, &dst, m_txSlots[i].pBuf->pVal,
+                    m_txSlots[i].pBuf->len);
             }
-            }
-        }
-        else if (GSIM_CHK_MASK(s_pollFdArr[pollIndx].revents, POLLERR))
-        {
-            LOG_FATAL("Socket Error, FD [%d]", pSock->fd());
-            delete pSock;
-        }
-
-        s_pollFdArr[pollIndx].revents = 0;
-    }
-}
 
-/**
- * @brief
- *    Handles keyboard event
- *
- * @param pSock
- */
-PRIVATE VOID handleStdinSock(GSimSocket *pSock)
-{
-    LOG_ENTERFN();
+            delete m_txSlots[i].pBuf;
+            m_txSlots[i].pBuf = NULL;
+        }
 
-    if (feof(stdin))
-    {
-        delete pSock;
+        sent += ret;
     }
 
-    S32 input = getchar();
-    if (input == EOF)
+    if (sent < m_txCnt)
     {
-        LOG_EXITVOID();
+        LOG_DEBUG("Socket send buffer full, [%d] messages pending",
+            m_txCnt - sent);
+        m_txCnt -= sent;
+        MEMMOVE(m_txSlots, &m_txSlots[sent], sizeof(GSimTxSlot) * m_txCnt);
+        if (!isTxBlocked())
+        {
+            Stats::incStats(GSIM_STAT_NUM_SEND_BLOCKED);
+            setTxBlocked(TRUE);
+        }
     }
     else
     {
-        Keyboard::getInstance()->processKey(input);
+        m_txCnt = 0;
+        setTxBlocked(FALSE);
     }
+}
 
-    LOG_EXITVOID();
+BOOL GSimSocket::isTxBlocked()
+{
+    return m_txBlocked;
 }
 
 /**
  * @brief
- *    Hanldes GTP-C socket, reads GTP-C messages
- *
- * @param pSock
+ *    Adds or removes the interest in the socket becoming writable
  *
- * @return
+ * @param blocked
  */
-PRIVATE RETVAL handleGtpcSock(GSimSocket *pSock)
+VOID GSimSocket::setTxBlocked(BOOL blocked)
 {
-    LOG_ENTERFN();
-
-    RETVAL ret   = ROK;
-    U32    loops = GSIM_MAX_RECV_LOOPS;
+    if (blocked == m_txBlocked)
+    {
+        return;
+    }
 
-    while (loops && (ROK == ret))
+    m_txBlocked = blocked;
+    if (IO_BACKEND_EPOLL == s_ioBackend)
     {
-        UdpData_t *msg = NULL;
-        ret            = pSock->recvMsg(&msg);
-        if (ROK == ret)
+        struct epoll_event ev;
+        ev.events   = m_txOnly ? EPOLLET : (EPOLLIN | EPOLLET);
+        ev.data.u32 = m_connId;
+        if (blocked)
         {
-            LOG_DEBUG("Process the Received messages", pSock->fd());
-            procGtpcMsg(msg);
+            GSIM_SET_MASK(ev.events, EPOLLOUT);
         }
 
-        loops--;
-    };
-
-    LOG_EXITFN(ROK);
+        if (epoll_ctl(s_epollFd, EPOLL_CTL_MOD, m_fd, &ev) < 0)
+        {
+            LOG_ERROR("epoll_ctl() failed, FD [%d], [%s]", m_fd,
+                strerror(errno));
+        }
+    }
+    else if (blocked)
+    {
+        GSIM_SET_MASK(s_pollFdArr[m_connId].events, POLLOUT);
+    }
+    else
+    {
+        GSIM_UNSET_MASK(s_pollFdArr[m_connId].events, POLLOUT);
+    }
 }
 
 /**
  * @brief
- *    Hanldes GTP-U socket, reads GTP-U Process control messages
+ *    Adds the socket to the registry and to the epoll set, a free
+ *    connection id is reused
  *
  * @param pSock
+ * @param events
+ *    epoll events the socket is registered for
  *
  * @return
+ *    connection id of the socket
  */
-PRIVATE RETVAL handleGtpuSock(GSimSocket *pSock)
-{
-    LOG_ENTERFN();
-
-    RETVAL ret = ROK;
-
-    LOG_EXITFN(ret);
-}
-
-PUBLIC RETVAL initTransport()
+PRIVATE TransConnId registerSocket(GSimSocket *pSock, U32 events)
 {
-    LOG_ENTERFN();
-
-    S16        ret = ROK;
-    IPEndPoint locListnerEp;
-    IPEndPoint locSenderEp;
+    TransConnId connId;
 
-    Config *pCfg = Config::getInstance();
+    if (s_freeConnIds.empty())
+    {
+        connId = s_sockArr.size();
+        s_sockArr.push_back(NULL);
+        s_pollFdArr.push_back(GSimPollFd());
+    }
+    else
+    {
+        connId = s_freeConnIds.back();
+        s_freeConnIds.pop_back();
+    }
 
-    for (U32 i = 0; i < GSIM_MAX_POLL_FDS; i++)
+    s_sockArr[connId]           = pSock;
+    s_pollFdArr[connId].fd      = pSock->fd();
+    s_pollFdArr[connId].events  = POLLERR;
+    s_pollFdArr[connId].revents = 0;
+    if (GSIM_CHK_MASK(events, EPOLLIN))
     {
-        s_pollFdArr[i].fd = -1;
+        GSIM_SET_MASK(s_pollFdArr[connId].events, POLLIN);
     }
 
-    /* Simulator sends all GTP messages with source udp port number as
-     * Default GTP port + 1, using this socket
-     */
-    locSenderEp.port   = 0;
-    locSenderEp.ipAddr = *pCfg->getLocalIpAddr();
-    s_pSender          = new GSimSocket(SOCK_TYPE_GTPC, locSenderEp);
-    ret                = s_pSender->bindSocket();
-    if (ROK != ret)
+    if (IO_BACKEND_EPOLL == s_ioBackend)
     {
-        LOG_FATAL("Binding to GTP local sending Socket");
-        LOG_EXITFN(ret);
+        struct epoll_event ev;
+        ev.events   = events;
+        ev.data.u32 = connId;
+        if (epoll_ctl(s_epollFd, EPOLL_CTL_ADD, pSock->fd(), &ev) < 0)
+        {
+            LOG_ERROR("epoll_ctl() failed, FD [%d], [%s]", pSock->fd(),
+                strerror(errno));
+        }
     }
 
-    /* This is the default GTPC socket, where the simlator listens
-     * for initiating messages
-     */
-    locListnerEp.port   = pCfg->getLocalGtpcPort();
-    locListnerEp.ipAddr = *pCfg->getLocalIpAddr();
-    s_pListener         = new GSimSocket(SOCK_TYPE_GTPC, locListnerEp);
-    ret                 = s_pListener->bindSocket();
-    if (ROK != ret)
+    return connId;
+}
+
+PRIVATE VOID unregisterSocket(GSimSocket *pSock)
+{
+    TransConnId connId = pSock->connId();
+
+    if (IO_BACKEND_EPOLL == s_ioBackend)
     {
-        LOG_FATAL("Binding to GTP Listener Socket");
-        LOG_EXITFN(ret);
+        epoll_ctl(s_epollFd, EPOLL_CTL_DEL, pSock->fd(), NULL);
     }
 
-    LOG_EXITFN(ROK);
+    s_sockArr[connId]           = NULL;
+    s_pollFdArr[connId].fd      = -1;
+    s_pollFdArr[connId].events  = 0;
+    s_pollFdArr[connId].revents = 0;
+    s_freeConnIds.push_back(connId);
 }
 
 GSimSocket::GSimSocket(SockType_t sockType)
 {
+    initTxQueue(1);
+    m_type        = sockType;
+    m_txOnly      = FALSE;
+    m_readPending = FALSE;
+
     if (SOCK_TYPE_STDIN == sockType)
     {
-        m_fd                               = fileno(stdin);
-        m_type                             = sockType;
-        m_pollFdIndex                      = s_pollFdCnt++;
-        g_gsimSockArr[m_pollFdIndex]       = this;
-        s_pollFdArr[m_pollFdIndex].fd      = m_fd;
-        s_pollFdArr[m_pollFdIndex].events  = POLLIN | POLLERR;
-        s_pollFdArr[m_pollFdIndex].revents = 0;
+        /* keyboard input is read a character at a time through stdio,
+         * keep it level triggered
+         */
+        m_fd     = fileno(stdin);
+        m_connId = registerSocket(this, EPOLLIN);
+    }
+    else if (SOCK_TYPE_TIMER == sockType)
+    {
+        m_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (m_fd < 0)
+        {
+            LOG_FATAL("timerfd_create() failed, [%s]", strerror(errno));
+            throw ERR_SYS_TIMER_CREATE;
+        }
+
+        m_connId = registerSocket(this, EPOLLIN | EPOLLET);
     }
     else
     {
@@ -417,13 +1358,12 @@ GSimSocket::GSimSocket(SockType_t sockType, IPEndPoint ep)
             throw ERR_SYS_SOCK_CNTRL;
         }
 
-        m_type                             = sockType;
-        m_pollFdIndex                      = s_pollFdCnt++;
-        m_ep                               = ep;
-        g_gsimSockArr[m_pollFdIndex]       = this;
-        s_pollFdArr[m_pollFdIndex].fd      = m_fd;
-        s_pollFdArr[m_pollFdIndex].events  = POLLIN | POLLERR;
-        s_pollFdArr[m_pollFdIndex].revents = 0;
+        initTxQueue(Config::getInstance()->getSendBatchSize());
+        m_type        = sockType;
+        m_ep          = ep;
+        m_txOnly      = FALSE;
+        m_readPending = FALSE;
+        m_connId      = registerSocket(this, EPOLLIN | EPOLLET);
 
         U32 sockRecvBuf = GSIM_MAX_SOCKET_RECV_BUF;
         if (setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &sockRecvBuf,
@@ -433,7 +1373,7 @@ GSimSocket::GSimSocket(SockType_t sockType, IPEndPoint ep)
         }
 
         U32 sockSendBuf = GSIM_MAX_SOCKET_SEND_BUF;
-        if (setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &sockSendBuf,
+        if (setsockopt(m_fd, SOL_SOCKET, SO_SNDBUF, &sockSendBuf,
                 sizeof(sockSendBuf)) < 0)
         {
             LOG_ERROR("setsockopt() Failed, [%s]", strerror(errno));
@@ -445,16 +1385,80 @@ GSimSocket::GSimSocket(SockType_t sockType, IPEndPoint ep)
     }
 }
 
+/**
+ * @brief
+ *    Wraps a GTP-C socket read by another thread, used only for writing
+ *    the transmit queue of the calling thread. The fd is not closed when
+ *    the socket is deleted.
+ *
+ * @param sockType
+ * @param ep
+ * @param fd
+ */
+GSimSocket::GSimSocket(SockType_t sockType, IPEndPoint ep, S32 fd)
+{
+    if (SOCK_TYPE_GTPC != sockType)
+    {
+        throw ERR_INV_SOCKET_TYPE;
+    }
+
+    initTxQueue(Config::getInstance()->getSendBatchSize());
+    m_type        = sockType;
+    m_fd          = fd;
+    m_ep          = ep;
+    m_txOnly      = TRUE;
+    m_readPending = FALSE;
+    m_connId      = registerSocket(this, EPOLLET);
+}
+
+/**
+ * @brief
+ *    Wraps an event fd created by the caller, the fd is not closed when
+ *    the socket is deleted
+ *
+ * @param sockType
+ * @param fd
+ */
+GSimSocket::GSimSocket(SockType_t sockType, S32 fd)
+{
+    if (SOCK_TYPE_INBOX != sockType)
+    {
+        throw ERR_INV_SOCKET_TYPE;
+    }
+
+    initTxQueue(1);
+    m_type        = sockType;
+    m_fd          = fd;
+    m_txOnly      = FALSE;
+    m_readPending = FALSE;
+    m_connId      = registerSocket(this, EPOLLIN | EPOLLET);
+}
+
 S32 GSimSocket::fd()
 {
     return m_fd;
 }
 
+TransConnId GSimSocket::connId()
+{
+    return m_connId;
+}
+
 IpAddrTypeEn GSimSocket::ipAddrType()
 {
     return m_ep.ipAddr.ipAddrType;
 }
 
+/**
+ * @brief
+ *    Local end point of the socket, the port is the one picked by the
+ *    kernel for a socket bound to port 0
+ */
+const IPEndPoint *GSimSocket::localEp()
+{
+    return &m_ep;
+}
+
 SockType_t GSimSocket::type()
 {
     return m_type;
@@ -464,10 +1468,21 @@ GSimSocket::~GSimSocket()
 {
     LOG_DEBUG("Deallocating socket, Sock FD [%d]", m_fd);
 
-    s_pollFdCnt--;
-    s_pollFdArr[m_pollFdIndex].fd = 0;
-    g_gsimSockArr[m_pollFdIndex]  = NULL;
-    close(m_fd);
+    for (U32 i = 0; i < m_txCnt; i++)
+    {
+        delete m_txSlots[i].pBuf;
+    }
+
+    delete[] m_txSlots;
+    delete[] m_txMsgs;
+    delete[] m_txIovs;
+
+    unregisterSocket(this);
+    if ((SOCK_TYPE_STDIN != m_type) && (SOCK_TYPE_INBOX != m_type) &&
+        !m_txOnly)
+    {
+        close(m_fd);
+    }
 }
 
 RETVAL GSimSocket::bindSocket()
@@ -506,6 +1521,31 @@ RETVAL GSimSocket::bindSocket()
         return ERR_SYS_SOCKET_BIND;
     }
 
+    if (0 == m_ep.port)
+    {
+        struct sockaddr_storage bindAddr;
+        socklen_t               bindLen = sizeof(bindAddr);
+        IPEndPoint              bindEp;
+
+        if (0 == getsockname(m_fd, (struct sockaddr *)&bindAddr, &bindLen))
+        {
+            sockAddrToEp(&bindAddr, &bindEp);
+            m_ep.port = bindEp.port;
+        }
+    }
+
+    return ROK;
+}
+
+RETVAL GSimSocket::setReusePort()
+{
+    S32 reuse = 1;
+    if (setsockopt(m_fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0)
+    {
+        LOG_FATAL("setsockopt() Failed, [%s]", strerror(errno));
+        return ERR_SYS_SOCK_CNTRL;
+    }
+
     return ROK;
 }
 
@@ -538,10 +1578,14 @@ PUBLIC RETVAL sendMsg(TransConnId connId, IPEndPoint *pDst, Buffer *data)
 
     RETVAL ret = ROK;
 
-    GSimSocket *pSock = g_gsimSockArr[connId];
+    GSimSocket *pSock = (connId < s_sockArr.size()) ? s_sockArr[connId] : NULL;
     if (NULL != pSock)
     {
-        if (pDst->ipAddr.ipAddrType == IP_ADDR_TYPE_V4)
+        if (Config::getInstance()->getSendBatchSize() > 1)
+        {
+            ret = pSock->queueMsg(pDst, data);
+        }
+        else if (pDst->ipAddr.ipAddrType == IP_ADDR_TYPE_V4)
         {
             ret = sendMsgV4(pSock, pDst, data);
         }
@@ -553,3 +1597,29 @@ PUBLIC RETVAL sendMsg(TransConnId connId, IPEndPoint *pDst, Buffer *data)
 
     LOG_EXITFN(ret);
 }
+
+/**
+ * @brief
+ *    Registers the inbox event fd of the calling worker, messages handed
+ *    over by the other workers are processed when the event fd is readable
+ *
+ * @param fd
+ */
+PUBLIC RETVAL setupInboxSock(S32 fd)
+{
+    LOG_ENTERFN();
+
+    S16 ret = ROK;
+
+    try
+    {
+        GSimSocket *pInboxSock = new GSimSocket(SOCK_TYPE_INBOX, fd);
+        (VOID) pInboxSock;
+    }
+    catch (ErrCodeEn &e)
+    {
+        ret = ERR_SOCK_ALLOC;
+    }
+
+    LOG_EXITFN(ret);
+}
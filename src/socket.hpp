@@ -21,10 +21,8 @@
 #include <sys/socket.h>
 #include <arpa/inet.h>
 
-#define GSIM_UDP_READ_LEN        2048
 #define GTP_HDR_PEEK_LEN         4
-#define GSIM_MAX_SOCK_CNT        3
-#define GSIM_MAX_POLL_FDS        32
+#define GSIM_MAX_EPOLL_EVENTS    256
 #define GSIM_MAX_RECV_LOOPS      1000
 #define GSIM_MAX_SOCKET_RECV_BUF (1 << 20)
 #define GSIM_MAX_SOCKET_SEND_BUF (1 << 20)
@@ -36,31 +34,79 @@ typedef enum
    SOCK_TYPE_GTPC,
    SOCK_TYPE_GTPU,
    SOCK_TYPE_GTPU_CTRL,
+   SOCK_TYPE_TIMER,
+   SOCK_TYPE_INBOX,
    SOCK_TYPE_MAX
 } SockType_t;
 
 typedef struct pollfd   GSimPollFd;
 
+class PktBuf;
+
+/* A receive slot is a packet buffer and source address filled by a single
+ * recvmmsg() call, one slot per datagram of the batch. The buffer of a
+ * filled slot is handed out and replaced with a new buffer from the pool.
+ */
+typedef struct
+{
+   PktBuf                 *pPkt;
+   struct sockaddr_storage fromAddr;
+} GSimRecvSlot;
+
+/* A transmit slot holds a queued datagram and its destination address
+ * until the socket transmit queue is written with sendmmsg()
+ */
+typedef struct
+{
+   Buffer                 *pBuf;
+   struct sockaddr_storage dstAddr;
+   socklen_t               dstAddrLen;
+} GSimTxSlot;
+
 class GSimSocket
 {
    public:
       GSimSocket(SockType_t);
       GSimSocket(SockType_t, IPEndPoint);
+      GSimSocket(SockType_t, S32 fd);
+      GSimSocket(SockType_t, IPEndPoint, S32 fd);
       ~GSimSocket();
 
       S32               fd();
+      TransConnId       connId();
       SockType_t        type();
       IpAddrTypeEn      ipAddrType();
+      const IPEndPoint *localEp();
       RETVAL            bindSocket();
-      RETVAL            recvMsg(UdpData_t **msg);
+      RETVAL            setReusePort();
+      RETVAL            recvMsg(PktBuf **msg);
+      RETVAL            recvMsgBatch(PktBuf **msgs, U32 *numMsgs,
+                           U32 *numRecvd);
+      RETVAL            queueMsg(IPEndPoint *pDst, Buffer *data);
+      VOID              flushTxQueue();
+      BOOL              isTxBlocked();
+
+      /* set when the socket is not drained by an edge triggered read
+       * and has to be read again without waiting for a new event
+       */
+      BOOL              m_readPending;
 
    private:
       S32               m_fd;
-      U32               m_pollFdIndex;
+      TransConnId       m_connId;
       SockType_t        m_type;
       IPEndPoint        m_ep;
-      RETVAL            recvMsgV6(UdpData_t **msg);
-      RETVAL            recvMsgV4(UdpData_t **msg);
+      BOOL              m_txBlocked;
+      BOOL              m_txOnly;
+      U32               m_txBatchSize;
+      U32               m_txCnt;
+      GSimTxSlot       *m_txSlots;
+      struct mmsghdr   *m_txMsgs;
+      struct iovec     *m_txIovs;
+      VOID              initTxQueue(U32 batchSize);
+      VOID              setTxBlocked(BOOL blocked);
+      RETVAL            recvMsgV6(PktBuf **msg);
+      RETVAL            recvMsgV4(PktBuf **msg);
 };
 
 #endif
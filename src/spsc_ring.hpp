@@ -0,0 +1,134 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SPSC_RING_HPP_
+#define _SPSC_RING_HPP_
+
+#include <atomic>
+
+#include "types.hpp"
+
+#define GSIM_CACHE_LINE_SIZE  64
+
+/* Bounded lock free ring, hands over items from exactly one producer
+ * thread to exactly one consumer thread. Size of the ring is a power of
+ * two and the head and tail are free running counters, so a full ring is
+ * told apart from an empty ring without a spare slot.
+ *
+ * The producer keeps a cached copy of the head and the consumer a cached
+ * copy of the tail, the shared counters are read only when the cached
+ * copy says the ring is full or empty.
+ */
+template <typename T>
+class SpscRing
+{
+   public:
+      SpscRing(U32 size)
+      {
+         m_size      = size;
+         m_mask      = size - 1;
+         m_slots     = new T[size];
+         m_head      = 0;
+         m_tail      = 0;
+         m_headCache = 0;
+         m_tailCache = 0;
+      }
+
+      ~SpscRing()
+      {
+         delete[] m_slots;
+      }
+
+      /**
+       * @brief
+       *    Adds an item at the tail, called only by the producer
+       *
+       * @return
+       *    FALSE if the ring is full
+       */
+      BOOL push(T item)
+      {
+         U32 tail = m_tail.load(std::memory_order_relaxed);
+         if ((tail - m_headCache) == m_size)
+         {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if ((tail - m_headCache) == m_size)
+            {
+               return FALSE;
+            }
+         }
+
+         m_slots[tail & m_mask] = item;
+         m_tail.store(tail + 1, std::memory_order_release);
+         return TRUE;
+      }
+
+      /**
+       * @brief
+       *    Removes the item at the head, called only by the consumer
+       *
+       * @return
+       *    FALSE if the ring is empty
+       */
+      BOOL pop(T *pItem)
+      {
+         U32 head = m_head.load(std::memory_order_relaxed);
+         if (head == m_tailCache)
+         {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tailCache)
+            {
+               return FALSE;
+            }
+         }
+
+         *pItem = m_slots[head & m_mask];
+         m_head.store(head + 1, std::memory_order_release);
+         return TRUE;
+      }
+
+      /* number of items in the ring, approximate when read by a thread
+       * other than the producer and the consumer
+       */
+      U32 size()
+      {
+         return m_tail.load(std::memory_order_acquire) -
+            m_head.load(std::memory_order_acquire);
+      }
+
+      U32 capacity()
+      {
+         return m_size;
+      }
+
+   private:
+      U32                 m_size;
+      U32                 m_mask;
+      T                  *m_slots;
+
+      /* consumer and producer counters are kept in separate cache lines,
+       * so that the two threads do not write the same cache line
+       */
+      U8                  m_pad0[GSIM_CACHE_LINE_SIZE];
+      std::atomic<U32>    m_head;
+      U32                 m_tailCache;
+      U8                  m_pad1[GSIM_CACHE_LINE_SIZE];
+      std::atomic<U32>    m_tail;
+      U32                 m_headCache;
+      U8                  m_pad2[GSIM_CACHE_LINE_SIZE];
+};
+
+#endif
@@ -0,0 +1,521 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <sys/time.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <ctype.h>
+#include <vector>
+#include <list>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "timer.hpp"
+#include "gtp_types.hpp"
+#include "sim_cfg.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "procedure.hpp"
+#include "scenario.hpp"
+#include "gtp_stats.hpp"
+#include "thread.hpp"
+#include "stats_export.hpp"
+
+/* longest sleep of the export thread, so that it stops soon after it is
+ * asked to
+ */
+#define STATS_EXPORT_POLL_INTVL  10000   /* micro-seconds */
+#define STATS_EXPORT_BUF_SIZE    65536
+#define STATS_EXPORT_LINE_LEN    512
+
+typedef struct
+{
+    GtpStat_t   stat;
+    const S8   *name;
+    BOOL        rate;  /* rate since the previous sample is exported */
+} ExportStat;
+
+/* session counters exported, the active sessions, the offered rate, the
+ * outstanding requests and their window are gauges
+ */
+static const ExportStat s_exportStats[] = {
+    {GSIM_STAT_OFFERED_RATE, "offered_rate", FALSE},
+    {GSIM_STAT_NUM_PENDING_REQS, "outstanding", FALSE},
+    {GSIM_STAT_CONC_WINDOW, "window", FALSE},
+    {GSIM_STAT_NUM_REQ_TIMEOUTS, "req_timeouts", TRUE},
+    {GSIM_STAT_NUM_SESSIONS_CREATED, "created", TRUE},
+    {GSIM_STAT_NUM_SESSIONS, "active", FALSE},
+    {GSIM_STAT_NUM_SESSIONS_SUCC, "completed", TRUE},
+    {GSIM_STAT_NUM_SESSIONS_FAIL, "aborted", TRUE},
+    {GSIM_STAT_UNEXCEPTED_MSG_RECD, "unexpected", FALSE},
+    {GSIM_STAT_NUM_DEADCALLS, "dead_calls", FALSE},
+    {GSIM_STAT_NUM_INVALID_MSGS, "malformed_msgs", FALSE},
+    {GSIM_STAT_NUM_SEND_DROPS, "send_drops", FALSE},
+    {GSIM_STAT_NUM_HANDOFF_DROPS, "ring_drops", FALSE},
+};
+
+#define STATS_EXPORT_NUM_STATS  (sizeof(s_exportStats) / sizeof(ExportStat))
+
+/* percentiles of the response times exported */
+static const double s_exportPcts[]     = {50, 90, 99, 99.9};
+static const S8    *s_exportPctNames[] = {"p50", "p90", "p99", "p999"};
+
+#define STATS_EXPORT_NUM_PCTS   (sizeof(s_exportPcts) / sizeof(double))
+
+PRIVATE VOID appendf(std::string *pOut, const S8 *pFmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+PRIVATE VOID appendf(std::string *pOut, const S8 *pFmt, ...)
+{
+    S8      line[STATS_EXPORT_LINE_LEN];
+    va_list args;
+
+    va_start(args, pFmt);
+    vsnprintf(line, sizeof(line), pFmt, args);
+    va_end(args);
+
+    pOut->append(line);
+}
+
+PRIVATE double getRate(Counter curr, Counter last, Time_t intvl)
+{
+    if (0 == intvl)
+    {
+        return 0;
+    }
+
+    return (double)(Counter)(curr - last) * 1000000.0 / intvl;
+}
+
+StatsExport::StatsExport()
+{
+    Config *pCfg = Config::getInstance();
+
+    m_stop     = false;
+    m_pFile    = NULL;
+    m_fileName = pCfg->getStatsFile();
+    m_format   = pCfg->getStatsFormat();
+    m_intvl    = (Time_t)pCfg->getStatsInterval() * 1000;
+    m_maxSize  = (U64)pCfg->getStatsFileSize() * 1024 * 1024;
+    m_size     = 0;
+    m_lastTime = 0;
+    MEMSET(m_last, 0, sizeof(m_last));
+    m_lastTimer.jitter.reset();
+    m_lastTimer.lag.reset();
+}
+
+StatsExport::~StatsExport()
+{
+    for (U32 i = 0; i < m_jobs.size(); i++)
+    {
+        delete m_jobs[i];
+    }
+
+    if (NULL != m_pFile)
+    {
+        fclose(m_pFile);
+    }
+}
+
+/**
+ * @brief
+ *    Opens the statistics file and starts the export thread, once the
+ *    scenario is loaded
+ *
+ * @return
+ *    ERR_STATS_FILE_OPEN if the file cannot be created
+ */
+RETVAL StatsExport::startExport()
+{
+    LOG_ENTERFN();
+
+    ProcSequence *procSeq = &(Scenario::getInstance()->m_procSeq);
+    for (U32 i = 0; i < procSeq->size(); i++)
+    {
+        Procedure *proc = procSeq->at(i);
+        addJob(i, proc->m_initial);
+        addJob(i, proc->m_trigMsg);
+        addJob(i, proc->m_trigReply);
+    }
+
+    if (ROK != openFile())
+    {
+        LOG_EXITFN(ERR_STATS_FILE_OPEN);
+    }
+
+    m_lastTime = getMicroSeconds();
+    if (0 != start(NULL))
+    {
+        LOG_EXITFN(ERR_THREAD_CREATE);
+    }
+
+    LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Stops the export thread and writes the last sample, called when the
+ *    simulator is stopped and before the worker threads exit
+ */
+VOID StatsExport::stopExport()
+{
+    m_stop.store(true, std::memory_order_release);
+    join();
+
+    sample();
+    fflush(m_pFile);
+}
+
+VOID StatsExport::run(VOID *arg)
+{
+    Time_t next = m_lastTime + m_intvl;
+
+    while (!m_stop.load(std::memory_order_acquire))
+    {
+        Time_t now = getMicroSeconds();
+        if (now < next)
+        {
+            Time_t wait = next - now;
+            usleep((wait < STATS_EXPORT_POLL_INTVL) ? wait
+                                                    : STATS_EXPORT_POLL_INTVL);
+            continue;
+        }
+
+        sample();
+
+        /* samples missed by a stalled thread are not made up for */
+        next += m_intvl;
+        if (next <= now)
+        {
+            next = now + m_intvl;
+        }
+    }
+}
+
+VOID StatsExport::addJob(U32 procIdx, Job *pJob)
+{
+    if ((NULL == pJob) || (JOB_TYPE_WAIT == pJob->type()))
+    {
+        return;
+    }
+
+    ExportJob *pExpJob = new ExportJob;
+    pExpJob->pJob      = pJob;
+    pExpJob->procIdx   = procIdx;
+    pExpJob->latency   = (JOB_TYPE_SEND == pJob->type()) &&
+                       (pJob == Scenario::getInstance()->m_procSeq.at(procIdx)
+                                    ->m_initial);
+    MEMSET(&pExpJob->last, 0, sizeof(JobStats));
+
+    /* p<procedure>_<message name>, in lower case without spaces */
+    pExpJob->name = "p" + std::to_string(procIdx) + "_";
+    for (const S8 *p = pJob->m_msgName; *p != '\0'; p++)
+    {
+        pExpJob->name += isalnum(*p) ? (S8)tolower(*p) : '_';
+    }
+
+    m_jobs.push_back(pExpJob);
+}
+
+/**
+ * @brief
+ *    Creates the statistics file, a CSV file starts with the column names
+ */
+RETVAL StatsExport::openFile()
+{
+    m_pFile = fopen(m_fileName.c_str(), "w");
+    if (NULL == m_pFile)
+    {
+        LOG_ERROR("Opening statistics file [%s]", m_fileName.c_str());
+        return RFAILED;
+    }
+
+    setvbuf(m_pFile, NULL, _IOFBF, STATS_EXPORT_BUF_SIZE);
+    m_size = 0;
+
+    if (STATS_FORMAT_CSV == m_format)
+    {
+        std::string header;
+        fmtCsvHeader(&header);
+        fwrite(header.data(), 1, header.size(), m_pFile);
+        m_size = header.size();
+    }
+
+    return ROK;
+}
+
+/**
+ * @brief
+ *    Moves the statistics file to <file>.1, and the earlier rotated files
+ *    one suffix up, the oldest file is removed
+ */
+VOID StatsExport::rotateFile()
+{
+    fclose(m_pFile);
+    m_pFile = NULL;
+
+    for (U32 i = DFLT_STATS_FILE_ROTATIONS; i > 1; i--)
+    {
+        std::string from = m_fileName + "." + std::to_string(i - 1);
+        std::string to   = m_fileName + "." + std::to_string(i);
+        rename(from.c_str(), to.c_str());
+    }
+
+    rename(m_fileName.c_str(), (m_fileName + ".1").c_str());
+    if (ROK != openFile())
+    {
+        LOG_ERROR("Statistics export stopped");
+    }
+}
+
+/**
+ * @brief
+ *    Writes a sample of the statistics and flushes it, so that the file
+ *    can be followed while the simulator runs
+ */
+VOID StatsExport::sample()
+{
+    if (NULL == m_pFile)
+    {
+        return;
+    }
+
+    Time_t now   = getMicroSeconds();
+    Time_t intvl = now - m_lastTime;
+
+    std::string line;
+    if (STATS_FORMAT_CSV == m_format)
+    {
+        fmtCsv(&line, intvl);
+    }
+    else
+    {
+        fmtJson(&line, intvl);
+    }
+
+    m_lastTime = now;
+    fwrite(line.data(), 1, line.size(), m_pFile);
+    fflush(m_pFile);
+
+    m_size += line.size();
+    if (m_size >= m_maxSize)
+    {
+        rotateFile();
+    }
+}
+
+VOID StatsExport::fmtCsvHeader(std::string *pOut)
+{
+    pOut->append("time_ms,interval_ms");
+    for (U32 i = 0; i < STATS_EXPORT_NUM_STATS; i++)
+    {
+        appendf(pOut, ",%s", s_exportStats[i].name);
+        if (s_exportStats[i].rate)
+        {
+            appendf(pOut, ",%s_rate", s_exportStats[i].name);
+        }
+    }
+
+    pOut->append(",timer_jitter_p99_us,timer_jitter_max_us,timer_lag_p99_us,"
+                 "timer_lag_max_us");
+
+    for (U32 i = 0; i < m_jobs.size(); i++)
+    {
+        const S8 *name = m_jobs[i]->name.c_str();
+        appendf(pOut, ",%s_msgs,%s_rate,%s_retrans,%s_timeouts,%s_unexpected",
+            name, name, name, name, name);
+        if (m_jobs[i]->latency)
+        {
+            appendf(pOut, ",%s_responses", name);
+            for (U32 p = 0; p < STATS_EXPORT_NUM_PCTS; p++)
+            {
+                appendf(pOut, ",%s_%s_us", name, s_exportPctNames[p]);
+            }
+
+            appendf(pOut, ",%s_max_us", name);
+        }
+    }
+
+    pOut->append("\n");
+}
+
+/* wall clock time of a sample, in milli-seconds since epoch */
+PRIVATE U64 getWallMilliSeconds()
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (U64)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+/**
+ * @brief
+ *    Timer statistics of the workers recorded since the previous sample
+ *
+ * @param pIntvl
+ */
+VOID StatsExport::sampleTimer(TimerStats *pIntvl)
+{
+    TimerStats curr;
+
+    getTotalTimerStats(&curr);
+    *pIntvl = curr;
+    pIntvl->jitter.sub(&m_lastTimer.jitter);
+    pIntvl->lag.sub(&m_lastTimer.lag);
+    m_lastTimer = curr;
+}
+
+/* message counters of a job, sent or received depending on the job type */
+PRIVATE VOID getJobMsgs(Job *pJob, JobStats *pStats, Counter *pMsgs,
+    Counter *pRetrans)
+{
+    if (JOB_TYPE_SEND == pJob->type())
+    {
+        *pMsgs    = pStats->numSnd;
+        *pRetrans = pStats->numSndRetrans;
+    }
+    else
+    {
+        *pMsgs    = pStats->numRcv;
+        *pRetrans = pStats->numRcvRetrans;
+    }
+}
+
+VOID StatsExport::fmtCsv(std::string *pOut, Time_t intvl)
+{
+    appendf(pOut, "%lu,%lu", getWallMilliSeconds(), intvl / 1000);
+
+    for (U32 i = 0; i < STATS_EXPORT_NUM_STATS; i++)
+    {
+        Counter curr = Stats::getTotalStats(s_exportStats[i].stat);
+        appendf(pOut, ",%u", curr);
+        if (s_exportStats[i].rate)
+        {
+            appendf(pOut, ",%.2f",
+                getRate(curr, m_last[s_exportStats[i].stat], intvl));
+        }
+
+        m_last[s_exportStats[i].stat] = curr;
+    }
+
+    TimerStats timer;
+    sampleTimer(&timer);
+    appendf(pOut, ",%lu,%lu,%lu,%lu", timer.jitter.percentile(99),
+        timer.jitter.max(), timer.lag.percentile(99), timer.lag.max());
+
+    for (U32 i = 0; i < m_jobs.size(); i++)
+    {
+        ExportJob *pExpJob = m_jobs[i];
+        JobStats   curr;
+        Counter    msgs, retrans, lastMsgs, lastRetrans;
+
+        pExpJob->pJob->getTotalStats(&curr);
+        getJobMsgs(pExpJob->pJob, &curr, &msgs, &retrans);
+        getJobMsgs(pExpJob->pJob, &pExpJob->last, &lastMsgs, &lastRetrans);
+
+        appendf(pOut, ",%u,%.2f,%u,%u,%u", msgs,
+            getRate(msgs, lastMsgs, intvl), retrans, curr.numTimeOut,
+            curr.numUnexp);
+
+        if (pExpJob->latency)
+        {
+            /* response times of the interval */
+            LatencyHist hist = curr.latency;
+            hist.sub(&pExpJob->last.latency);
+            appendf(pOut, ",%u", hist.count());
+            for (U32 p = 0; p < STATS_EXPORT_NUM_PCTS; p++)
+            {
+                appendf(pOut, ",%lu", hist.percentile(s_exportPcts[p]));
+            }
+
+            appendf(pOut, ",%lu", hist.max());
+        }
+
+        pExpJob->last = curr;
+    }
+
+    pOut->append("\n");
+}
+
+VOID StatsExport::fmtJson(std::string *pOut, Time_t intvl)
+{
+    appendf(pOut, "{\"time_ms\":%lu,\"interval_ms\":%lu,\"sessions\":{",
+        getWallMilliSeconds(), intvl / 1000);
+
+    for (U32 i = 0; i < STATS_EXPORT_NUM_STATS; i++)
+    {
+        Counter curr = Stats::getTotalStats(s_exportStats[i].stat);
+        appendf(pOut, "%s\"%s\":%u", (0 == i) ? "" : ",",
+            s_exportStats[i].name, curr);
+        if (s_exportStats[i].rate)
+        {
+            appendf(pOut, ",\"%s_rate\":%.2f", s_exportStats[i].name,
+                getRate(curr, m_last[s_exportStats[i].stat], intvl));
+        }
+
+        m_last[s_exportStats[i].stat] = curr;
+    }
+
+    TimerStats timer;
+    sampleTimer(&timer);
+    appendf(pOut, "},\"timer_us\":{\"jitter_p99\":%lu,\"jitter_max\":%lu,"
+        "\"lag_p99\":%lu,\"lag_max\":%lu", timer.jitter.percentile(99),
+        timer.jitter.max(), timer.lag.percentile(99), timer.lag.max());
+
+    pOut->append("},\"jobs\":[");
+    for (U32 i = 0; i < m_jobs.size(); i++)
+    {
+        ExportJob *pExpJob = m_jobs[i];
+        JobStats   curr;
+        Counter    msgs, retrans, lastMsgs, lastRetrans;
+
+        pExpJob->pJob->getTotalStats(&curr);
+        getJobMsgs(pExpJob->pJob, &curr, &msgs, &retrans);
+        getJobMsgs(pExpJob->pJob, &pExpJob->last, &lastMsgs, &lastRetrans);
+
+        appendf(pOut, "%s{\"proc\":%u,\"msg\":\"%s\",\"dir\":\"%s\","
+            "\"msgs\":%u,\"rate\":%.2f,\"retrans\":%u,\"timeouts\":%u,"
+            "\"unexpected\":%u", (0 == i) ? "" : ",", pExpJob->procIdx,
+            pExpJob->pJob->m_msgName,
+            (JOB_TYPE_SEND == pExpJob->pJob->type()) ? "send" : "recv", msgs,
+            getRate(msgs, lastMsgs, intvl), retrans, curr.numTimeOut,
+            curr.numUnexp);
+
+        if (pExpJob->latency)
+        {
+            LatencyHist hist = curr.latency;
+            hist.sub(&pExpJob->last.latency);
+            appendf(pOut, ",\"latency_us\":{\"responses\":%u", hist.count());
+            for (U32 p = 0; p < STATS_EXPORT_NUM_PCTS; p++)
+            {
+                appendf(pOut, ",\"%s\":%lu", s_exportPctNames[p],
+                    hist.percentile(s_exportPcts[p]));
+            }
+
+            appendf(pOut, ",\"max\":%lu}", hist.max());
+        }
+
+        pOut->append("}");
+        pExpJob->last = curr;
+    }
+
+    pOut->append("]}\n");
+}
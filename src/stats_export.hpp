@@ -0,0 +1,79 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _STATS_EXPORT_HPP_
+#define _STATS_EXPORT_HPP_
+
+#include <atomic>
+
+/* Exports the statistics to a file every statistics interval, as CSV or as
+ * one JSON object per line, for plotting long runs. A sample has the
+ * session counters, the message counters of every job of the scenario, the
+ * rates since the previous sample, the response time percentiles of the
+ * requests in the interval and the accuracy of the task timers.
+ *
+ * The samples are taken and written by a thread of their own, reading the
+ * counters of the workers the way the display does, so the workers do not
+ * format or write anything. The file is rotated when it grows beyond the
+ * configured size, the previous files are kept with the suffix .1, .2 and
+ * so on.
+ */
+class StatsExport: public CThread
+{
+   public:
+      StatsExport();
+      ~StatsExport();
+
+      RETVAL           startExport();
+      VOID             stopExport();
+
+   protected:
+      VOID             run(VOID *arg);
+
+   private:
+      typedef struct
+      {
+         Job            *pJob;
+         U32            procIdx;
+         BOOL           latency;   /* request job, response times recorded */
+         std::string    name;      /* column name prefix of the job */
+         JobStats       last;      /* counters of the previous sample */
+      } ExportJob;
+
+      RETVAL           openFile();
+      VOID             rotateFile();
+      VOID             addJob(U32 procIdx, Job *pJob);
+      VOID             sample();
+      VOID             sampleTimer(TimerStats *pIntvl);
+      VOID             fmtCsvHeader(std::string *pOut);
+      VOID             fmtCsv(std::string *pOut, Time_t intvl);
+      VOID             fmtJson(std::string *pOut, Time_t intvl);
+
+      std::atomic<bool>         m_stop;
+      FILE                     *m_pFile;
+      std::string               m_fileName;
+      StatsFormatEn             m_format;
+      Time_t                    m_intvl;      /* micro-seconds */
+      U64                       m_maxSize;    /* bytes */
+      U64                       m_size;
+      Time_t                    m_lastTime;   /* micro-seconds */
+      Counter                   m_last[GSIM_STAT_MAX];
+      TimerStats                m_lastTimer;
+      std::vector<ExportJob *>  m_jobs;
+};
+
+#endif /* _STATS_EXPORT_HPP_ */
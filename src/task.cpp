@@ -15,22 +15,25 @@
  */
 
 #include <assert.h>
-#include <list>
 
 #include "types.hpp"
 #include "logger.hpp"
+#include "macros.hpp"
 #include "timer.hpp"
 #include "task.hpp"
 
-static TaskId_t   s_taskId = 0;
-TaskList          g_runningTasks;
-TaskList          g_allTasks;
-TimeWheel         g_pausedTasks;
+/* every worker runs its own scheduler, the task lists are per thread */
+static thread_local TaskId_t   s_taskId = 0;
+thread_local TaskList          g_runningTasks;
+thread_local TaskList          g_allTasks;
+thread_local TimeWheel         g_pausedTasks;
 
 Task::Task()
 {
-   m_allTaskItr = g_allTasks.insert(g_allTasks.end(), this);
-   m_runningTaskItr = g_runningTasks.insert(g_runningTasks.end(), this);
+   m_allTaskLink.pTask = this;
+   m_schedLink.pTask = this;
+   g_allTasks.pushBack(&m_allTaskLink);
+   g_runningTasks.pushBack(&m_schedLink);
    m_taskState = TASK_STATE_RUNNING;
    m_id = ++s_taskId;
 }
@@ -39,7 +42,7 @@ VOID Task::stop()
 {
    if (TASK_STATE_RUNNING == m_taskState)
    {
-      g_runningTasks.erase(m_runningTaskItr);
+      TaskList::erase(&m_schedLink);
    }
    else if (TASK_STATE_PAUSED == m_taskState)
    {
@@ -52,7 +55,7 @@ VOID Task::stop()
 VOID Task::abort()
 {
    this->stop();
-   g_allTasks.erase(m_allTaskItr);
+   TaskList::erase(&m_allTaskLink);
    delete this;
 }
 
@@ -62,7 +65,7 @@ VOID Task::pause()
 
    if(TASK_STATE_RUNNING == m_taskState)
    {
-      g_runningTasks.erase(m_runningTaskItr);
+      TaskList::erase(&m_schedLink);
       g_pausedTasks.addTask(this);
       m_taskState = TASK_STATE_PAUSED;
    }
@@ -77,7 +80,7 @@ VOID Task::resumeTask()
 
    ASSERT(m_taskState != TASK_STATE_RUNNING);
 
-   m_runningTaskItr = g_runningTasks.insert(g_runningTasks.end(), this);
+   g_runningTasks.pushBack(&m_schedLink);
    m_taskState = TASK_STATE_RUNNING;
 }
 
@@ -90,7 +93,7 @@ VOID Task::setRunning()
 {
    ASSERT(m_taskState != TASK_STATE_RUNNING);
 
-   m_runningTaskItr = g_runningTasks.insert(g_runningTasks.end(), this);
+   g_runningTasks.pushBack(&m_schedLink);
    m_taskState = TASK_STATE_RUNNING;
 }
 
@@ -104,15 +107,27 @@ VOID TaskMgr::resumePausedTasks()
    g_pausedTasks.resumePausedTasks();
 }
 
+/**
+ * @brief
+ *    Time the first paused task of the calling thread is due, in
+ *    micro-seconds, not later than limit
+ *
+ * @param limit
+ */
+Time_t TaskMgr::getNextWakeTime(Time_t limit)
+{
+   return g_pausedTasks.nextWakeTime(limit);
+}
+
 VOID TaskMgr::deleteAllTasks()
 {
    TaskList *pTasks = getAllTasks();
-   TaskListItr itr = pTasks->begin();
+   TaskLink *pLink = pTasks->begin();
 
-   while (itr != pTasks->end())
+   while (pLink != pTasks->end())
    {
-      Task *tmp = *itr;
-      itr++;
+      Task *tmp = pLink->pTask;
+      pLink = pLink->pNext;
       tmp->abort();
    }
 }
@@ -18,10 +18,79 @@
 #define __TASK_HPP__
 
 class Task;
-typedef std::list<Task *>     TaskList;
-typedef TaskList::iterator    TaskListItr;
 typedef U32                   TaskId_t;
 
+/* Link of a task in an intrusive task list, the links are embedded in the
+ * task so that moving a task between the run queue and the time wheel
+ * slots does not allocate memory
+ */
+typedef struct _TaskLink_
+{
+   struct _TaskLink_ *pPrev;
+   struct _TaskLink_ *pNext;
+   Task              *pTask;
+} TaskLink;
+
+/* Circular doubly linked list of task links, the list head is a link
+ * without a task. A link is in one list at a time.
+ */
+class TaskList
+{
+   public:
+      TaskList()
+      {
+         m_head.pPrev = &m_head;
+         m_head.pNext = &m_head;
+         m_head.pTask = NULL;
+      }
+
+      BOOL              empty() const {return (m_head.pNext == &m_head);}
+      TaskLink          *begin() {return m_head.pNext;}
+      TaskLink          *end() {return &m_head;}
+
+      VOID pushBack(TaskLink *pLink)
+      {
+         pLink->pPrev = m_head.pPrev;
+         pLink->pNext = &m_head;
+         m_head.pPrev->pNext = pLink;
+         m_head.pPrev = pLink;
+      }
+
+      static VOID erase(TaskLink *pLink)
+      {
+         pLink->pPrev->pNext = pLink->pNext;
+         pLink->pNext->pPrev = pLink->pPrev;
+         pLink->pPrev = NULL;
+         pLink->pNext = NULL;
+      }
+
+      /* moves all the links of a list to the end of this list */
+      VOID splice(TaskList *pList)
+      {
+         if (pList->empty())
+         {
+            return;
+         }
+
+         TaskLink *pFirst = pList->m_head.pNext;
+         TaskLink *pLast = pList->m_head.pPrev;
+         pFirst->pPrev = m_head.pPrev;
+         pLast->pNext = &m_head;
+         m_head.pPrev->pNext = pFirst;
+         m_head.pPrev = pLast;
+
+         pList->m_head.pPrev = &pList->m_head;
+         pList->m_head.pNext = &pList->m_head;
+      }
+
+   private:
+      /* the links point to the head, a list is not copied */
+      TaskList(const TaskList &);
+      TaskList &operator=(const TaskList &);
+
+      TaskLink          m_head;
+};
+
 typedef enum
 {
    TASK_STATE_INVALID,
@@ -37,6 +106,7 @@ class TaskMgr
       static TaskList* getRunningTasks();
       static TaskList* getAllTasks();
       static VOID resumePausedTasks();
+      static Time_t getNextWakeTime(Time_t limit);
       static VOID deleteAllTasks();
 };
 
@@ -71,14 +141,17 @@ class Task
       /* When should this Task wake up? */
       virtual Time_t wake() = 0;
 
+      /* When should this Task wake up, in micro-seconds? A task paced
+       * finer than a milli-second overrides it.
+       */
+      virtual Time_t wakeUs() {return wake() * 1000;}
+
    private:
 
       VOID              recalcWheel();
 
-      TaskListItr       m_allTaskItr;
-      TaskListItr       m_runningTaskItr;
-      TaskListItr       m_pausedTaskItr;
-      TaskList          *m_pausedTaskList;
+      TaskLink          m_allTaskLink;
+      TaskLink          m_schedLink;     /* run queue or time wheel slot */
       TaskState_t       m_taskState;
       
       friend class TaskMgr;
@@ -0,0 +1,176 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "thread.hpp"
+#include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "worker.hpp"
+#include "teid_table.hpp"
+
+/* index 0 is not used, so that TEID 0 is never allocated */
+#define GSIM_TEID_FIRST_INDEX    1
+#define GSIM_TEID_INVALID_INDEX  0
+
+TeidTable::TeidTable()
+{
+    MEMSET(m_pages, 0, sizeof(m_pages));
+    m_numIndices = GSIM_TEID_FIRST_INDEX;
+    m_freeHead   = GSIM_TEID_INVALID_INDEX;
+    m_freeTail   = GSIM_TEID_INVALID_INDEX;
+}
+
+TeidTable::~TeidTable()
+{
+    for (U32 i = 0; i < GSIM_TEID_MAX_PAGES; i++)
+    {
+        delete[] m_pages[i];
+    }
+}
+
+TeidTable::TeidTableEntry *TeidTable::entry(U32 index)
+{
+    return &m_pages[index >> GSIM_TEID_PAGE_SHIFT]
+                   [index & (GSIM_TEID_PAGE_SIZE - 1)];
+}
+
+/**
+ * @brief
+ *    Allocates a TEID for a tunnel, an index released earlier is reused
+ *    before a new index is taken
+ *
+ * @param pTun
+ *
+ * @return
+ *    TEID, throws ERR_CTUN_CREATION if all the indices are in use
+ */
+GtpTeid_t TeidTable::alloc(GtpcTun *pTun)
+{
+    U32 index = m_freeHead;
+
+    if (GSIM_TEID_INVALID_INDEX != index)
+    {
+        m_freeHead = entry(index)->nextFree;
+        if (GSIM_TEID_INVALID_INDEX == m_freeHead)
+        {
+            m_freeTail = GSIM_TEID_INVALID_INDEX;
+        }
+    }
+    else
+    {
+        if (m_numIndices > GSIM_TEID_INDEX_MASK)
+        {
+            LOG_ERROR("All GTP-C TEIDs in use");
+            throw ERR_CTUN_CREATION;
+        }
+
+        index = m_numIndices++;
+        U32 page = index >> GSIM_TEID_PAGE_SHIFT;
+        if (NULL == m_pages[page])
+        {
+            m_pages[page] = new TeidTableEntry[GSIM_TEID_PAGE_SIZE];
+            MEMSET(m_pages[page], 0,
+                GSIM_TEID_PAGE_SIZE * sizeof(TeidTableEntry));
+        }
+    }
+
+    TeidTableEntry *pEntry = entry(index);
+    pEntry->pTun     = pTun;
+    pEntry->nextFree = GSIM_TEID_INVALID_INDEX;
+
+    return (Worker::selfId() << GSIM_WORKER_TEID_SHIFT) |
+           ((U32)pEntry->gen << GSIM_TEID_GEN_SHIFT) | index;
+}
+
+/**
+ * @brief
+ *    Releases the TEID of a deleted tunnel, the generation of the entry is
+ *    moved on so that the released TEID is not found any more. A stale
+ *    TEID is ignored, its index may be in use by a new tunnel.
+ *
+ * @param teid
+ */
+VOID TeidTable::release(GtpTeid_t teid)
+{
+    U32 index = teid & GSIM_TEID_INDEX_MASK;
+    if ((index < GSIM_TEID_FIRST_INDEX) || (index >= m_numIndices) ||
+        ((teid >> GSIM_WORKER_TEID_SHIFT) != Worker::selfId()))
+    {
+        return;
+    }
+
+    TeidTableEntry *pEntry = entry(index);
+    if ((NULL == pEntry->pTun) ||
+        (pEntry->gen != ((teid >> GSIM_TEID_GEN_SHIFT) & GSIM_TEID_GEN_MASK)))
+    {
+        LOG_DEBUG("Release of stale GTP-C TEID [%u] ignored", teid);
+        return;
+    }
+
+    pEntry->pTun = NULL;
+    pEntry->gen  = (pEntry->gen + 1) & GSIM_TEID_GEN_MASK;
+
+    if (GSIM_TEID_INVALID_INDEX == m_freeTail)
+    {
+        m_freeHead = index;
+    }
+    else
+    {
+        entry(m_freeTail)->nextFree = index;
+    }
+
+    m_freeTail = index;
+}
+
+/**
+ * @brief
+ *    Finds the tunnel of a TEID, a TEID of a deleted tunnel or with a
+ *    generation other than the current generation of the entry is rejected
+ *    as stale
+ *
+ * @param teid
+ */
+GtpcTun *TeidTable::find(GtpTeid_t teid)
+{
+    U32 index = teid & GSIM_TEID_INDEX_MASK;
+    if ((index < GSIM_TEID_FIRST_INDEX) || (index >= m_numIndices) ||
+        ((teid >> GSIM_WORKER_TEID_SHIFT) != Worker::selfId()))
+    {
+        return NULL;
+    }
+
+    TeidTableEntry *pEntry = entry(index);
+    if ((NULL == pEntry->pTun) ||
+        (pEntry->gen != ((teid >> GSIM_TEID_GEN_SHIFT) & GSIM_TEID_GEN_MASK)))
+    {
+        LOG_DEBUG("Stale GTP-C TEID [%u]", teid);
+        Stats::incStats(GSIM_STAT_NUM_STALE_TEIDS);
+        return NULL;
+    }
+
+    return pEntry->pTun;
+}
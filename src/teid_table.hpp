@@ -0,0 +1,72 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TEID_TABLE_HPP_
+#define _TEID_TABLE_HPP_
+
+/* Control plane TEID layout, the worker id bits are defined in worker.hpp
+ *
+ *    31      28 27      24 23                                   0
+ *   +----------+----------+--------------------------------------+
+ *   |  worker  |   gen    |              table index             |
+ *   +----------+----------+--------------------------------------+
+ */
+#define GSIM_TEID_GEN_SHIFT      24
+#define GSIM_TEID_GEN_MASK       0x0f
+#define GSIM_TEID_INDEX_MASK     ((1U << GSIM_TEID_GEN_SHIFT) - 1)
+#define GSIM_TEID_PAGE_SHIFT     12
+#define GSIM_TEID_PAGE_SIZE      (1U << GSIM_TEID_PAGE_SHIFT)
+#define GSIM_TEID_MAX_PAGES      (1U << (GSIM_TEID_GEN_SHIFT - \
+                                         GSIM_TEID_PAGE_SHIFT))
+
+class GtpcTun;
+
+/* Allocates the control plane TEIDs and maps a TEID to its tunnel. The TEID
+ * carries the index of the tunnel in the table, the table is a directory of
+ * fixed size pages allocated as the tunnels are created.
+ *
+ * Index of a deleted tunnel is reused in FIFO order, and the generation of
+ * the entry is incremented on every reuse, so that a stale TEID, from a
+ * late retransmission for example, does not find the tunnel now using the
+ * index.
+ */
+class TeidTable
+{
+   public:
+      TeidTable();
+      ~TeidTable();
+
+      GtpTeid_t         alloc(GtpcTun *pTun);
+      VOID              release(GtpTeid_t teid);
+      GtpcTun          *find(GtpTeid_t teid);
+
+   private:
+      typedef struct
+      {
+         GtpcTun       *pTun;
+         U32            nextFree;  /* next index in the free list */
+         U8             gen;
+      } TeidTableEntry;
+
+      TeidTableEntry   *entry(U32 index);
+
+      TeidTableEntry   *m_pages[GSIM_TEID_MAX_PAGES];
+      U32               m_numIndices; /* indices handed out so far */
+      U32               m_freeHead;
+      U32               m_freeTail;
+};
+
+#endif
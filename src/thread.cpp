@@ -28,6 +28,11 @@ S32 CThread::start(VOID* arg)
         (VOID *)this);
 }
 
+S32 CThread::join()
+{
+   return pthread_join(threadId, NULL);
+}
+
 VOID CThread::execute()
 {
    run(userArg);
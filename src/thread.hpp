@@ -25,7 +25,9 @@ class CThread
 {
    public:
       CThread();
+      virtual ~CThread() {}
       S32 start(VOID *arg);
+      S32 join();
 
    protected:
       VOID execute();
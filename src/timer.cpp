@@ -21,31 +21,82 @@
 
 #include "types.hpp"
 #include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_types.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "thread.hpp"
+#include "worker.hpp"
 #include "timer.hpp"
 
-static Time_t s_clockTick = 0;
+/* resolution of the time wheels in micro-seconds, set before the workers
+ * are started
+ */
+static U32                     s_timerTick = 1000;
+static Time_t                  s_startTime = 0;
+
+/* scheduler time of the calling thread in micro-seconds and in ticks */
+static thread_local Time_t     s_clockTime = 0;
+static thread_local Time_t     s_clockTick = 0;
+
+/* timer accuracy, every worker updates its own histograms */
+static thread_local TimerStats s_timerStats;
+static TimerStats             *s_workerTimerStats[GSIM_MAX_WORKERS];
+
+VOID setTimerTick(U32 tick)
+{
+    s_timerTick = tick;
+}
+
+U32 getTimerTick()
+{
+    return s_timerTick;
+}
 
 /**
  * @brief
- *    returns time in milliseconds since epoch time
+ *    returns the scheduler time in micro-seconds since the simulator
+ *    started, and advances the clock of the time wheel
  */
-Time_t getMilliSeconds()
+Time_t getSchedMicroSeconds()
 {
     struct timespec sysTime;
-    static Time_t   startTime = 0;
 
-    clock_gettime(CLOCK_MONOTONIC_COARSE, &sysTime);
+    clock_gettime(CLOCK_MONOTONIC, &sysTime);
     Time_t usec = (Time_t)sysTime.tv_sec * 1000000LL + sysTime.tv_nsec / 1000LL;
-    Time_t msec = usec / 1000;
 
-    if (startTime == 0)
+    if (s_startTime == 0)
     {
-        startTime = msec - 1;
+        s_startTime = usec - 1000;
     }
 
-    msec        = msec - startTime;
-    s_clockTick = msec;
-    return msec;
+    s_clockTime = usec - s_startTime;
+    s_clockTick = s_clockTime / s_timerTick;
+    return s_clockTime;
+}
+
+/**
+ * @brief
+ *    returns the scheduler time in milli-seconds since the simulator
+ *    started
+ */
+Time_t getMilliSeconds()
+{
+    return getSchedMicroSeconds() / 1000;
+}
+
+/**
+ * @brief
+ *    returns the monotonic time in micro-seconds, for time stamping the
+ *    messages. The coarse clock of the timer tick is not precise enough to
+ *    measure a response time.
+ */
+Time_t getMicroSeconds()
+{
+    struct timespec sysTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &sysTime);
+    return (Time_t)sysTime.tv_sec * 1000000LL + sysTime.tv_nsec / 1000LL;
 }
 
 VOID getTimeStr(S8 *pStr)
@@ -63,13 +114,23 @@ VOID getTimeStr(S8 *pStr)
     LOG_EXITVOID();
 }
 
+/* wheel three is circular, a task a turn or more of wheel three away goes
+ * back into its slot when the slot is cascaded, till it is in the turn of
+ * its wake up time
+ */
 TaskList *TimeWheel::getPausedTaskList(Time_t time)
 {
     U32 firstWheelSlot  = time % TW_ONE_SLOTS;
     U32 secondWheelSlot = (time / TW_ONE_SLOTS) % TW_TWO_SLOTS;
-    U32 thirdWheelSlot  = (time / (TW_ONE_SLOTS * TW_TWO_SLOTS));
+    U32 thirdWheelSlot =
+        (time / (TW_ONE_SLOTS * TW_TWO_SLOTS)) % TW_THREE_SLOTS;
 
-    if ((time / TW_ONE_SLOTS) == (wheelBase / TW_ONE_SLOTS))
+    if (time < wheelBase)
+    {
+        LOG_ERROR("Attempted to schedule a task in the past");
+        return NULL;
+    }
+    else if ((time / TW_ONE_SLOTS) == (wheelBase / TW_ONE_SLOTS))
     {
         return &wheelOne[firstWheelSlot];
     }
@@ -78,14 +139,9 @@ TaskList *TimeWheel::getPausedTaskList(Time_t time)
     {
         return &wheelTwo[secondWheelSlot];
     }
-    else if (thirdWheelSlot < TW_THREE_SLOTS)
-    {
-        return &wheelThree[thirdWheelSlot];
-    }
     else
     {
-        LOG_ERROR("Attempted to schedule a task too far in the future");
-        return NULL;
+        return &wheelThree[thirdWheelSlot];
     }
 }
 
@@ -107,15 +163,15 @@ S32 TimeWheel::resumePausedTasks()
     {
         int slot1 = wheelBase % TW_ONE_SLOTS;
 
-        /* If slot1 is 0 (i.e. wheelBase is a multiple of 4096ms),
-         * we need to repopulate the first timer wheel with the
+        /* If slot1 is 0 (i.e. wheelBase is a multiple of TW_ONE_SLOTS
+         * ticks), we need to repopulate the first timer wheel with the
          * contents of the first available slot of the second wheel. */
         if (slot1 == 0)
         {
             /* slot2 represents the slot in the second timer wheel
-             * containing the tasks for the next ~4s. So when
-             * wheelBase is 4096, wheel2[1] will be moved into wheel 1,
-             * when wheelBase of 8192 wheel2[2] will be moved into
+             * containing the tasks for the next TW_ONE_SLOTS ticks. So
+             * when wheelBase is 4096, wheel2[1] will be moved into wheel
+             * 1, when wheelBase of 8192 wheel2[2] will be moved into
              * wheel 1, etc. */
             int slot2 = (wheelBase / TW_ONE_SLOTS) % TW_TWO_SLOTS;
 
@@ -125,52 +181,127 @@ S32 TimeWheel::resumePausedTasks()
             if (slot2 == 0)
             {
                 /* Same logic above, except that each slot of wheel3
-                   contains the next 69 minutes of tasks, enough to
-                   completely fill wheel 2. */
-                int slot3 = ((wheelBase / TW_ONE_SLOTS) / TW_TWO_SLOTS);
-                for (TaskListItr l3it = wheelThree[slot3].begin();
-                     l3it != wheelThree[slot3].end(); l3it++)
-                {
-                    /* Migrate this task to wheel two. */
-                    (*l3it)->recalcWheel();
-                }
-
-                wheelThree[slot3].clear();
+                   contains the next TW_ONE_SLOTS * TW_TWO_SLOTS ticks of
+                   tasks, enough to completely fill wheel 2. The tasks of
+                   a later turn of wheel 3 go back into the slot. */
+                int slot3 = ((wheelBase / TW_ONE_SLOTS) / TW_TWO_SLOTS) %
+                            TW_THREE_SLOTS;
+                cascade(&wheelThree[slot3]);
             }
 
             /* Repopulate wheel 1 from wheel 2 (which will now be full
              * of the tasks pulled from wheel 3, if that was
              * necessary)
              */
-            for (TaskListItr l2it = wheelTwo[slot2].begin();
-                 l2it != wheelTwo[slot2].end(); l2it++)
-            {
-                /* Migrate this task to wheel one. */
-                (*l2it)->recalcWheel();
-            }
-
-            wheelTwo[slot2].clear();
+            cascade(&wheelTwo[slot2]);
         }
 
         /* Move tasks from the current slot of wheel 1 (i.e. the tasks
-         * scheduled to fire in the 1ms interval represented by wheelBase)
-         * onto a run queue.
+         * scheduled to fire in the tick represented by wheelBase)
+         * onto a run queue. The slot list is moved as a whole.
          */
-        found += wheelOne[slot1].size();
-        for (TaskListItr it = wheelOne[slot1].begin();
-             it != wheelOne[slot1].end(); it++)
+        TaskList *pSlot = &wheelOne[slot1];
+        for (TaskLink *pLink = pSlot->begin(); pLink != pSlot->end();
+             pLink = pLink->pNext)
         {
-            (*it)->setRunning();
+            Time_t wake = pLink->pTask->wakeUs();
+            s_timerStats.lag.record(
+                (s_clockTime > wake) ? (s_clockTime - wake) : 0);
+
+            pLink->pTask->m_taskState = TASK_STATE_RUNNING;
+            found++;
             count--;
         }
 
-        wheelOne[slot1].clear();
+        TaskMgr::getRunningTasks()->splice(pSlot);
+        wheelOneMap[slot1 / 64] &= ~(1ULL << (slot1 % 64));
         wheelBase++;
     }
 
     return found;
 }
 
+/**
+ * @brief
+ *    Returns the time the first paused task is due, i.e. the time the slot
+ *    of wheel one holding it is run. The tasks of the outer wheels are due
+ *    after wheel one turns over, the scheduler wakes up then to move them
+ *    to wheel one.
+ *
+ * @param limit
+ *    latest time returned, micro-seconds
+ *
+ * @return
+ *    micro-seconds
+ */
+Time_t TimeWheel::nextWakeTime(Time_t limit)
+{
+    if (0 == count)
+    {
+        return limit;
+    }
+
+    /* wheel one is refilled when the first slot of a turn is run */
+    if (0 == (wheelBase % TW_ONE_SLOTS))
+    {
+        return GSIM_MIN(limit, (wheelBase + 1) * s_timerTick);
+    }
+
+    Time_t turnEnd = wheelBase | (TW_ONE_SLOTS - 1);
+    Time_t last    = GSIM_MIN(turnEnd, limit / s_timerTick);
+    Time_t tick    = wheelBase;
+    while (tick <= last)
+    {
+        U32 slot = tick % TW_ONE_SLOTS;
+        U64 bits = wheelOneMap[slot / 64] >> (slot % 64);
+        if (0 == bits)
+        {
+            tick += 64 - (slot % 64);
+            continue;
+        }
+
+        tick += __builtin_ctzll(bits);
+        slot = tick % TW_ONE_SLOTS;
+        if (tick > last)
+        {
+            break;
+        }
+
+        if (!wheelOne[slot].empty())
+        {
+            return GSIM_MIN(limit, (tick + 1) * s_timerTick);
+        }
+
+        /* the tasks of the slot were resumed or stopped before they were
+         * due
+         */
+        wheelOneMap[slot / 64] &= ~(1ULL << (slot % 64));
+    }
+
+    return GSIM_MIN(limit, (turnEnd + 2) * s_timerTick);
+}
+
+/**
+ * @brief Moves the tasks of a slot of an outer wheel into the slots of the
+ *    inner wheels, by their wake up time
+ *
+ * @param pSlot
+ */
+VOID TimeWheel::cascade(TaskList *pSlot)
+{
+    TaskList tasks;
+
+    /* the slot is emptied first, a task may go back into the same slot */
+    tasks.splice(pSlot);
+    while (!tasks.empty())
+    {
+        TaskLink *pLink = tasks.begin();
+        TaskList::erase(pLink);
+        count--;
+        pLink->pTask->recalcWheel();
+    }
+}
+
 /**
  * @brief Adds a task into correct timewheel
  *
@@ -178,20 +309,33 @@ S32 TimeWheel::resumePausedTasks()
  */
 VOID TimeWheel::addTask(Task *task)
 {
-    Time_t wake = task->wake();
+    /* a task is put in the slot of the tick before the first tick boundary
+     * at or after its wakeup time, the slot is run once the clock passes
+     * that boundary
+     */
+    Time_t wake = (task->wakeUs() + s_timerTick - 1) / s_timerTick;
+
+    /* a task already due is put in the slot of the current tick, it is
+     * resumed on the next tick. It is not made runnable here, as the task
+     * pausing itself is still running.
+     */
+    wake = (wake > wheelBase) ? (wake - 1) : wheelBase;
 
-    /* if wakeup time is less than wheelbase add the task into runnable list */
-    if (wake < wheelBase)
+    TaskList *pSlot = getPausedTaskList(wake);
+    if (NULL == pSlot)
     {
-        task->setRunning();
-        return;
+        wake  = wheelBase;
+        pSlot = &wheelOne[wake % TW_ONE_SLOTS];
     }
 
-    TaskList *  pauseList  = getPausedTaskList(wake);
-    TaskListItr itr        = pauseList->insert(pauseList->end(), task);
-    task->m_pausedTaskList = pauseList;
-    task->m_pausedTaskItr  = itr;
+    pSlot->pushBack(&task->m_schedLink);
     count++;
+
+    U32 slot = wake % TW_ONE_SLOTS;
+    if (pSlot == &wheelOne[slot])
+    {
+        wheelOneMap[slot / 64] |= (1ULL << (slot % 64));
+    }
 }
 
 /**
@@ -201,8 +345,7 @@ VOID TimeWheel::addTask(Task *task)
  */
 VOID TimeWheel::removeTask(Task *task)
 {
-    TaskList *list = task->m_pausedTaskList;
-    list->erase(task->m_pausedTaskItr);
+    TaskList::erase(&task->m_schedLink);
     count--;
 }
 
@@ -210,9 +353,51 @@ TimeWheel::TimeWheel()
 {
     count     = 0;
     wheelBase = s_clockTick;
+    MEMSET(wheelOneMap, 0, sizeof(wheelOneMap));
 }
 
 Counter TimeWheel::size()
 {
     return count;
 }
+
+/**
+ * @brief
+ *    Registers the timer statistics of the calling worker
+ *
+ * @param workerId
+ */
+VOID attachTimerStats(U32 workerId)
+{
+    s_workerTimerStats[workerId] = &s_timerStats;
+}
+
+/**
+ * @brief
+ *    Returns the timer statistics of the calling worker
+ */
+TimerStats *getTimerStats()
+{
+    return &s_timerStats;
+}
+
+/**
+ * @brief
+ *    Sums up the timer statistics of all the workers
+ *
+ * @param pTotal
+ */
+VOID getTotalTimerStats(TimerStats *pTotal)
+{
+    pTotal->jitter.reset();
+    pTotal->lag.reset();
+
+    for (U32 i = 0; i < GSIM_MAX_WORKERS; i++)
+    {
+        if (NULL != s_workerTimerStats[i])
+        {
+            pTotal->jitter.add(&s_workerTimerStats[i]->jitter);
+            pTotal->lag.add(&s_workerTimerStats[i]->lag);
+        }
+    }
+}
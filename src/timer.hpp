@@ -28,18 +28,25 @@ using namespace std;
 #include <iostream>
 #include <string>
 #include <vector>
-#include <list>
 
 #include "types.hpp"
 #include "error.hpp"
 #include "task.hpp"
+#include "latency.hpp"
 
 #define GSIM_TIME_STR_MAX_LEN    32
 #define TW_ONE_SLOTS             (1 << 12)
 #define TW_TWO_SLOTS             (1 << 10)
 #define TW_THREE_SLOTS           (1 << 10)
+#define TW_ONE_MAP_WORDS         (TW_ONE_SLOTS / 64)
 
-/* resolution of time wheel is milli-seconds */
+/* longest sleep of a scheduler in micro-seconds, a key press seen by
+ * another thread is acted upon within it
+ */
+#define GSIM_SCHED_MAX_WAIT      10000
+
+/* resolution of time wheel is one timer tick, getTimerTick() micro-seconds
+ */
 class TimeWheel
 {
    public:
@@ -49,24 +56,51 @@ class TimeWheel
       void removeTask(Task* t);
       void wakeupTask();
       S32 resumePausedTasks();
+      Time_t nextWakeTime(Time_t limit);
       Counter size();
 
    private:
       Time_t   wheelBase;
       Counter  count;
 
-      /* wheel one has 1 ^ 12 millisecond slots */
+      /* wheel one has 1 ^ 12 tick slots */
       TaskList wheelOne[TW_ONE_SLOTS];
 
-      /* wheel two has 1 ^ 12 to 1 ^ 22 milli-second slots */
+      /* slots of wheel one with tasks, a bit is cleared lazily when the
+       * slot is found empty
+       */
+      U64      wheelOneMap[TW_ONE_MAP_WORDS];
+
+      /* wheel two has 1 ^ 12 to 1 ^ 22 tick slots */
       TaskList wheelTwo[TW_TWO_SLOTS];
 
-      /* wheel two has 1 ^ 22 to 1 ^ 32 milli-second slots */
+      /* wheel three has 1 ^ 22 to 1 ^ 32 tick slots, it is circular and
+       * holds the tasks of its later turns too
+       */
       TaskList wheelThree[TW_THREE_SLOTS];
 
       TaskList *getPausedTaskList(Time_t time);
+      void      cascade(TaskList *pSlot);
 };
 
+/* Accuracy of the scheduler of a worker, in micro-seconds. The jitter is
+ * the time the scheduler wakes up after its timer deadline, the lag is the
+ * time a paused task is resumed after its wake up time.
+ */
+typedef struct
+{
+   LatencyHist    jitter;
+   LatencyHist    lag;
+} TimerStats;
+
+VOID setTimerTick(U32 tick);
+U32 getTimerTick();
 Time_t getMilliSeconds();
+Time_t getSchedMicroSeconds();
+Time_t getMicroSeconds();
 VOID getTimeStr(S8 *pStr);
+
+VOID attachTimerStats(U32 workerId);
+TimerStats *getTimerStats();
+VOID getTotalTimerStats(TimerStats *pTotal);
 #endif
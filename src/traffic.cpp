@@ -14,6 +14,7 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <math.h>
 #include <list>
 #include <map>
 #include <vector>
@@ -33,34 +34,320 @@
 #include "gtp_msg.hpp"
 #include "procedure.hpp"
 #include "gtp_stats.hpp"
+#include "obj_pool.hpp"
 #include "tunnel.hpp"
+#include "flight_rec.hpp"
 #include "session.hpp"
 #include "gtp_peer.hpp"
 #include "display.hpp"
+#include "thread.hpp"
+#include "worker.hpp"
+#include "pkt_buf.hpp"
+#include "rate_profile.hpp"
 #include "traffic.hpp"
 
 EXTERN BOOL g_serverMode;
 
+PRIVATE BOOL isLocalOwner(U32 owner);
+PRIVATE VOID forwardGtpcMsg(U32 owner, PktBuf *data);
+
+/* every worker generates its share of the session rate and the number of
+ * sessions, for the IMSIs owned by it
+ */
 TrafficTask::TrafficTask()
 {
-   m_ratePeriod = Config::getInstance()->getSessionRatePeriod();
-   m_rate = Config::getInstance()->getCallRate();
-   m_maxSessions = Config::getInstance()->getNumSessions();
-   string imsi = Config::getInstance()->getImsi();
+   Config *pCfg = Config::getInstance();
+
+   m_ratePeriod = pCfg->getSessionRatePeriod();
+   m_rate = getWorkerShare(pCfg->getCallRate());
+   m_maxSessions = getWorkerShare(pCfg->getNumSessions());
+   string imsi = pCfg->getImsi();
    m_imsiGen.init(imsi);
+
+   m_lastRunTime = 0;
+   m_wakeTime = 0;
+   m_pacing = pCfg->getPacingMode();
+   m_burst = pCfg->getPacingBurst();
+   m_interval = 0;
+   m_nextStart = 0;
+   m_rng.seed(getMicroSeconds() + Worker::selfId());
+   m_offeredRate = 0;
+   m_evalPeriod = m_ratePeriod * 1000;
+   m_numWorkers = pCfg->getNumWorkers();
+
+   m_limitConc = (0 != pCfg->getMaxOutstanding());
+   m_aimd = pCfg->getAimd();
+   m_window = GSIM_MAX(getWorkerShare(pCfg->getMaxOutstanding()), 1);
+   m_windowFull = FALSE;
+   m_lastRsps = Stats::getStats(GSIM_STAT_NUM_RSPS_RCVD);
+   m_lastTimeouts = Stats::getStats(GSIM_STAT_NUM_REQ_TIMEOUTS);
+   m_lastDecrease = 0;
+   m_t3Time = (Time_t)pCfg->getT3Timer() * 1000;
+   if (m_limitConc)
+   {
+      Stats::setStats(GSIM_STAT_CONC_WINDOW, (Counter)m_window);
+   }
+
+   /* the rate of a profile changes between two session starts, it is
+    * sampled at least every evaluation period
+    */
+   m_pProfile = RateProfile::get();
+   m_profileStart = getSchedMicroSeconds();
+   if (NULL != m_pProfile)
+   {
+      m_evalPeriod = RATE_PROFILE_EVAL_PERIOD * 1000;
+   }
+
+   if (((NULL != m_pProfile) || m_limitConc) &&
+       (PACING_MODE_BURST == m_pacing))
+   {
+      m_pacing = PACING_MODE_UNIFORM;
+   }
+
+   updateRate(m_profileStart);
 }
 
 RETVAL TrafficTask::run(VOID *arg)
 {
    LOG_ENTERFN();
 
-   BOOL     abortTraffiTask = FALSE;
-   LOG_DEBUG("Running TrafficTask, Session Rate [%d]", m_rate);
+   LOG_DEBUG("Running TrafficTask, Session Rate [%f]", m_offeredRate);
 
-   Time_t currTime = getMilliSeconds();
-   m_lastRunTime = currTime;
+   Time_t now = getSchedMicroSeconds();
+   if (!updateRate(now))
+   {
+      LOG_DEBUG("End of Rate Profile, Stopping Traffic");
+      stopTraffic();
+   }
+   else if (PACING_MODE_BURST == m_pacing)
+   {
+      runBurst();
+   }
+   else
+   {
+      runPaced(now);
+   }
+
+   LOG_EXITFN(ROK);
+}
+
+/**
+ * @brief
+ *    Updates the session rate of the worker, from the rate profile, or from
+ *    the session rate changed with the keyboard
+ *
+ * @param now
+ *    micro-seconds
+ *
+ * @return
+ *    FALSE at the end of the rate profile
+ */
+BOOL TrafficTask::updateRate(Time_t now)
+{
+   if (NULL == m_pProfile)
+   {
+      m_rate = getWorkerShare(Config::getInstance()->getCallRate());
+      setOfferedRate((double)m_rate * 1000 / m_ratePeriod, now);
+      return TRUE;
+   }
+
+   Time_t elapsed = (now - m_profileStart) / 1000;
+   if (elapsed >= m_pProfile->duration())
+   {
+      return FALSE;
+   }
+
+   setOfferedRate(m_pProfile->rate(elapsed) / m_numWorkers, now);
+   return TRUE;
+}
+
+/**
+ * @brief
+ *    Sets the session rate paced by the worker. The wait for the next
+ *    session start is scaled by the change of the rate, so that a rate
+ *    rising or falling between two session starts is followed. At rate 0
+ *    no session is due.
+ *
+ * @param rate
+ *    sessions per second
+ * @param now
+ *    micro-seconds
+ */
+VOID TrafficTask::setOfferedRate(double rate, Time_t now)
+{
+   if (rate == m_offeredRate)
+   {
+      return;
+   }
+
+   if (rate <= 0)
+   {
+      m_nextStart = HUGE_VAL;
+   }
+   else
+   {
+      if (m_offeredRate <= 0)
+      {
+         m_nextStart = now;
+      }
+      else if (m_nextStart > now)
+      {
+         m_nextStart = now + (m_nextStart - now) * m_offeredRate / rate;
+      }
+
+      m_interval = 1000000 / rate;
+      m_poisson = std::exponential_distribution<double>(1 / m_interval);
+   }
+
+   m_offeredRate = rate;
+   Stats::setStats(GSIM_STAT_OFFERED_RATE, (Counter)(rate + 0.5));
+}
+
+/**
+ * @brief
+ *    Number of sessions the concurrency window lets start. In the AIMD mode
+ *    the window grows by one for a window of responses received while it
+ *    held back sessions, and is halved on a request timeout, at most once
+ *    in a T3 period, as the retransmissions of one overload time out
+ *    together.
+ *
+ * @param now
+ *    micro-seconds
+ *
+ * @return
+ *    the pacing burst if the pending requests are not limited
+ */
+U32 TrafficTask::getWindowRoom(Time_t now)
+{
+   if (!m_limitConc)
+   {
+      return m_burst;
+   }
+
+   Counter rsps = Stats::getStats(GSIM_STAT_NUM_RSPS_RCVD);
+   Counter timeouts = Stats::getStats(GSIM_STAT_NUM_REQ_TIMEOUTS);
+   if (m_aimd)
+   {
+      if ((timeouts != m_lastTimeouts) && (now >= m_lastDecrease + m_t3Time))
+      {
+         m_window = GSIM_MAX(m_window / 2, 1.0);
+         m_lastDecrease = now;
+      }
+      else if (m_windowFull)
+      {
+         m_window += (double)(Counter)(rsps - m_lastRsps) / m_window;
+         m_window = GSIM_MIN(m_window, (double)DFLT_MAX_CONC_WINDOW);
+      }
+
+      Stats::setStats(GSIM_STAT_CONC_WINDOW, (Counter)m_window);
+   }
+
+   m_lastRsps = rsps;
+   m_lastTimeouts = timeouts;
+
+   Counter pending = Stats::getStats(GSIM_STAT_NUM_PENDING_REQS);
+   Counter window = (Counter)m_window;
+   return (pending < window) ? (window - pending) : 0;
+}
+
+/**
+ * @brief
+ *    Creates the sessions of a rate period and pauses till the next period
+ */
+VOID TrafficTask::runBurst()
+{
+   m_lastRunTime = getMilliSeconds();
+   BOOL maxCreated = createSessions(m_rate);
+
+   if (0 == Worker::selfId())
+   {
+      Display::displayStats();
+   }
+
+   if (maxCreated)
+   {
+      stopTraffic();
+   }
+   else
+   {
+      m_wakeTime = (m_lastRunTime + m_ratePeriod) * 1000;
+      pause();
+   }
+}
+
+/**
+ * @brief
+ *    Starts the sessions due by now, at most a burst of them, and pauses
+ *    till the next session is due. If more sessions are due the task is
+ *    left running, the rest are started once the scheduler has polled the
+ *    sockets. Sessions held back by the concurrency window wait for it to
+ *    open, checked every timer tick. Sessions due for longer than a rate
+ *    period, while the traffic was paused, the worker was overloaded or
+ *    the window was full, are not made up for.
+ *
+ * @param now
+ *    micro-seconds
+ */
+VOID TrafficTask::runPaced(Time_t now)
+{
+   U32 num = 0;
+   U32 room = getWindowRoom(now);
+
+   if (m_nextStart + m_ratePeriod * 1000 < now)
+   {
+      m_nextStart = now;
+   }
+
+   while ((m_nextStart <= now) && (num < m_burst) && (num < room))
+   {
+      num++;
+      m_nextStart += (PACING_MODE_POISSON == m_pacing) ?
+         m_poisson(m_rng) : m_interval;
+   }
+
+   m_windowFull = (m_nextStart <= now) && (num >= room);
+
+   if (createSessions(num))
+   {
+      stopTraffic();
+      return;
+   }
+
+   /* the display is refreshed once a rate period, as in the burst pacing
+    */
+   if ((0 == Worker::selfId()) &&
+       (now / 1000 >= m_lastRunTime + m_ratePeriod))
+   {
+      m_lastRunTime = now / 1000;
+      Display::displayStats();
+   }
+
+   if (m_windowFull)
+   {
+      m_wakeTime = now + getTimerTick();
+      pause();
+   }
+   else if (m_nextStart > now)
+   {
+      m_wakeTime = (Time_t)ceil(GSIM_MIN(m_nextStart,
+               (double)(now + m_evalPeriod)));
+      pause();
+   }
+}
+
+/**
+ * @brief
+ *    Creates UE sessions
+ *
+ * @param num
+ *
+ * @return
+ *    TRUE if the maximum number of sessions is created
+ */
+BOOL TrafficTask::createSessions(U32 num)
+{
    Counter numSession = Stats::getStats(GSIM_STAT_NUM_SESSIONS_CREATED);
-   for (U32 i = 0; i < m_rate; i++)
+   for (U32 i = 0; i < num; i++)
    {
       GtpImsiKey imsiKey;
       MEMSET(&imsiKey, 0, sizeof(GtpImsiKey));
@@ -72,44 +359,80 @@ RETVAL TrafficTask::run(VOID *arg)
       {
          LOG_DEBUG("Max Sessions = [%d] Created, Stopping Traffic",\
                m_maxSessions);
-         abortTraffiTask = TRUE;
-         break;
+         return TRUE;
       }
    }
 
-   Display::displayStats();
+   return FALSE;
+}
 
-   if (abortTraffiTask)
-   {
-      stop();
-   }
-   else
+VOID TrafficTask::stopTraffic()
+{
+   Stats::setStats(GSIM_STAT_OFFERED_RATE, 0);
+   stop();
+}
+
+/**
+ * @brief
+ *    Processes a received GTP-C message. The header is pre-parsed once
+ *    into the descriptor of the packet buffer, a malformed or truncated
+ *    message is dropped here, before the session lookup.
+ *
+ * @param data
+ */
+PUBLIC VOID procGtpcMsg(PktBuf *data)
+{
+   LOG_ENTERFN();
+
+   RETVAL ret = GtpMsg::parse(data->data(), data->len, &data->desc);
+   if (ROK != ret)
    {
-      m_wakeTime = m_lastRunTime + m_ratePeriod;
-      pause();
+      LOG_ERROR("Dropping malformed GTPC Message, length [%d], Error [%d]",\
+            data->len, ret);
+      Stats::incStats(GSIM_STAT_NUM_INVALID_MSGS);
+      data->unref();
+      LOG_EXITVOID();
    }
 
-   LOG_EXITFN(ROK);
+   dispatchGtpcMsg(data);
+
+   LOG_EXITVOID();
 }
 
-PUBLIC VOID procGtpcMsg(UdpData_t *data)
+/**
+ * @brief
+ *    Dispatches a pre-parsed GTP-C message, the reference to the packet
+ *    buffer is passed on to the UE session, or to the owning worker
+ *
+ * @param data
+ */
+PUBLIC VOID dispatchGtpcMsg(PktBuf *data)
 {
    LOG_ENTERFN();
 
-   UeSession      *ueSsn     = NULL;
-   U8             *gtpMsgBuf = NULL;
-   GtpMsgType_t   msgType    = GTPC_MSG_TYPE_INVALID;
-   
-   gtpMsgBuf = data->buf.pVal;
-   GTP_MSG_GET_TYPE(gtpMsgBuf, msgType);
+   UeSession         *ueSsn = NULL;
+   const GtpMsgDesc  *pDesc = &data->desc;
+   GtpMsgType_t      msgType = pDesc->hdr.msgType;
 
    if (GTPC_MSG_CS_REQ == msgType || GTPC_MSG_FR_REQ == msgType)
    {
-      U8 *imsiBuf = getImsiBufPtr(&data->buf);
+      if (0 == pDesc->imsiOff)
+      {
+         LOG_ERROR("IMSI not present in GTPC Message [%d]", msgType);
+         data->unref();
+         LOG_EXITVOID();
+      }
 
       GtpImsiKey  imsiKey;
-      GTP_GET_IE_LEN(imsiBuf, imsiKey.len);
-      MEMCPY(imsiKey.val, imsiBuf + GTP_IE_HDR_LEN, imsiKey.len);
+      imsiKey.len = pDesc->imsiLen;
+      MEMCPY(imsiKey.val, data->data() + pDesc->imsiOff, imsiKey.len);
+
+      U32 owner = getImsiOwner(&imsiKey);
+      if (!isLocalOwner(owner))
+      {
+         forwardGtpcMsg(owner, data);
+         LOG_EXITVOID();
+      }
 
       ueSsn = UeSession::getUeSession(imsiKey);
       if (NULL == ueSsn)
@@ -120,15 +443,20 @@ PUBLIC VOID procGtpcMsg(UdpData_t *data)
    }
    else
    {
-      GtpTeid_t teid = 0;
-      GTP_MSG_DEC_TEID(gtpMsgBuf, teid);
+      GtpTeid_t teid = pDesc->hdr.teid;
       if (0 != teid)
       {
+         U32 owner = getTeidOwner(teid);
+         if (!isLocalOwner(owner))
+         {
+            forwardGtpcMsg(owner, data);
+            LOG_EXITVOID();
+         }
+
          ueSsn = UeSession::getUeSession(teid);
          if (NULL == ueSsn)
          {
             LOG_ERROR("GTPC Message received with unknown TEID [%d]", teid);
-            delete data;
          }
          else
          {
@@ -138,7 +466,6 @@ PUBLIC VOID procGtpcMsg(UdpData_t *data)
       else
       {
          LOG_ERROR("Unhandled Incoming GTP Message");
-         delete data;
       }
    }
 
@@ -149,6 +476,77 @@ PUBLIC VOID procGtpcMsg(UdpData_t *data)
          ueSsn->abort();
       }
    }
+   else
+   {
+      data->unref();
+   }
+
+   LOG_EXITVOID();
+}
+
+/**
+ * @brief
+ *    Checks if the UE session of a message is owned by the calling thread,
+ *    the receive thread of the pipeline mode does not own any session
+ *
+ * @param owner
+ */
+PRIVATE BOOL isLocalOwner(U32 owner)
+{
+   return (!RxThread::isRxThread() && (owner == Worker::selfId()));
+}
+
+/**
+ * @brief
+ *    Hands over a message received by this thread to the worker owning the
+ *    UE session. The connection id remains valid at the owner, since every
+ *    worker creates its GTP-C sockets in the same order. The message is
+ *    dropped if the inbox ring of the owner is full.
+ *
+ * @param owner
+ * @param data
+ */
+PRIVATE VOID forwardGtpcMsg(U32 owner, PktBuf *data)
+{
+   LOG_DEBUG("Forwarding GTPC Message to Worker [%d]", owner);
+
+   U32 producer = Worker::selfId();
+   if (RxThread::isRxThread())
+   {
+      producer = GSIM_RX_PRODUCER_ID;
+   }
+
+   if (!Worker::getWorker(owner)->postMsg(producer, data))
+   {
+      LOG_ERROR("Worker [%d] inbox full, dropping GTPC Message", owner);
+      Stats::incStats(GSIM_STAT_NUM_HANDOFF_DROPS);
+      data->unref();
+   }
+   else
+   {
+      Stats::incStats(GSIM_STAT_NUM_FWD_MSGS);
+   }
+}
+
+/**
+ * @brief
+ *    Processes a batch of GTP-C messages read from a socket with a single
+ *    system call
+ *
+ * @param msgs
+ * @param numMsgs
+ */
+PUBLIC VOID procGtpcMsgBatch(PktBuf **msgs, U32 numMsgs)
+{
+   LOG_ENTERFN();
+
+   Stats::incStats(GSIM_STAT_NUM_RECV_BATCHES);
+   Stats::addStats(GSIM_STAT_NUM_RECV_MSGS, numMsgs);
+
+   for (U32 i = 0; i < numMsgs; i++)
+   {
+      procGtpcMsg(msgs[i]);
+   }
 
    LOG_EXITVOID();
 }
@@ -182,8 +580,12 @@ VOID GtpImsiGenerator::allocNew(GtpImsiKey *pImsi)
 {
    LOG_ENTERFN();
 
-   numericStrIncriment(m_imsiStr, m_len); 
-   pImsi->len = encodeImsi(m_imsiStr, m_len, pImsi->val);
+   // skip the IMSIs owned by the other workers
+   do
+   {
+      numericStrIncriment(m_imsiStr, m_len); 
+      pImsi->len = encodeImsi(m_imsiStr, m_len, pImsi->val);
+   } while (getImsiOwner(pImsi) != Worker::selfId());
    
    LOG_EXITVOID();
 }
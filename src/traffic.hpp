@@ -17,6 +17,11 @@
 #ifndef __TRAFFIC_TASK__
 #define __TRAFFIC_TASK__
 
+#include <random>
+
+class PktBuf;
+class RateProfile;
+
 class GtpImsiGenerator
 {
    public:
@@ -29,22 +34,59 @@ class GtpImsiGenerator
       U32   m_len;
 };
 
-/* generates the traffic, if the scenario of Initiating type */
+/* generates the traffic, if the scenario of Initiating type. The burst
+ * pacing creates all the sessions of a rate period at the start of the
+ * period. The uniform and poisson pacing start the sessions one at a time,
+ * evenly spaced or at exponentially distributed intervals, at most the
+ * pacing burst of sessions back to back. The session rate is taken from
+ * the rate profile if one is loaded, which is always paced. With a
+ * concurrency window a due session is started only while the requests of
+ * the worker waiting for a response are fewer than the window, the task
+ * polls every timer tick for the window to open.
+ */
 class TrafficTask: public Task
 {
    public:
       TrafficTask();
       ~TrafficTask() {}
       RETVAL run(VOID *arg = NULL);  
-      inline Time_t wake() {return m_wakeTime;}
+      inline Time_t wake() {return m_wakeTime / 1000;}
+      inline Time_t wakeUs() {return m_wakeTime;}
 
    private:
+      BOOL              createSessions(U32 num);
+      VOID              runBurst();
+      VOID              runPaced(Time_t now);
+      VOID              stopTraffic();
+      BOOL              updateRate(Time_t now);
+      VOID              setOfferedRate(double rate, Time_t now);
+      U32               getWindowRoom(Time_t now);
+
       U32               m_rate;
       Time_t            m_ratePeriod;   
       Time_t            m_lastRunTime;
       Counter           m_maxSessions;
       GtpImsiGenerator  m_imsiGen;
-      Time_t            m_wakeTime;
+      Time_t            m_wakeTime;       /* micro-seconds */
+      PacingModeEn      m_pacing;
+      U32               m_burst;
+      double            m_interval;       /* mean session interval, us */
+      double            m_nextStart;      /* next paced session start, us */
+      std::mt19937      m_rng;
+      std::exponential_distribution<double> m_poisson;
+      double            m_offeredRate;    /* sessions per second */
+      Time_t            m_evalPeriod;     /* longest paced sleep, us */
+      const RateProfile *m_pProfile;
+      Time_t            m_profileStart;   /* micro-seconds */
+      U32               m_numWorkers;
+      BOOL              m_limitConc;
+      BOOL              m_aimd;
+      double            m_window;         /* pending requests limit */
+      BOOL              m_windowFull;     /* due sessions held back */
+      Counter           m_lastRsps;
+      Counter           m_lastTimeouts;
+      Time_t            m_lastDecrease;   /* micro-seconds */
+      Time_t            m_t3Time;         /* micro-seconds */
 };
 
 /* task for sending periodic echo request messages to the peer */
@@ -59,5 +101,7 @@ class GtpcEcho: public Task
       Time_t   m_ratePeriod;   
 };
 
-PUBLIC VOID procGtpcMsg(UdpData_t *data);
+PUBLIC VOID procGtpcMsg(PktBuf *data);
+PUBLIC VOID dispatchGtpcMsg(PktBuf *data);
+PUBLIC VOID procGtpcMsgBatch(PktBuf **msgs, U32 numMsgs);
 #endif
@@ -19,8 +19,14 @@
 
 EXTERN RETVAL initTransport();
 
+EXTERN RETVAL initRxTransport();
+
+EXTERN TransConnId getListenerConnId();
+
 EXTERN RETVAL setupStdinSock();
 
+EXTERN RETVAL setupInboxSock(S32 fd);
+
 EXTERN RETVAL sendMsg
 (
 TransConnId          connId,
@@ -30,4 +36,8 @@ Buffer               *pBuf
 
 EXTERN VOID socketPoll(S32 wait);
 
+EXTERN VOID setSchedTimer(Time_t wake, Time_t now);
+
+EXTERN VOID flushSockets();
+
 #endif
@@ -16,30 +16,41 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 #include "types.hpp"
 #include "error.hpp"
 #include "logger.hpp"
 #include "macros.hpp"
+#include "thread.hpp"
 #include "gtp_types.hpp"
+#include "gtp_util.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
 #include "sim_cfg.hpp"
+#include "obj_pool.hpp"
 #include "tunnel.hpp"
+#include "worker.hpp"
+#include "teid_table.hpp"
 
-static TunMap        s_gtpcTunMap;
-static U32           s_cTeid = 0;
-static U32           s_uTeid = 0;
+static thread_local TeidTable s_gtpcTeidTable;
+static thread_local U32       s_uTeid = 0;
 
 PRIVATE U32          generateUTeid();
-PRIVATE U32          generateCTeid();
-
-PRIVATE U32 generateCTeid()
-{
-   return ++s_cTeid;
-}
 
+/* TEIDs carry the id of the worker allocating them in the most significant
+ * bits, TEID 0 is never allocated. GTP-U TEIDs are not looked up and are
+ * taken from a counter, GTP-C TEIDs are allocated by the TEID table.
+ */
 PRIVATE U32 generateUTeid()
 {
-   return ++s_uTeid;
+   s_uTeid = (s_uTeid + 1) & GSIM_WORKER_TEID_MASK;
+   if (0 == s_uTeid)
+   {
+      s_uTeid = 1;
+   }
+
+   return (Worker::selfId() << GSIM_WORKER_TEID_SHIFT) | s_uTeid;
 }
 
 PUBLIC VOID deleteCTun(GtpcTun *pTun)
@@ -50,36 +61,66 @@ PUBLIC VOID deleteCTun(GtpcTun *pTun)
    if (pTun->m_refCount == 0)
    {
       LOG_DEBUG("Deleting GTP-C Tunnel, TEID [%d]", pTun->m_locTeid);
-      s_gtpcTunMap.erase(pTun->m_locTeid);
+      s_gtpcTeidTable.release(pTun->m_locTeid);
       delete pTun;
    }
 
    LOG_EXITVOID();
 }
 
+/**
+ * @brief
+ *    Sizes the tunnel pools of the calling worker, one control plane and
+ *    one user plane tunnel per session
+ *
+ * @param numSessions
+ */
+PUBLIC VOID reserveTunnels(U32 numSessions)
+{
+   ObjPool<GtpcTun>::local("GtpcTun").reserve(numSessions);
+   ObjPool<GtpuTun>::local("GtpuTun").reserve(numSessions);
+}
+
+VOID *GtpcTun::operator new(size_t size)
+{
+   return poolAlloc<GtpcTun>(size, "GtpcTun");
+}
+
+VOID GtpcTun::operator delete(VOID *pObj, size_t size)
+{
+   poolFree<GtpcTun>(pObj, size, "GtpcTun");
+}
+
+VOID *GtpuTun::operator new(size_t size)
+{
+   return poolAlloc<GtpuTun>(size, "GtpuTun");
+}
+
+VOID GtpuTun::operator delete(VOID *pObj, size_t size)
+{
+   poolFree<GtpuTun>(pObj, size, "GtpuTun");
+}
+
 GtpcTun::GtpcTun()
 {
-   m_locTeid = generateCTeid();
+   m_locTeid = s_gtpcTeidTable.alloc(this);
    m_remTeid = 0;
    m_refCount = 1;
    m_localEp.port = Config::getInstance()->getLocalGtpcPort();
    m_localEp.ipAddr = *(Config::getInstance()->getLocalIpAddr());
 
-   s_gtpcTunMap.insert(TunMapPair(m_locTeid, this));
    LOG_DEBUG("Creating GTP-C Tunnel, TEID [%d]", m_locTeid);
 }
 
 PUBLIC GtpcTun* findCTun(GtpTeid_t teid)
 {
-   GtpcTun     *pTun = NULL;
+   GtpcTun     *pTun = s_gtpcTeidTable.find(teid);
 
-   TunMapItr itr = s_gtpcTunMap.find(teid);
-   if (itr != s_gtpcTunMap.end())
+   if (NULL != pTun)
    {
-      pTun = itr->second;
       LOG_TRACE("Found GTP-C Tunnel, TEID [%d]", teid);
    }
-  
+
    LOG_EXITFN(pTun);
 }
 
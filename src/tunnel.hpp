@@ -25,6 +25,9 @@ class GtpcTun
    public:
       GtpcTun();
 
+      static VOID *operator new(size_t size);
+      static VOID  operator delete(VOID *pObj, size_t size);
+
       GtpTeid_t   m_locTeid;
       GtpTeid_t   m_remTeid;
 
@@ -49,16 +52,16 @@ class GtpuTun
 
    public:
       GtpuTun();
+
+      static VOID *operator new(size_t size);
+      static VOID  operator delete(VOID *pObj, size_t size);
       GtpTeid_t   localTeid() {return m_locTeid;}
       GtpTeid_t   remoteTeid() {return m_remTeid;}
 };
 
-typedef std::map<GtpTeid_t, GtpcTun*>  TunMap;
-typedef std::pair<GtpTeid_t,GtpcTun*>  TunMapPair;
-typedef TunMap::iterator               TunMapItr;
-
 EXTERN VOID       deleteCTun(GtpcTun *pTun);
 EXTERN GtpcTun*   findCTun(GtpTeid_t teid);
 PUBLIC GtpcTun*   createCTun(GtpcPdn *pPdn);
+EXTERN VOID       reserveTunnels(U32 numSessions);
 
 #endif
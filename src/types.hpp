@@ -55,6 +55,7 @@ typedef std::string        HexString;
 
 #define MEMSET          memset
 #define MEMCPY          memcpy
+#define MEMMOVE         memmove
 #define MEMCMP          memcmp
 #define STRCPY          strcpy
 #define STRNCPY         strncpy
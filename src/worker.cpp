@@ -0,0 +1,434 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "timer.hpp"
+#include "thread.hpp"
+#include "gtp_types.hpp"
+#include "gtp_if.hpp"
+#include "gtp_util.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "procedure.hpp"
+#include "gtp_stats.hpp"
+#include "sim_cfg.hpp"
+#include "keyboard.hpp"
+#include "transport.hpp"
+#include "sim.hpp"
+#include "worker.hpp"
+#include "pkt_buf.hpp"
+#include "pcap.hpp"
+
+EXTERN VOID dispatchGtpcMsg(PktBuf *data);
+
+static std::vector<Worker *> s_workers;
+static pthread_barrier_t     s_readyBarrier;
+static thread_local Worker * s_pSelf = NULL;
+static thread_local BOOL     s_isRxThread = FALSE;
+
+/**
+ * @brief
+ *    Creates a worker with an inbox ring for each of the producers, the
+ *    other workers and the receive thread
+ *
+ * @param id
+ * @param numWorkers
+ * @param rxRing
+ *    inbox ring is created for the receive thread, pipeline mode
+ * @param ringSize
+ */
+Worker::Worker(U32 id, U32 numWorkers, BOOL rxRing, U32 ringSize)
+{
+    m_id    = id;
+    m_pScn  = NULL;
+    m_inboxFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_inboxFd < 0)
+    {
+        LOG_FATAL("eventfd() failed, [%s]", strerror(errno));
+        throw ERR_SYS_SOCKET_CREATE;
+    }
+
+    m_wakeupPending = false;
+    for (U32 i = 0; i < GSIM_MAX_PRODUCERS; i++)
+    {
+        m_inbox[i] = NULL;
+        if (((i < numWorkers) && (i != id)) ||
+            ((GSIM_RX_PRODUCER_ID == i) && rxRing))
+        {
+            m_inbox[i] = new SpscRing<PktBuf *>(ringSize);
+        }
+    }
+}
+
+Worker::~Worker()
+{
+    for (U32 i = 0; i < GSIM_MAX_PRODUCERS; i++)
+    {
+        PktBuf *pMsg = NULL;
+        while ((NULL != m_inbox[i]) && m_inbox[i]->pop(&pMsg))
+        {
+            pMsg->unref();
+        }
+
+        delete m_inbox[i];
+    }
+
+    close(m_inboxFd);
+}
+
+/**
+ * @brief
+ *    Creates the workers, worker 0 is run by the main thread
+ *
+ * @param numWorkers
+ */
+VOID Worker::createWorkers(U32 numWorkers)
+{
+    LOG_ENTERFN();
+
+    Config *pCfg = Config::getInstance();
+
+    for (U32 i = 0; i < numWorkers; i++)
+    {
+        s_workers.push_back(new Worker(i, numWorkers,
+            pCfg->getPipelineMode(), pCfg->getHandoffRingSize()));
+    }
+
+    pthread_barrier_init(&s_readyBarrier, NULL, numWorkers);
+    s_pSelf = s_workers[0];
+
+    LOG_EXITVOID();
+}
+
+VOID Worker::deleteWorkers()
+{
+    for (U32 i = 0; i < s_workers.size(); i++)
+    {
+        delete s_workers[i];
+    }
+
+    s_workers.clear();
+    pthread_barrier_destroy(&s_readyBarrier);
+}
+
+U32 Worker::numWorkers()
+{
+    return s_workers.size();
+}
+
+Worker *Worker::getWorker(U32 id)
+{
+    return s_workers[id];
+}
+
+/**
+ * @brief
+ *    Returns the worker running the calling thread
+ */
+Worker *Worker::self()
+{
+    return s_pSelf;
+}
+
+U32 Worker::selfId()
+{
+    return (NULL == s_pSelf) ? 0 : s_pSelf->m_id;
+}
+
+/**
+ * @brief
+ *    Waits until all the workers have created their sockets and loaded
+ *    the scenario, so that no worker starts the traffic before a peer
+ *    worker is ready to receive it
+ */
+VOID Worker::waitAllReady()
+{
+    pthread_barrier_wait(&s_readyBarrier);
+}
+
+U32 Worker::id()
+{
+    return m_id;
+}
+
+Scenario *Worker::scenario()
+{
+    return m_pScn;
+}
+
+S32 Worker::inboxFd()
+{
+    return m_inboxFd;
+}
+
+/**
+ * @brief
+ *    Records the scenario instance loaded by the worker, used for
+ *    summing up the procedure statistics of all the workers
+ *
+ * @param pScn
+ */
+VOID Worker::attach(Scenario *pScn)
+{
+    m_pScn = pScn;
+}
+
+/**
+ * @brief
+ *    Hands over a received message to the worker owning the session, called
+ *    from the receiving thread. The owner is woken up through the inbox
+ *    event fd, unless a wake up is already pending.
+ *
+ * @param producer
+ *    id of the calling worker or GSIM_RX_PRODUCER_ID
+ * @param pMsg
+ *
+ * @return
+ *    FALSE if the inbox ring of the producer is full
+ */
+BOOL Worker::postMsg(U32 producer, PktBuf *pMsg)
+{
+    if (!m_inbox[producer]->push(pMsg))
+    {
+        return FALSE;
+    }
+
+    if (!m_wakeupPending.exchange(true))
+    {
+        U64 event = 1;
+        if (write(m_inboxFd, &event, sizeof(event)) < 0)
+        {
+            LOG_ERROR("Waking up worker [%d], [%s]", m_id, strerror(errno));
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief
+ *    Processes the messages handed over by the other workers and the
+ *    receive thread, called by the owning worker when the inbox event fd
+ *    is readable
+ */
+VOID Worker::procInbox()
+{
+    U64 events = 0;
+    if (read(m_inboxFd, &events, sizeof(events)) < 0)
+    {
+        if ((EAGAIN != errno) && (EWOULDBLOCK != errno))
+        {
+            LOG_ERROR("Reading worker inbox, [%s]", strerror(errno));
+        }
+    }
+
+    /* a message posted after this point wakes up the worker again */
+    m_wakeupPending = false;
+
+    for (U32 i = 0; i < GSIM_MAX_PRODUCERS; i++)
+    {
+        if (NULL == m_inbox[i])
+        {
+            continue;
+        }
+
+        /* read only the messages present now, a producer filling the
+         * ring must not starve the other rings
+         */
+        U32     numMsgs = m_inbox[i]->size();
+        PktBuf *pMsg    = NULL;
+        while (numMsgs-- && m_inbox[i]->pop(&pMsg))
+        {
+            /* messages read by the receive thread are replied on the
+             * listener socket of the worker
+             */
+            if (GSIM_RX_PRODUCER_ID == i)
+            {
+                pMsg->connId = getListenerConnId();
+            }
+
+            dispatchGtpcMsg(pMsg);
+        }
+    }
+}
+
+/**
+ * @brief
+ *    Number of messages waiting in the inbox rings of the worker
+ */
+U32 Worker::inboxOccupancy()
+{
+    U32 occupancy = 0;
+    for (U32 i = 0; i < GSIM_MAX_PRODUCERS; i++)
+    {
+        if (NULL != m_inbox[i])
+        {
+            occupancy += m_inbox[i]->size();
+        }
+    }
+
+    return occupancy;
+}
+
+VOID Worker::run(VOID *arg)
+{
+    s_pSelf = this;
+    Simulator::getInstance()->runWorker();
+}
+
+RxThread::RxThread()
+{
+    m_initRet = ROK;
+    pthread_barrier_init(&m_readyBarrier, NULL, 2);
+}
+
+RxThread::~RxThread()
+{
+    pthread_barrier_destroy(&m_readyBarrier);
+}
+
+/**
+ * @brief
+ *    Starts the receive thread and waits until it has created the listener
+ *    socket, the workers send their replies on the same socket
+ */
+RETVAL RxThread::startRx()
+{
+    LOG_ENTERFN();
+
+    if (0 != start(NULL))
+    {
+        LOG_FATAL("Creating Receive thread");
+        LOG_EXITFN(ERR_THREAD_CREATE);
+    }
+
+    pthread_barrier_wait(&m_readyBarrier);
+
+    LOG_EXITFN(m_initRet);
+}
+
+BOOL RxThread::isRxThread()
+{
+    return s_isRxThread;
+}
+
+/**
+ * @brief
+ *    Reads the listener socket till the simulator is stopped, the messages
+ *    are handed over to the owning workers by procGtpcMsg()
+ */
+VOID RxThread::run(VOID *arg)
+{
+    s_isRxThread = TRUE;
+    getMilliSeconds();
+    Stats::attachWorker(GSIM_RX_PRODUCER_ID);
+
+    m_initRet = initRxTransport();
+    pthread_barrier_wait(&m_readyBarrier);
+    if (ROK != m_initRet)
+    {
+        return;
+    }
+
+    while (KB_KEY_SIM_QUIT != Keyboard::key)
+    {
+        socketPoll(GSIM_SCHED_MAX_WAIT / 1000);
+    }
+
+    Pcap::flush();
+}
+
+/**
+ * @brief
+ *    Splits a total, session rate or number of sessions, among the workers
+ *    and returns the share of the calling worker
+ *
+ * @param total
+ */
+PUBLIC U32 getWorkerShare(U32 total)
+{
+    U32 numWorkers = (s_workers.size() > 0) ? s_workers.size() : 1;
+    U32 share      = total / numWorkers;
+
+    if (Worker::selfId() < (total % numWorkers))
+    {
+        share++;
+    }
+
+    return share;
+}
+
+PUBLIC VOID procWorkerInbox()
+{
+    s_pSelf->procInbox();
+}
+
+/**
+ * @brief
+ *    Selects the worker owning the UE session of an IMSI. The owner is
+ *    IMSI modulo number of workers, the IMSI generator of a worker
+ *    allocates only the IMSIs owned by it.
+ *
+ * @param pImsi
+ *    BCD encoded IMSI
+ */
+PUBLIC U32 getImsiOwner(GtpImsiKey *pImsi)
+{
+    U32 numWorkers = s_workers.size();
+    U32 owner      = 0;
+
+    if (numWorkers <= 1)
+    {
+        return 0;
+    }
+
+    for (U32 i = 0; i < pImsi->len; i++)
+    {
+        U8 lowDigit  = pImsi->val[i] & 0x0f;
+        U8 highDigit = pImsi->val[i] >> 4;
+
+        owner = (owner * 10 + lowDigit) % numWorkers;
+        if (0x0f != highDigit)
+        {
+            owner = (owner * 10 + highDigit) % numWorkers;
+        }
+    }
+
+    return owner;
+}
+
+/**
+ * @brief
+ *    Selects the worker owning a TEID, from the worker id in the most
+ *    significant bits of the TEID
+ *
+ * @param teid
+ */
+PUBLIC U32 getTeidOwner(GtpTeid_t teid)
+{
+    U32 owner = teid >> GSIM_WORKER_TEID_SHIFT;
+    return (owner < s_workers.size()) ? owner : 0;
+}
@@ -0,0 +1,114 @@
+/*  Copyright (C) 2013  Nithin Nellikunnu, nithin.nn@gmail.com
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* A worker is a scheduler thread owning a shard of the UE sessions. Each
+ * worker has its own task lists, time wheel, session and tunnel tables,
+ * peer table, statistics and sockets. Worker 0 runs on the main thread
+ * and also owns the display and the keyboard.
+ *
+ * A UE session is owned by the worker selected by the IMSI, and all the
+ * TEIDs allocated by a worker carry the worker id in the most significant
+ * bits, so that a message received by any worker is handed over to the
+ * owning worker.
+ *
+ * Messages are handed over through lock free single producer, single
+ * consumer rings, every worker has one inbox ring per producer. In the
+ * pipeline mode a receive thread reads the GTP-C listener socket, selects
+ * the owner of a message from the GTP header and hands the message over to
+ * the owner, the workers do the session processing.
+ */
+
+#ifndef _WORKER_HPP_
+#define _WORKER_HPP_
+
+#include "spsc_ring.hpp"
+
+class PktBuf;
+
+#define GSIM_MAX_WORKERS         16
+#define GSIM_WORKER_TEID_SHIFT   28
+#define GSIM_WORKER_TEID_MASK    ((1U << GSIM_WORKER_TEID_SHIFT) - 1)
+
+/* producers of the inbox rings, the workers and the receive thread */
+#define GSIM_RX_PRODUCER_ID      GSIM_MAX_WORKERS
+#define GSIM_MAX_PRODUCERS       (GSIM_MAX_WORKERS + 1)
+
+class Scenario;
+
+class Worker: public CThread
+{
+   public:
+      ~Worker();
+
+      static VOID      createWorkers(U32 numWorkers);
+      static VOID      deleteWorkers();
+      static U32       numWorkers();
+      static Worker   *getWorker(U32 id);
+      static Worker   *self();
+      static U32       selfId();
+      static VOID      waitAllReady();
+
+      U32              id();
+      Scenario        *scenario();
+      S32              inboxFd();
+      VOID             attach(Scenario *pScn);
+      BOOL             postMsg(U32 producer, PktBuf *pMsg);
+      VOID             procInbox();
+      U32              inboxOccupancy();
+
+   protected:
+      VOID             run(VOID *arg);
+
+   private:
+      Worker(U32 id, U32 numWorkers, BOOL rxRing, U32 ringSize);
+
+      U32                       m_id;
+      Scenario                 *m_pScn;
+      S32                       m_inboxFd;
+      SpscRing<PktBuf *>       *m_inbox[GSIM_MAX_PRODUCERS];
+
+      /* set by the producer which wakes up the worker through the inbox
+       * event fd, cleared by the worker before reading the inbox rings
+       */
+      std::atomic<bool>         m_wakeupPending;
+};
+
+/* Receive thread of the pipeline mode, reads the GTP-C listener socket
+ * and hands over the messages to the owning workers
+ */
+class RxThread: public CThread
+{
+   public:
+      RxThread();
+      ~RxThread();
+
+      RETVAL           startRx();
+      static BOOL      isRxThread();
+
+   protected:
+      VOID             run(VOID *arg);
+
+   private:
+      pthread_barrier_t         m_readyBarrier;
+      RETVAL                    m_initRet;
+};
+
+PUBLIC U32 getImsiOwner(GtpImsiKey *pImsi);
+PUBLIC U32 getTeidOwner(GtpTeid_t teid);
+PUBLIC U32 getWorkerShare(U32 total);
+PUBLIC VOID procWorkerInbox();
+
+#endif
@@ -0,0 +1,181 @@
+/* Encode and decode throughput of a Create Session Request carrying
+ * GTP_MAX_BEARERS bearer contexts
+ *
+ *    ./gtp_msg_perf [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <list>
+#include <vector>
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "gtp_types.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "gtp_util.hpp"
+#include "gtp_tmpl.hpp"
+
+static U32 addIe(U8 *pBuf, U8 type, U8 inst, const U8 *pVal, U32 len)
+{
+   pBuf[0] = type;
+   pBuf[1] = (U8)(len >> 8);
+   pBuf[2] = (U8)len;
+   pBuf[3] = inst;
+   MEMCPY(pBuf + GTP_IE_HDR_LEN, pVal, len);
+
+   return GTP_IE_HDR_LEN + len;
+}
+
+static U32 buildCsReq(U8 *pBuf)
+{
+   U8  imsi[] = {0x21, 0x43, 0x65, 0x87, 0x09, 0x21, 0x43, 0xf5};
+   U8  msisdn[] = {0x19, 0x32, 0x54, 0x76, 0x98, 0xf0};
+   U8  rat[] = {6};
+   U8  fteid[] = {0x8a, 0x00, 0x00, 0x00, 0x01, 0x0a, 0x00, 0x00, 0x01};
+   U8  pgwFteid[] = {0x87, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x02};
+   U8  apn[] = {0x03, 'a', 'p', 'n', 0x03, 'c', 'o', 'm'};
+   U8  selMode[] = {0};
+   U8  pdnType[] = {1};
+   U8  paa[] = {1, 0, 0, 0, 0};
+   U8  ambr[] = {0, 0, 0x10, 0, 0, 0, 0x10, 0};
+   U8  qos[] = {0x09, 0x09, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                0, 0, 0, 0, 0};
+   U32 off = GTP_MSG_HDR_LEN;
+
+   MEMSET(pBuf, 0, GTP_MSG_BUF_LEN);
+   pBuf[0] = 0x48;
+   pBuf[1] = GTPC_MSG_CS_REQ;
+
+   off += addIe(pBuf + off, GTP_IE_IMSI, 0, imsi, sizeof(imsi));
+   off += addIe(pBuf + off, GTP_IE_MSISDN, 0, msisdn, sizeof(msisdn));
+   off += addIe(pBuf + off, GTP_IE_RAT_TYPE, 0, rat, sizeof(rat));
+   off += addIe(pBuf + off, GTP_IE_FTEID, 0, fteid, sizeof(fteid));
+   off += addIe(pBuf + off, GTP_IE_FTEID, 1, pgwFteid, sizeof(pgwFteid));
+   off += addIe(pBuf + off, GTP_IE_APN, 0, apn, sizeof(apn));
+   off += addIe(pBuf + off, GTP_IE_SELECTION_MODE, 0, selMode,\
+         sizeof(selMode));
+   off += addIe(pBuf + off, GTP_IE_PDN_TYPE, 0, pdnType, sizeof(pdnType));
+   off += addIe(pBuf + off, GTP_IE_PAA, 0, paa, sizeof(paa));
+   off += addIe(pBuf + off, GTP_IE_AMBR, 0, ambr, sizeof(ambr));
+
+   for (U32 i = 0; i < GTP_MAX_BEARERS; i++)
+   {
+      U8  grp[64];
+      U8  ebi[] = {(U8)(5 + i)};
+      U8  s1u[] = {0x80, 0x00, 0x00, 0x01, (U8)i, 0x0a, 0x00, 0x00, 0x03};
+      U32 grpLen = 0;
+
+      grpLen += addIe(grp + grpLen, GTP_IE_EBI, 0, ebi, sizeof(ebi));
+      grpLen += addIe(grp + grpLen, GTP_IE_FTEID, 0, s1u, sizeof(s1u));
+      grpLen += addIe(grp + grpLen, GTP_IE_BEARER_QOS, 0, qos, sizeof(qos));
+      off += addIe(pBuf + off, GTP_IE_BEARER_CNTXT, 0, grp, grpLen);
+   }
+
+   pBuf[2] = (U8)((off - GTPC_HDR_MAND_LEN) >> 8);
+   pBuf[3] = (U8)(off - GTPC_HDR_MAND_LEN);
+
+   return off;
+}
+
+static U64 nowNsec()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (U64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static VOID report(const S8 *pName, U64 start, U32 iter)
+{
+   U64 nsec = nowNsec() - start;
+   printf("%-36s %8.1f ns/msg %12.0f msgs/s\n", pName,\
+         (double)nsec / iter, (double)iter * 1000000000 / nsec);
+}
+
+int main(int argc, char **argv)
+{
+   U8          csReq[GTP_MSG_BUF_LEN];
+   U32         len = buildCsReq(csReq);
+   U32         iter = (argc > 1) ? atoi(argv[1]) : 200000;
+   U64         start = 0;
+   U32         sink = 0;
+
+   printf("Create Session Request, %u bytes, %u bearer contexts\n",\
+         len, GTP_MAX_BEARERS);
+
+   /* receive path, header and the fields read by the session */
+   start = nowNsec();
+   for (U32 i = 0; i < iter; i++)
+   {
+      GtpMsg      msg(csReq, len);
+      GtpTeid_t   teid = 0;
+      GtpEbi_t    ebi[GTP_MAX_BEARERS];
+
+      msg.getFteidTeid(0, &teid);
+      sink += teid + msg.getBearerEbis(0, ebi, GTP_MAX_BEARERS);
+   }
+   report("decode, indexed accessors", start, iter);
+
+   /* receive path, all the IEs decoded and each bearer looked up */
+   start = nowNsec();
+   for (U32 i = 0; i < iter; i++)
+   {
+      GtpMsg msg(csReq, len);
+      msg.decode();
+
+      U32 bearerCnt = msg.getIeCount(GTP_IE_BEARER_CNTXT, 0);
+      for (U32 b = 1; b <= bearerCnt; b++)
+      {
+         GtpBearerContext *pBearerCntxt = gtpIeCast<GtpBearerContext>\
+               (msg.getIe(GTP_IE_BEARER_CNTXT, 0, b));
+         sink += pBearerCntxt->getEbi();
+      }
+   }
+   report("decode, all IEs", start, iter);
+
+   /* send path, the scenario message is decoded once */
+   GtpMsg      scnMsg(csReq, len);
+   GtpImsiKey  imsi;
+   IpAddr      ip;
+   GtpMsgPatch patch;
+
+   scnMsg.decode();
+   MEMSET(&patch, 0, sizeof(patch));
+   MEMSET(&ip, 0, sizeof(ip));
+   imsi.len = 8;
+   MEMCPY(imsi.val, csReq + GTP_MSG_HDR_LEN + GTP_IE_HDR_LEN, imsi.len);
+   ip.ipAddrType = IP_ADDR_TYPE_V4;
+   patch.pImsi = &imsi;
+   patch.pSenderIp = &ip;
+
+   start = nowNsec();
+   for (U32 i = 0; i < iter; i++)
+   {
+      U8  buf[GTP_MSG_BUF_LEN];
+      U32 encLen = 0;
+      scnMsg.encode(buf, &encLen);
+      sink += encLen;
+   }
+   report("encode, all IEs", start, iter);
+
+   GtpMsgTmpl *pTmpl = GtpMsgTmpl::compile(&scnMsg);
+   start = nowNsec();
+   for (U32 i = 0; i < iter; i++)
+   {
+      Buffer buf;
+      patch.seqN = i;
+      patch.bearerTeid[i % GTP_MAX_BEARERS] = i;
+      pTmpl->encode(&patch, &buf);
+      sink += buf.len;
+   }
+   report("encode, wire template", start, iter);
+   delete pTmpl;
+
+   return (0 == sink) ? 1 : 0;
+}
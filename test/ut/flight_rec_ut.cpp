@@ -0,0 +1,113 @@
+#include <limits.h>
+#include <list>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_types.hpp"
+#include "gtp_macro.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "flight_rec.hpp"
+
+#define FLIGHT_REC_UT_FILE    "flight_rec_ut.log"
+
+/* Create Session Request header, TEID 0x01020304 and sequence number
+ * 0x0a0b0c
+ */
+static U8 s_csReq[] =
+{
+   0x48, 0x20, 0x00, 0x08, 0x01, 0x02, 0x03, 0x04,
+   0x0a, 0x0b, 0x0c, 0x00,
+};
+
+/* Echo Request without a TEID, sequence number 0x000005 */
+static U8 s_echoReq[] =
+{
+   0x40, 0x01, 0x00, 0x04, 0x00, 0x00, 0x05, 0x00,
+};
+
+static std::string readFile(const S8 *pFileName)
+{
+   std::ifstream     file(pFileName);
+   std::stringstream str;
+
+   str << file.rdbuf();
+   return str.str();
+}
+
+static VOID initImsi(GtpImsiKey *pImsi)
+{
+   U8 imsi[] = {0x21, 0x43, 0x65, 0x87, 0x09, 0x21, 0x43, 0xf5};
+
+   pImsi->len = sizeof(imsi);
+   MEMCPY(pImsi->val, imsi, sizeof(imsi));
+}
+
+TEST(flightRecTest, Header)
+{
+   FlightRecorder rec;
+   GtpImsiKey     imsi;
+
+   initImsi(&imsi);
+   ASSERT_EQ(ROK, FlightRecorder::open(FLIGHT_REC_UT_FILE));
+   rec.record(MSG_EVENT_SENT, 10, s_csReq, sizeof(s_csReq));
+   rec.record(MSG_EVENT_RCVD, 20, s_echoReq, sizeof(s_echoReq));
+   rec.dump("Test failure", 7, &imsi, s_echoReq, sizeof(s_echoReq));
+   FlightRecorder::close();
+
+   std::string log = readFile(FLIGHT_REC_UT_FILE);
+   EXPECT_NE(std::string::npos,
+         log.find("Session [7] IMSI [123456789012345] Test failure"));
+   EXPECT_NE(std::string::npos, log.find("last 2 of 2 message events"));
+   EXPECT_NE(std::string::npos,
+         log.find("TEID [0x01020304] SeqN [0x0a0b0c] Length [12]"));
+   EXPECT_NE(std::string::npos,
+         log.find("TEID [0x00000000] SeqN [0x000005] Length [8]"));
+   EXPECT_NE(std::string::npos,
+         log.find("0000  40 01 00 04 00 00 05 00\n"));
+
+   remove(FLIGHT_REC_UT_FILE);
+}
+
+TEST(flightRecTest, Wrap)
+{
+   FlightRecorder rec;
+   GtpImsiKey     imsi;
+   U8             msg[sizeof(s_echoReq)];
+
+   /* only the last events are kept, oldest first */
+   initImsi(&imsi);
+   ASSERT_EQ(ROK, FlightRecorder::open(FLIGHT_REC_UT_FILE));
+   MEMCPY(msg, s_echoReq, sizeof(msg));
+   for (U32 i = 0; i < FLIGHT_REC_NUM_EVENTS + 3; i++)
+   {
+      msg[6] = (U8)i;
+      rec.record(MSG_EVENT_SENT, i, msg, sizeof(msg));
+   }
+
+   rec.dump("Test failure", 1, &imsi, NULL, 0);
+   FlightRecorder::close();
+
+   std::string log = readFile(FLIGHT_REC_UT_FILE);
+   std::ostringstream events;
+   events << "last " << FLIGHT_REC_NUM_EVENTS << " of " <<
+         FLIGHT_REC_NUM_EVENTS + 3 << " message events";
+   EXPECT_NE(std::string::npos, log.find(events.str()));
+   EXPECT_EQ(std::string::npos, log.find("SeqN [0x000002]"));
+   size_t first = log.find("SeqN [0x000003]");
+   size_t last  = log.find("SeqN [0x00000a]");
+   EXPECT_NE(std::string::npos, first);
+   EXPECT_NE(std::string::npos, last);
+   EXPECT_LT(first, last);
+   EXPECT_EQ(std::string::npos, log.find("message,"));
+
+   remove(FLIGHT_REC_UT_FILE);
+}
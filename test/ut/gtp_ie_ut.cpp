@@ -0,0 +1,114 @@
+#include <limits.h>
+#include <list>
+#include <iostream>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "gtp_types.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+
+#define GTP_IE_UT_INSTANCE    3
+
+/* encodes an IE header followed by a value of the given length */
+static VOID encTestIe(U8 *pBuf, GtpIeType_t type, GtpLength_t len)
+{
+   pBuf[0] = type;
+   pBuf[1] = (U8)(len >> 8);
+   pBuf[2] = (U8)len;
+   pBuf[3] = GTP_IE_UT_INSTANCE;
+   for (U32 i = 0; i < len; i++)
+   {
+      pBuf[GTP_IE_HDR_LEN + i] = (U8)(i * 7 + type);
+   }
+}
+
+/* every IE of the catalogue is created by the factory, and the IE value of
+ * any length the IE class holds is encoded back as it was decoded
+ */
+template <class C> static VOID testGtpIeCodec()
+{
+   GtpIeType_t type    = GtpIeTraits<C>::type;
+   GtpLength_t maxLen  = GtpIeTraits<C>::maxLen;
+   BOOL        grouped = GtpIeTraits<C>::grouped;
+
+   GtpIe *pIe = GtpIe::createGtpIe(type, GTP_IE_UT_INSTANCE);
+   ASSERT_TRUE(NULL != pIe);
+   EXPECT_EQ(type, pIe->type());
+   EXPECT_EQ(GTP_IE_UT_INSTANCE, pIe->instance());
+   EXPECT_EQ(grouped, pIe->isGroupedIe());
+   EXPECT_EQ(pIe, gtpIeCast<C>(pIe));
+
+   U8 inBuf[GTP_IE_HDR_LEN + GTP_MSG_BUF_LEN];
+   U8 outBuf[GTP_IE_HDR_LEN + GTP_MSG_BUF_LEN];
+   for (GtpLength_t len = 0; len <= maxLen; len++)
+   {
+      encTestIe(inBuf, type, len);
+      MEMSET(outBuf, 0, sizeof(outBuf));
+
+      EXPECT_EQ(GTP_IE_HDR_LEN + len, pIe->decode(inBuf));
+      ASSERT_EQ(GTP_IE_HDR_LEN + len, pIe->encode(outBuf));
+      EXPECT_EQ(0, memcmp(inBuf, outBuf, GTP_IE_HDR_LEN + len)) <<
+            "IE type " << (U32)type << ", length " << len;
+   }
+
+   encTestIe(inBuf, type, maxLen + 1);
+   EXPECT_THROW(pIe->decode(inBuf), ErrCodeEn);
+
+   delete pIe;
+}
+
+TEST(gtpIeTest, Codec)
+{
+   Logger::m_logLevel = LOG_LVL_START;
+
+#define GTP_IE_UT_CODEC(_type, _class, _maxLen, _grouped)\
+   testGtpIeCodec<_class>();
+
+   GTP_IE_CATALOGUE(GTP_IE_UT_CODEC)
+
+#undef GTP_IE_UT_CODEC
+}
+
+TEST(gtpIeTest, Factory)
+{
+   U32 numIes = 0;
+
+#define GTP_IE_UT_COUNT(_type, _class, _maxLen, _grouped)\
+   numIes++;
+
+   GTP_IE_CATALOGUE(GTP_IE_UT_COUNT)
+
+#undef GTP_IE_UT_COUNT
+
+   U32 numCreated = 0;
+   for (U32 type = 0; type <= 255; type++)
+   {
+      GtpIe *pIe = GtpIe::createGtpIe((GtpIeType_t)type, 0);
+      if (NULL != pIe)
+      {
+         EXPECT_EQ(type, pIe->type());
+         numCreated++;
+         delete pIe;
+      }
+   }
+
+   EXPECT_EQ(numIes, numCreated);
+}
+
+TEST(gtpIeTest, Cast)
+{
+   GtpIe *pIe = GtpIe::createGtpIe(GTP_IE_FTEID, 0);
+
+   EXPECT_TRUE(NULL != gtpIeCast<GtpFteid>(pIe));
+   EXPECT_EQ(NULL, gtpIeCast<GtpImsi>(pIe));
+   EXPECT_EQ(NULL, gtpIeCast<GtpBearerContext>(pIe));
+   EXPECT_EQ(NULL, gtpIeCast<GtpFteid>(NULL));
+
+   delete pIe;
+}
@@ -0,0 +1,118 @@
+#include <limits.h>
+#include <list>
+#include <iostream>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "gtp_types.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "gtp_util.hpp"
+
+/* Create Session Request with a recovery IE before the IMSI */
+static U8 s_csReq[] =
+{
+   0x48, 0x20, 0x00, 0x19, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x01, 0x02, 0x00,
+   /* recovery */
+   0x03, 0x00, 0x01, 0x00, 0x07,
+   /* IMSI */
+   0x01, 0x00, 0x08, 0x00, 0x21, 0x43, 0x65, 0x87,
+   0x09, 0x21, 0x43, 0xf5,
+};
+
+/* Echo Request, without a TEID */
+static U8 s_echoReq[] =
+{
+   0x40, 0x01, 0x00, 0x09, 0x00, 0x00, 0x05, 0x00,
+   0x03, 0x00, 0x01, 0x00, 0x07,
+};
+
+TEST(gtpMsgParseTest, CreateSessionRequest)
+{
+   GtpMsgDesc desc;
+
+   ASSERT_EQ(ROK, GtpMsg::parse(s_csReq, sizeof(s_csReq), &desc));
+   EXPECT_EQ(GTPC_MSG_CS_REQ, desc.hdr.msgType);
+   EXPECT_EQ(0x19, desc.hdr.len);
+   EXPECT_EQ(0, desc.hdr.teid);
+   EXPECT_EQ(0x102, desc.hdr.seqN);
+   EXPECT_EQ(GTP_MSG_HDR_LEN, desc.ieOff);
+   EXPECT_EQ(sizeof(s_csReq) - GTP_MSG_HDR_LEN, desc.ieLen);
+   EXPECT_EQ(21, desc.imsiOff);
+   EXPECT_EQ(8, desc.imsiLen);
+
+   GtpMsg msg(s_csReq, &desc);
+   EXPECT_EQ(GTPC_MSG_CS_REQ, msg.type());
+   EXPECT_EQ(0x102, msg.seqNumber());
+   EXPECT_EQ(1, msg.getIeCount(GTP_IE_IMSI, 0));
+}
+
+TEST(gtpMsgParseTest, NoTeid)
+{
+   GtpMsgDesc desc;
+
+   ASSERT_EQ(ROK, GtpMsg::parse(s_echoReq, sizeof(s_echoReq), &desc));
+   EXPECT_FALSE(GSIM_CHK_MASK(desc.hdr.pres, GTP_MSG_T_BIT_PRES));
+   EXPECT_EQ(0x5, desc.hdr.seqN);
+   EXPECT_EQ(GTP_MSG_HDR_LEN_WITHOUT_TEID, desc.ieOff);
+   EXPECT_EQ(5, desc.ieLen);
+   EXPECT_EQ(0, desc.imsiOff);
+}
+
+TEST(gtpMsgParseTest, Invalid)
+{
+   GtpMsgDesc desc;
+   U8         buf[sizeof(s_csReq) + 4];
+
+   Logger::m_logLevel = LOG_LVL_START;
+
+   /* truncated, shorter than the header and shorter than the length */
+   EXPECT_EQ(ERR_INVALID_GTP_MSG, GtpMsg::parse(s_csReq, 7, &desc));
+   EXPECT_EQ(ERR_INVALID_GTP_MSG, GtpMsg::parse(s_csReq, 11, &desc));
+   EXPECT_EQ(ERR_INVALID_GTP_MSG,
+         GtpMsg::parse(s_csReq, sizeof(s_csReq) - 1, &desc));
+
+   /* not GTPv2 */
+   MEMCPY(buf, s_csReq, sizeof(s_csReq));
+   buf[0] = 0x28;
+   EXPECT_EQ(ERR_INVALID_GTP_MSG, GtpMsg::parse(buf, sizeof(s_csReq), &desc));
+
+   /* length shorter than the header */
+   MEMCPY(buf, s_echoReq, sizeof(s_echoReq));
+   buf[0] = 0x48;
+   buf[3] = 0x04;
+   EXPECT_EQ(ERR_INVALID_GTP_MSG,
+         GtpMsg::parse(buf, sizeof(s_echoReq), &desc));
+
+   /* recovery IE overrunning the message */
+   MEMCPY(buf, s_csReq, sizeof(s_csReq));
+   buf[14] = 0x20;
+   EXPECT_EQ(ERR_INVALID_IE_LENGTH,
+         GtpMsg::parse(buf, sizeof(s_csReq), &desc));
+
+   /* IMSI longer than an IMSI can be */
+   MEMCPY(buf, s_csReq, sizeof(s_csReq));
+   buf[3] = 0x1a;
+   buf[19] = 0x09;
+   EXPECT_EQ(ERR_INVALID_IE_LENGTH,
+         GtpMsg::parse(buf, sizeof(s_csReq) + 1, &desc));
+}
+
+TEST(gtpMsgParseTest, Piggybacked)
+{
+   GtpMsgDesc desc;
+   U8         buf[sizeof(s_csReq) + sizeof(s_echoReq)];
+
+   /* the bytes after the length in the header are not part of the message */
+   MEMCPY(buf, s_csReq, sizeof(s_csReq));
+   MEMCPY(buf + sizeof(s_csReq), s_echoReq, sizeof(s_echoReq));
+   ASSERT_EQ(ROK, GtpMsg::parse(buf, sizeof(buf), &desc));
+   EXPECT_EQ(sizeof(s_csReq) - GTP_MSG_HDR_LEN, desc.ieLen);
+}
@@ -0,0 +1,230 @@
+#include <limits.h>
+#include <list>
+#include <iostream>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "gtp_macro.hpp"
+#include "gtp_types.hpp"
+#include "gtp_if.hpp"
+#include "gtp_ie.hpp"
+#include "gtp_msg.hpp"
+#include "gtp_util.hpp"
+#include "gtp_tmpl.hpp"
+
+/* Create Session Request with an IMSI, the sender F-TEID, the PGW F-TEID of
+ * instance 1 and a bearer context for EBI 5 with an S1-U F-TEID
+ */
+static U8 s_csReq[] =
+{
+   0x48, 0x20, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x00, 0x01, 0x00,
+   /* IMSI */
+   0x01, 0x00, 0x08, 0x00, 0x21, 0x43, 0x65, 0x87,
+   0x09, 0x21, 0x43, 0xf5,
+   /* sender F-TEID */
+   0x57, 0x00, 0x09, 0x00, 0x8a, 0x00, 0x00, 0x00,
+   0x01, 0x0a, 0x00, 0x00, 0x01,
+   /* PGW S5/S8 F-TEID, instance 1 */
+   0x57, 0x00, 0x09, 0x01, 0x87, 0x00, 0x00, 0x00,
+   0x02, 0x0a, 0x00, 0x00, 0x02,
+   /* bearer context, EBI 5, S1-U eNodeB F-TEID */
+   0x5d, 0x00, 0x12, 0x00,
+   0x49, 0x00, 0x01, 0x00, 0x05,
+   0x57, 0x00, 0x09, 0x00, 0x80, 0x00, 0x00, 0x00,
+   0x03, 0x0a, 0x00, 0x00, 0x03,
+};
+
+/* Delete Session Request with a single EBI, nothing is patched but the
+ * header
+ */
+static U8 s_dsReq[] =
+{
+   0x48, 0x24, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x00, 0x02, 0x00,
+   0x49, 0x00, 0x01, 0x00, 0x05,
+};
+
+static GtpMsg *decodeMsg(U8 *pBuf, U32 len)
+{
+   GtpMsg *pGtpMsg = new GtpMsg(pBuf, len);
+   pGtpMsg->decode();
+   return pGtpMsg;
+}
+
+static VOID initPatch(GtpMsgPatch *pPatch, GtpImsiKey *pImsi, IpAddr *pIp)
+{
+   MEMSET(pPatch, 0, sizeof(GtpMsgPatch));
+   MEMSET(pImsi, 0, sizeof(GtpImsiKey));
+   MEMSET(pIp, 0, sizeof(IpAddr));
+
+   U8 imsi[] = {0x21, 0x43, 0x65, 0x87, 0x09, 0x21, 0x43, 0xf5};
+   pImsi->len = sizeof(imsi);
+   MEMCPY(pImsi->val, imsi, sizeof(imsi));
+
+   pIp->ipAddrType = IP_ADDR_TYPE_V4;
+   pIp->u.ipv4Addr.addr = 0xc0a80101;
+}
+
+/* reference encoding, the per session values are set in a message owned
+ * by the test and all the IEs are encoded
+ */
+static VOID encRefMsg(GtpMsg *pGtpMsg, const GtpMsgPatch *pPatch,
+      Buffer *pBuf)
+{
+   U8  buf[GTP_MSG_BUF_LEN];
+   U32 len = 0;
+
+   GtpMsgHdr msgHdr;
+   msgHdr.teid = pPatch->teid;
+   msgHdr.seqN = pPatch->seqN;
+   GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_TEID_PRES);
+   GSIM_SET_MASK(msgHdr.pres, GTP_MSG_HDR_SEQ_PRES);
+   pGtpMsg->setMsgHdr(&msgHdr);
+
+   if (NULL != pPatch->pImsi)
+   {
+      pGtpMsg->setImsi(pPatch->pImsi);
+   }
+
+   if (NULL != pPatch->pSenderIp)
+   {
+      pGtpMsg->setSenderFteid(pPatch->senderTeid, pPatch->pSenderIp);
+   }
+
+   U32 bearerCnt = pGtpMsg->getIeCount(GTP_IE_BEARER_CNTXT, 0);
+   for (U32 i = 1; i <= bearerCnt; i++)
+   {
+      GtpBearerContext *pBearerCntxt = gtpIeCast<GtpBearerContext>\
+            (pGtpMsg->getIe(GTP_IE_BEARER_CNTXT, 0, i));
+      U32 bearerIndx = GTP_BEARER_INDEX(pBearerCntxt->getEbi());
+      if (bearerIndx < GTP_MAX_BEARERS)
+      {
+         pBearerCntxt->setGtpuTeid(pPatch->bearerTeid[bearerIndx], 0);
+      }
+   }
+
+   MEMSET(buf, 0, GTP_MSG_BUF_LEN);
+   pGtpMsg->encode(buf, &len);
+   BUFFER_CPY(pBuf, buf, len);
+}
+
+static VOID expectSameEncoding(GtpMsg *pGtpMsg, GtpMsgTmpl *pTmpl,\
+      GtpMsgPatch *pPatch)
+{
+   Buffer tmplBuf;
+   Buffer msgBuf;
+
+   ASSERT_EQ(ROK, pTmpl->encode(pPatch, &tmplBuf));
+   encRefMsg(pGtpMsg, pPatch, &msgBuf);
+
+   ASSERT_EQ(msgBuf.len, tmplBuf.len);
+   EXPECT_EQ(0, memcmp(msgBuf.pVal, tmplBuf.pVal, msgBuf.len));
+}
+
+TEST(gtpMsgTmplTest, CreateSessionRequest)
+{
+   GtpMsg      *pGtpMsg = decodeMsg(s_csReq, sizeof(s_csReq));
+   GtpMsgTmpl  *pTmpl = GtpMsgTmpl::compile(pGtpMsg);
+   GtpMsgPatch patch;
+   GtpImsiKey  imsi;
+   IpAddr      ip;
+
+   ASSERT_TRUE(NULL != pTmpl);
+   EXPECT_EQ(sizeof(s_csReq), pTmpl->len());
+
+   initPatch(&patch, &imsi, &ip);
+   patch.pImsi = &imsi;
+   patch.pSenderIp = &ip;
+   for (U32 i = 0; i < 8; i++)
+   {
+      patch.teid = i * 0x01010101;
+      patch.seqN = i * 0x10203;
+      patch.senderTeid = 0x80000000 + i;
+      patch.bearerTeid[0] = 0xdead0000 + i;
+      imsi.val[3] = i;
+      ip.u.ipv4Addr.addr = 0x0a000000 + i;
+      expectSameEncoding(pGtpMsg, pTmpl, &patch);
+   }
+
+   delete pTmpl;
+   delete pGtpMsg;
+}
+
+TEST(gtpMsgTmplTest, DeleteSessionRequest)
+{
+   GtpMsg      *pGtpMsg = decodeMsg(s_dsReq, sizeof(s_dsReq));
+   GtpMsgTmpl  *pTmpl = GtpMsgTmpl::compile(pGtpMsg);
+   GtpMsgPatch patch;
+   GtpImsiKey  imsi;
+   IpAddr      ip;
+
+   ASSERT_TRUE(NULL != pTmpl);
+
+   initPatch(&patch, &imsi, &ip);
+   patch.teid = 0x12345678;
+   patch.seqN = 0xabcdef;
+   expectSameEncoding(pGtpMsg, pTmpl, &patch);
+
+   delete pTmpl;
+   delete pGtpMsg;
+}
+
+TEST(gtpMsgTmplTest, ImsiLength)
+{
+   GtpMsg      *pGtpMsg = decodeMsg(s_csReq, sizeof(s_csReq));
+   GtpMsgTmpl  *pTmpl = GtpMsgTmpl::compile(pGtpMsg);
+   GtpMsgPatch patch;
+   GtpImsiKey  imsi;
+   IpAddr      ip;
+
+   ASSERT_TRUE(NULL != pTmpl);
+
+   /* IMSIs shorter and of the same length as the scenario IMSI, the
+    * fields after the IMSI are moved
+    */
+   initPatch(&patch, &imsi, &ip);
+   patch.pImsi = &imsi;
+   patch.pSenderIp = &ip;
+   patch.senderTeid = 0x11223344;
+   patch.bearerTeid[0] = 0x55667788;
+   for (U32 len = 5; len <= GTP_IMSI_MAX_BUF_LEN; len++)
+   {
+      imsi.len = len;
+      expectSameEncoding(pGtpMsg, pTmpl, &patch);
+   }
+
+   /* the template is not modified by a longer or shorter IMSI */
+   Buffer buf;
+   imsi.len = 8;
+   ASSERT_EQ(ROK, pTmpl->encode(&patch, &buf));
+   EXPECT_EQ(sizeof(s_csReq), buf.len);
+
+   delete pTmpl;
+   delete pGtpMsg;
+}
+
+TEST(gtpMsgTmplTest, MissingFteid)
+{
+   GtpMsg      *pGtpMsg = decodeMsg(s_dsReq, sizeof(s_dsReq));
+   GtpMsgTmpl  *pTmpl = GtpMsgTmpl::compile(pGtpMsg);
+   GtpMsgPatch patch;
+   GtpImsiKey  imsi;
+   IpAddr      ip;
+   Buffer      buf;
+
+   ASSERT_TRUE(NULL != pTmpl);
+
+   /* sender F-TEID requested from a message without one */
+   Logger::m_logLevel = LOG_LVL_START;
+   initPatch(&patch, &imsi, &ip);
+   patch.pSenderIp = &ip;
+   EXPECT_EQ(ERR_IE_NOT_FOUND, pTmpl->encode(&patch, &buf));
+
+   delete pTmpl;
+   delete pGtpMsg;
+}
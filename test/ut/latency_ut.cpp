@@ -0,0 +1,89 @@
+#include <limits.h>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "latency.hpp"
+
+TEST(latencyHistTest, Bucket)
+{
+   /* every value is in a bucket whose highest value is within 1/16 of it,
+    * and the buckets are in the order of the values
+    */
+   U32 prevIndx = 0;
+   for (U64 val = 0; val < (1 << 20); val += (val >> 6) + 1)
+   {
+      U32 indx = LatencyHist::bucket(val);
+      U64 max  = LatencyHist::bucketMax(indx);
+
+      ASSERT_LT(indx, LAT_HIST_NUM_BUCKETS);
+      EXPECT_GE(indx, prevIndx);
+      EXPECT_GE(max, val);
+      EXPECT_LE(max - val, val / LAT_HIST_HALF_COUNT) << "value " << val;
+      EXPECT_EQ(indx, LatencyHist::bucket(max));
+      prevIndx = indx;
+   }
+
+   EXPECT_EQ(LAT_HIST_NUM_BUCKETS - 1,
+         LatencyHist::bucket(LAT_HIST_MAX_VAL));
+   EXPECT_EQ(LAT_HIST_MAX_VAL,
+         LatencyHist::bucketMax(LAT_HIST_NUM_BUCKETS - 1));
+}
+
+TEST(latencyHistTest, Percentile)
+{
+   LatencyHist hist;
+
+   hist.reset();
+   EXPECT_EQ(0, hist.percentile(50));
+
+   for (U64 val = 1; val <= 1000; val++)
+   {
+      hist.record(val);
+   }
+
+   EXPECT_EQ(1000, hist.count());
+   EXPECT_EQ(1000, hist.max());
+   EXPECT_EQ(1, hist.percentile(0));
+   EXPECT_NEAR(500, hist.percentile(50), 500 / LAT_HIST_HALF_COUNT);
+   EXPECT_NEAR(990, hist.percentile(99), 990 / LAT_HIST_HALF_COUNT);
+   EXPECT_EQ(1000, hist.percentile(100));
+
+   /* a single large value is the maximum, and is clamped */
+   LatencyHist other;
+   other.reset();
+   other.record(1ULL << 40);
+   hist.add(&other);
+   EXPECT_EQ(1001, hist.count());
+   EXPECT_EQ(LAT_HIST_MAX_VAL, hist.max());
+   EXPECT_EQ(LAT_HIST_MAX_VAL, hist.percentile(100));
+   EXPECT_NEAR(500, hist.percentile(50), 500 / LAT_HIST_HALF_COUNT);
+}
+
+TEST(latencyHistTest, Interval)
+{
+   LatencyHist last;
+   LatencyHist curr;
+
+   last.reset();
+   for (U64 val = 1; val <= 100; val++)
+   {
+      last.record(val * 100);
+   }
+
+   /* values recorded after the copy, the interval has only those */
+   curr = last;
+   for (U32 i = 0; i < 10; i++)
+   {
+      curr.record(50);
+   }
+
+   curr.sub(&last);
+   EXPECT_EQ(10, curr.count());
+   EXPECT_EQ(LatencyHist::bucketMax(LatencyHist::bucket(50)), curr.max());
+   EXPECT_EQ(curr.max(), curr.percentile(50));
+
+   curr.sub(&curr);
+   EXPECT_EQ(0, curr.count());
+   EXPECT_EQ(0, curr.max());
+}
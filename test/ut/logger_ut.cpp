@@ -0,0 +1,76 @@
+#include <limits.h>
+#include <list>
+#include <iostream>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+
+/* message of a log line, after the time, level, file and line */
+static std::string getLogMsg(const LogRecord *pRec)
+{
+   S8  line[LOG_BUF_MAX + 1];
+   U32 len = Logger::fmtRecord(pRec, line, sizeof(line));
+
+   std::string str(line, len);
+   EXPECT_EQ('\n', str[len - 1]);
+   size_t pos = str.find("ut.cpp:123:");
+   EXPECT_NE(std::string::npos, pos);
+   return str.substr(pos + STRLEN("ut.cpp:123:"), len - 1 - pos -
+         STRLEN("ut.cpp:123:"));
+}
+
+#define EXPECT_LOG_FMT(_fmt, ...)\
+do\
+{\
+   LogRecord rec;\
+   S8        exp[LOG_BUF_MAX];\
+   Logger::fillRecord(&rec, LOG_LVL_ERROR, "ut.cpp", 123, _fmt, __VA_ARGS__);\
+   snprintf(exp, sizeof(exp), _fmt, __VA_ARGS__);\
+   EXPECT_EQ(std::string(exp), getLogMsg(&rec));\
+} while (0)
+
+TEST(loggerTest, Format)
+{
+   S8        name[] = "Create Session Request";
+   const U8 *pUStr  = (const U8 *)"INFO";
+   U64       big    = 0x123456789abULL;
+
+   EXPECT_LOG_FMT("Message [%s], Error [%d]", name, -5);
+   EXPECT_LOG_FMT("TEID [%x] [%u] [%9d] [%-7lu|", 0xdeadbeef, 4000000000U,
+         42, big);
+   EXPECT_LOG_FMT("%.2f msgs/call %g 100%%", 12.3456, 0.5);
+   EXPECT_LOG_FMT("[%-9s] [%c] [%ld]", "pool", 'x', -1234567890123L);
+   EXPECT_LOG_FMT("%s %s", pUStr, "");
+   EXPECT_LOG_FMT("[%*d] [%.*s]", 6, 17, 3, "abcdef");
+   EXPECT_LOG_FMT("%p", (VOID *)&big);
+}
+
+TEST(loggerTest, Mismatch)
+{
+   LogRecord rec;
+
+   /* missing arguments and arguments of another kind are not read */
+   Logger::fillRecord(&rec, LOG_LVL_ERROR, "ut.cpp", 123, "[%s] [%d]", 5);
+   EXPECT_EQ("[(?)] [(?)]", getLogMsg(&rec));
+
+   Logger::fillRecord(&rec, LOG_LVL_ERROR, "ut.cpp", 123, "no args");
+   EXPECT_EQ("no args", getLogMsg(&rec));
+}
+
+TEST(loggerTest, Truncated)
+{
+   LogRecord   rec;
+   std::string longStr(1000, 'a');
+
+   /* a string is cut short to the record, arguments after it are lost */
+   Logger::fillRecord(&rec, LOG_LVL_ERROR, "ut.cpp", 123, "%s %s %d",
+         longStr.c_str(), longStr.c_str(), 7);
+   std::string msg = getLogMsg(&rec);
+   EXPECT_EQ(0, msg.find(std::string(LOG_REC_ARGS_LEN - 2, 'a') + " "));
+   EXPECT_NE(std::string::npos, msg.find("(?)"));
+   EXPECT_EQ(msg.size() - 3, msg.rfind("..."));
+}
@@ -0,0 +1,168 @@
+#include <limits.h>
+#include <list>
+#include <iostream>
+#include <vector>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "logger.hpp"
+#include "macros.hpp"
+#include "pcap.hpp"
+
+#define PCAP_UT_FILE          "pcap_ut.pcap"
+#define PCAP_UT_FILE_HDR_LEN  24
+#define PCAP_UT_REC_HDR_LEN   16
+
+static std::vector<U8> readFile(const S8 *pFileName)
+{
+   std::vector<U8> data;
+   FILE *pFile = fopen(pFileName, "rb");
+   if (NULL != pFile)
+   {
+      U8  buf[4096];
+      U32 len = 0;
+      while ((len = fread(buf, 1, sizeof(buf), pFile)) > 0)
+      {
+         data.insert(data.end(), buf, buf + len);
+      }
+
+      fclose(pFile);
+   }
+
+   return data;
+}
+
+static U32 getU16(const U8 *p)
+{
+   return ((U32)p[0] << 8) | p[1];
+}
+
+static U32 getU32(const U8 *p)
+{
+   return ((U32)p[0] << 24) | ((U32)p[1] << 16) | ((U32)p[2] << 8) | p[3];
+}
+
+static VOID initEp(IPEndPoint *pEp, U32 addr, U16 port)
+{
+   MEMSET(pEp, 0, sizeof(IPEndPoint));
+   pEp->ipAddr.ipAddrType = IP_ADDR_TYPE_V4;
+   pEp->ipAddr.u.ipv4Addr.addr = addr;
+   pEp->port = port;
+}
+
+TEST(pcapTest, Ipv4)
+{
+   IPEndPoint src;
+   IPEndPoint dst;
+   U8         msg[] = {0x48, 0x20, 0x00, 0x04, 0x01, 0x02, 0x03, 0x04};
+
+   initEp(&src, 0x7f000001, 2123);
+   initEp(&dst, 0x0a000002, 2124);
+   ASSERT_EQ(ROK, Pcap::open(PCAP_UT_FILE, 0));
+   Pcap::capture(&src, &dst, msg, sizeof(msg));
+   Pcap::close();
+
+   std::vector<U8> data = readFile(PCAP_UT_FILE);
+   ASSERT_EQ(PCAP_UT_FILE_HDR_LEN + PCAP_UT_REC_HDR_LEN + 28 + sizeof(msg),
+         data.size());
+
+   const U8 *pRec = &data[PCAP_UT_FILE_HDR_LEN];
+   U32 capLen = 0;
+   MEMCPY(&capLen, pRec + 8, sizeof(U32));
+   EXPECT_EQ(28 + sizeof(msg), capLen);
+
+   /* IPv4 header with a valid checksum, followed by the UDP header */
+   const U8 *pIp = pRec + PCAP_UT_REC_HDR_LEN;
+   U32 sum = 0;
+   for (U32 i = 0; i < 20; i += 2)
+   {
+      sum += getU16(pIp + i);
+   }
+
+   sum = (sum & 0xffff) + (sum >> 16);
+   EXPECT_EQ(0xffffU, sum);
+   EXPECT_EQ(0x45, pIp[0]);
+   EXPECT_EQ(28 + sizeof(msg), getU16(pIp + 2));
+   EXPECT_EQ(17, pIp[9]);
+   EXPECT_EQ(0x7f000001U, getU32(pIp + 12));
+   EXPECT_EQ(0x0a000002U, getU32(pIp + 16));
+
+   const U8 *pUdp = pIp + 20;
+   EXPECT_EQ(2123U, getU16(pUdp));
+   EXPECT_EQ(2124U, getU16(pUdp + 2));
+   EXPECT_EQ(8 + sizeof(msg), getU16(pUdp + 4));
+   EXPECT_EQ(0, memcmp(msg, pUdp + 8, sizeof(msg)));
+
+   remove(PCAP_UT_FILE);
+}
+
+TEST(pcapTest, Rotate)
+{
+   IPEndPoint src;
+   IPEndPoint dst;
+   U8         msg[1000];
+
+   MEMSET(msg, 0, sizeof(msg));
+   initEp(&src, 0x7f000001, 2123);
+   initEp(&dst, 0x7f000001, 2124);
+
+   /* records of the thread buffer are written in 1 MB writes, every write
+    * after the first one starts a new file
+    */
+   ASSERT_EQ(ROK, Pcap::open(PCAP_UT_FILE, 1));
+   for (U32 i = 0; i < 3000; i++)
+   {
+      Pcap::capture(&src, &dst, msg, sizeof(msg));
+   }
+
+   Pcap::close();
+
+   std::vector<U8> rotated = readFile(PCAP_UT_FILE ".1");
+   std::vector<U8> last    = readFile(PCAP_UT_FILE);
+   ASSERT_GT(rotated.size(), (size_t)PCAP_UT_FILE_HDR_LEN);
+   ASSERT_GT(last.size(), (size_t)PCAP_UT_FILE_HDR_LEN);
+   EXPECT_EQ(0, memcmp(&rotated[0], &last[0], PCAP_UT_FILE_HDR_LEN));
+   EXPECT_LE(rotated.size(), (size_t)(1 << 20));
+
+   remove(PCAP_UT_FILE);
+   remove(PCAP_UT_FILE ".1");
+   remove(PCAP_UT_FILE ".2");
+}
+
+TEST(pcapTest, FlushIfDue)
+{
+   IPEndPoint src;
+   IPEndPoint dst;
+   U8         msg[] = {0x48, 0x20, 0x00, 0x04, 0x01, 0x02, 0x03, 0x04};
+
+   initEp(&src, 0x7f000001, 2123);
+   initEp(&dst, 0x7f000001, 2124);
+   ASSERT_EQ(ROK, Pcap::open(PCAP_UT_FILE, 0));
+
+   /* the record is buffered till a second after it is captured */
+   time_t start = time(NULL);
+   Pcap::capture(&src, &dst, msg, sizeof(msg));
+   Pcap::flushIfDue();
+   if (time(NULL) == start)
+   {
+      EXPECT_EQ((size_t)PCAP_UT_FILE_HDR_LEN, readFile(PCAP_UT_FILE).size());
+   }
+
+   while (time(NULL) - start < 1)
+   {
+      usleep(10000);
+   }
+
+   /* written by an idle thread, without a new capture */
+   Pcap::flushIfDue();
+   EXPECT_EQ(PCAP_UT_FILE_HDR_LEN + PCAP_UT_REC_HDR_LEN + 28 + sizeof(msg),
+         readFile(PCAP_UT_FILE).size());
+
+   Pcap::close();
+   remove(PCAP_UT_FILE);
+}
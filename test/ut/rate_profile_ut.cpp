@@ -0,0 +1,99 @@
+#include <limits.h>
+#include <sstream>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "error.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "rate_profile.hpp"
+
+static RateProfile *parseProfile(const S8 *pText)
+{
+   std::istringstream in(pText);
+   return RateProfile::parse(in);
+}
+
+TEST(rateProfileTest, RampAndHold)
+{
+   RateProfile *pProfile = parseProfile(
+         "# ramp to 50k sessions/s in 10 minutes and hold for an hour\n"
+         "ramp 100 50000 10m\n"
+         "\n"
+         "hold 50000 1h   # plateau\n");
+
+   EXPECT_EQ(2, pProfile->numSegments());
+   EXPECT_EQ((10 * 60 + 60 * 60) * 1000, pProfile->duration());
+   EXPECT_DOUBLE_EQ(100, pProfile->rate(0));
+   EXPECT_DOUBLE_EQ(25050, pProfile->rate(5 * 60 * 1000));
+   EXPECT_DOUBLE_EQ(50000, pProfile->rate(10 * 60 * 1000));
+   EXPECT_DOUBLE_EQ(50000, pProfile->rate(pProfile->duration() - 1));
+
+   /* no traffic after the end of the profile */
+   EXPECT_DOUBLE_EQ(0, pProfile->rate(pProfile->duration()));
+
+   delete pProfile;
+}
+
+TEST(rateProfileTest, Step)
+{
+   RateProfile *pProfile = parseProfile(
+         "step 1000 10% 5m 20m\n"
+         "step 1000 -250 500ms 10\n");
+
+   EXPECT_DOUBLE_EQ(1000, pProfile->rate(5 * 60 * 1000 - 1));
+   EXPECT_DOUBLE_EQ(1100, pProfile->rate(5 * 60 * 1000));
+   EXPECT_DOUBLE_EQ(1331, pProfile->rate(15 * 60 * 1000));
+
+   /* absolute steps down, the rate does not go below 0 */
+   Time_t start = 20 * 60 * 1000;
+   EXPECT_DOUBLE_EQ(1000, pProfile->rate(start));
+   EXPECT_DOUBLE_EQ(750, pProfile->rate(start + 500));
+   EXPECT_DOUBLE_EQ(0, pProfile->rate(start + 2000));
+   EXPECT_DOUBLE_EQ(0, pProfile->rate(start + 9999));
+
+   delete pProfile;
+}
+
+TEST(rateProfileTest, Sine)
+{
+   RateProfile *pProfile = parseProfile("sine 1000 1500 24h 48h\n");
+   Time_t      day = 24 * 60 * 60 * 1000;
+
+   EXPECT_DOUBLE_EQ(1000, pProfile->rate(0));
+   EXPECT_DOUBLE_EQ(2500, pProfile->rate(day / 4));
+   EXPECT_NEAR(1000, pProfile->rate(day / 2), 1e-6);
+   EXPECT_DOUBLE_EQ(0, pProfile->rate(3 * day / 4));
+   EXPECT_DOUBLE_EQ(2500, pProfile->rate(day + day / 4));
+
+   delete pProfile;
+}
+
+TEST(rateProfileTest, Invalid)
+{
+   Logger::m_logLevel = LOG_LVL_START;
+
+   EXPECT_THROW(parseProfile(""), GsimError);
+   EXPECT_THROW(parseProfile("# comment only\n"), GsimError);
+   EXPECT_THROW(parseProfile("burst 100 10s\n"), GsimError);
+   EXPECT_THROW(parseProfile("ramp 100 10s\n"), GsimError);
+   EXPECT_THROW(parseProfile("hold 100 10d\n"), GsimError);
+   EXPECT_THROW(parseProfile("hold 100 0\n"), GsimError);
+   EXPECT_THROW(parseProfile("hold -1 10\n"), GsimError);
+   EXPECT_THROW(parseProfile("hold 2000000 10\n"), GsimError);
+   EXPECT_THROW(parseProfile("step 100 -100% 1s 10s\n"), GsimError);
+   EXPECT_THROW(parseProfile("step 100 % 1s 10s\n"), GsimError);
+   EXPECT_THROW(parseProfile("step 100 x% 1s 10s\n"), GsimError);
+
+   /* the line of the malformed segment is reported */
+   try
+   {
+      parseProfile("hold 100 10\n\nramp 100 x 10\n");
+      FAIL();
+   }
+   catch (GsimError &e)
+   {
+      EXPECT_THAT(e.what(), testing::HasSubstr("line 3"));
+   }
+}
@@ -0,0 +1,176 @@
+#include <limits.h>
+#include <unistd.h>
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "macros.hpp"
+#include "logger.hpp"
+#include "timer.hpp"
+#include "task.hpp"
+
+#define TIMER_UT_TICK   100   /* micro-seconds */
+
+/* task paused till a wake up time in micro-seconds */
+class UtTask: public Task
+{
+   public:
+      UtTask(Time_t wakeUs)
+      {
+         m_wakeUs = wakeUs;
+         pause();
+      }
+
+      /* pauses the running task again */
+      VOID wait(Time_t wakeUs)
+      {
+         m_wakeUs = wakeUs;
+         pause();
+      }
+
+      RETVAL run(VOID * = NULL) {return ROK;}
+      Time_t wake() {return m_wakeUs / 1000;}
+      Time_t wakeUs() {return m_wakeUs;}
+
+   private:
+      Time_t m_wakeUs;
+};
+
+/* first tick boundary at or after a time */
+static Time_t tickCeil(Time_t usec)
+{
+   return ((usec + TIMER_UT_TICK - 1) / TIMER_UT_TICK) * TIMER_UT_TICK;
+}
+
+/* catches up the time wheel with the clock, away from the end of a turn of
+ * wheel one so that the tasks of a test stay in wheel one
+ */
+static Time_t startTimerUt()
+{
+   setTimerTick(TIMER_UT_TICK);
+
+   Time_t tick = getSchedMicroSeconds() / TIMER_UT_TICK;
+   while (((tick % TW_ONE_SLOTS) == 0) ||
+          ((tick % TW_ONE_SLOTS) > TW_ONE_SLOTS - 100))
+   {
+      usleep(TIMER_UT_TICK);
+      tick = getSchedMicroSeconds() / TIMER_UT_TICK;
+   }
+
+   TaskMgr::resumePausedTasks();
+   return getSchedMicroSeconds();
+}
+
+TEST(timeWheelTest, NextWakeTime)
+{
+   Time_t now   = startTimerUt();
+   Time_t limit = now + GSIM_SCHED_MAX_WAIT;
+
+   EXPECT_EQ(limit, TaskMgr::getNextWakeTime(limit));
+
+   UtTask *pFirst  = new UtTask(now + 3000);
+   UtTask *pSecond = new UtTask(now + 5050);
+   EXPECT_TRUE(TaskMgr::getRunningTasks()->empty());
+   EXPECT_EQ(tickCeil(now + 3000), TaskMgr::getNextWakeTime(limit));
+   EXPECT_EQ(now + 1000, TaskMgr::getNextWakeTime(now + 1000));
+
+   /* the slot of a stopped task is skipped */
+   pFirst->abort();
+   EXPECT_EQ(tickCeil(now + 5050), TaskMgr::getNextWakeTime(limit));
+
+   pSecond->abort();
+   EXPECT_EQ(limit, TaskMgr::getNextWakeTime(limit));
+}
+
+TEST(timeWheelTest, Resume)
+{
+   Time_t now  = startTimerUt();
+   Time_t wake = now + 2 * TIMER_UT_TICK + TIMER_UT_TICK / 2;
+   U32    lags = getTimerStats()->lag.count();
+
+   UtTask *pTask = new UtTask(wake);
+
+   /* a task is not resumed before its wake up time */
+   while (getSchedMicroSeconds() < wake)
+   {
+      TaskMgr::resumePausedTasks();
+      if (getSchedMicroSeconds() < wake)
+      {
+         ASSERT_TRUE(TaskMgr::getRunningTasks()->empty());
+      }
+   }
+
+   while (TaskMgr::getRunningTasks()->empty())
+   {
+      getSchedMicroSeconds();
+      TaskMgr::resumePausedTasks();
+   }
+
+   EXPECT_EQ(pTask, TaskMgr::getRunningTasks()->begin()->pTask);
+   EXPECT_EQ(lags + 1, getTimerStats()->lag.count());
+   EXPECT_EQ(tickCeil(wake), TaskMgr::getNextWakeTime(tickCeil(wake)));
+
+   pTask->abort();
+}
+
+TEST(timeWheelTest, OuterWheel)
+{
+   Time_t now   = startTimerUt();
+   Time_t wake  = now + (TW_ONE_SLOTS + 10) * TIMER_UT_TICK;
+   Time_t limit = wake + GSIM_SCHED_MAX_WAIT;
+
+   /* a task beyond the turn of wheel one is due after wheel one turns
+    * over, on the second tick of the next turn
+    */
+   UtTask *pTask = new UtTask(wake);
+   Time_t  next  = TaskMgr::getNextWakeTime(limit);
+   EXPECT_GT(next, now);
+   EXPECT_LE(next, wake);
+   EXPECT_EQ(1, (next / TIMER_UT_TICK) % TW_ONE_SLOTS);
+
+   pTask->abort();
+}
+
+TEST(timeWheelTest, ThirdWheelWrap)
+{
+   Time_t now  = startTimerUt();
+   Time_t turn = (Time_t)TW_ONE_SLOTS * TW_TWO_SLOTS * TW_THREE_SLOTS;
+
+   /* a task beyond a turn of wheel three is paused in the wheel */
+   UtTask *pTask = new UtTask(now + (turn + 10) * TIMER_UT_TICK);
+   Time_t  limit = now + 2 * TW_ONE_SLOTS * TIMER_UT_TICK;
+   EXPECT_TRUE(TaskMgr::getRunningTasks()->empty());
+   EXPECT_GT(limit, TaskMgr::getNextWakeTime(limit));
+
+   TaskMgr::resumePausedTasks();
+   EXPECT_TRUE(TaskMgr::getRunningTasks()->empty());
+
+   pTask->abort();
+   EXPECT_EQ(limit, TaskMgr::getNextWakeTime(limit));
+}
+
+TEST(timeWheelTest, DueTask)
+{
+   Time_t now = startTimerUt();
+
+   /* a task pausing till a time already passed stays paused till the
+    * next tick
+    */
+   UtTask *pTask = new UtTask(now - TIMER_UT_TICK);
+   EXPECT_TRUE(TaskMgr::getRunningTasks()->empty());
+   EXPECT_GE(tickCeil(now + 1), TaskMgr::getNextWakeTime(now + 10000));
+
+   while (TaskMgr::getRunningTasks()->empty())
+   {
+      getSchedMicroSeconds();
+      TaskMgr::resumePausedTasks();
+   }
+
+   EXPECT_EQ(pTask, TaskMgr::getRunningTasks()->begin()->pTask);
+
+   /* a zero wait of the running task */
+   pTask->wait(getSchedMicroSeconds());
+   EXPECT_TRUE(TaskMgr::getRunningTasks()->empty());
+
+   pTask->abort();
+}